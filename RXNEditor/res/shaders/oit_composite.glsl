@@ -0,0 +1,33 @@
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec2 a_Position;
+
+void main()
+{
+    gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+#type fragment
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+layout(binding = 0) uniform sampler2D u_Accumulation;
+// Summed -log(1 - alpha) of every transparent fragment
+layout(binding = 1) uniform sampler2D u_Revealage;
+
+void main()
+{
+    ivec2 coord = ivec2(gl_FragCoord.xy);
+
+    float revealage = exp(-texelFetch(u_Revealage, coord, 0).r);
+    if (revealage >= 0.999)
+        discard;
+
+    vec4 accumulation = texelFetch(u_Accumulation, coord, 0);
+    vec3 average = accumulation.rgb / max(accumulation.a, 1e-5);
+
+    // Blended over the opaque scene with SrcAlpha, OneMinusSrcAlpha
+    o_Color = vec4(average, 1.0 - revealage);
+}
\ No newline at end of file
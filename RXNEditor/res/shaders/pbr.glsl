@@ -17,6 +17,9 @@ out vec2 v_TexCoord;
 out vec3 v_WorldPos;
 out vec3 v_Normal;
 
+// The depth pre-pass computes the same position, invariance keeps both passes' depth identical
+invariant gl_Position;
+
 void main()
 {
     mat4 model = mat4(a_ModelRow0, a_ModelRow1, a_ModelRow2, a_ModelRow3);
@@ -36,6 +39,8 @@ void main()
 #version 450 core
 
 layout(location = 0) out vec4 o_Color;
+// Only written by the weighted blended transparency pass, see oit_composite.glsl
+layout(location = 1) out vec4 o_Revealage;
 
 in vec2 v_TexCoord;
 in vec3 v_WorldPos;
@@ -69,6 +74,7 @@ layout (std140, binding = 2) uniform ShadowData
     vec4 u_CascadePlaneDistances[4];
 };
 uniform mat4 u_View;
+uniform int u_WeightedOIT;
 
 // IBL
 layout(binding = 10) uniform samplerCube u_IrradianceMap;
@@ -136,7 +142,9 @@ vec3 FresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
 // Tangent Space Normal Calculation
 vec3 GetNormalFromMap()
 {
-    vec3 tangentNormal = texture(u_NormalMap, v_TexCoord).xyz * 2.0 - 1.0;
+    // Z is rebuilt from X/Y, cooked normal maps are BC5 and only store two channels
+    vec2 tangentXY = texture(u_NormalMap, v_TexCoord).xy * 2.0 - 1.0;
+    vec3 tangentNormal = vec3(tangentXY, sqrt(max(1.0 - dot(tangentXY, tangentXY), 0.0)));
 
     vec3 Q1 = dFdx(v_WorldPos);
     vec3 Q2 = dFdy(v_WorldPos);
@@ -303,5 +311,17 @@ void main()
     // COMBINE
     vec3 color = ambient + Lo + emissive;
 
+    if (u_WeightedOIT == 1)
+    {
+        // McGuire and Bavoil's depth weight, closer surfaces dominate the average
+        float viewDepth = abs((u_View * vec4(v_WorldPos, 1.0)).z);
+        float weight = clamp(alpha * max(1e-2, min(3e3, 10.0 / (1e-5 + pow(viewDepth / 5.0, 2.0) + pow(viewDepth / 200.0, 6.0)))), 1e-2, 3e3);
+
+        o_Color = vec4(color * alpha, alpha) * weight;
+        // -log(1 - a) sums under additive blending to -log of the product of (1 - a), so both targets share one blend state
+        o_Revealage = vec4(-log(1.0 - min(alpha, 0.999)));
+        return;
+    }
+
     o_Color = vec4(color, alpha);
 }
\ No newline at end of file
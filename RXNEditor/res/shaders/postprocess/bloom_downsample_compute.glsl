@@ -0,0 +1,159 @@
+#type compute
+#version 450 core
+
+// Builds the whole bloom chain in one dispatch. Each group owns a 32x32 tile of the first mip and reduces it in
+// shared memory down to a single texel, which covers the first 6 mips. The group that finishes last, found with an
+// atomic counter, reduces the remaining mips on its own
+layout(local_size_x = 16, local_size_y = 16) in;
+
+const int MAX_MIPS = 8;
+const int TILE_MIPS = 6;
+
+layout(binding = 0) uniform sampler2D u_Source;
+layout(binding = 0, rgba16f) uniform coherent image2D u_Mips[MAX_MIPS];
+
+layout(std430, binding = 0) coherent buffer GroupCounter
+{
+    uint u_FinishedGroups;
+};
+
+uniform int u_MipCount;
+uniform int u_GroupCount;
+uniform vec4 u_Threshold; // x = threshold, y = threshold - knee, z = 2.0 * knee, w = 0.25 / knee
+
+shared vec3 s_Tile[32][32];
+shared bool s_LastGroup;
+
+vec3 Sample(vec2 uv)
+{
+    return textureLod(u_Source, uv, 0.0).rgb;
+}
+
+// Same 13 taps and soft knee threshold as the raster first mip
+vec3 DownsampleSource(vec2 uv, vec2 texelSize)
+{
+    float x = texelSize.x;
+    float y = texelSize.y;
+
+    vec3 a = Sample(vec2(uv.x - 2.0*x, uv.y + 2.0*y));
+    vec3 b = Sample(vec2(uv.x,         uv.y + 2.0*y));
+    vec3 c = Sample(vec2(uv.x + 2.0*x, uv.y + 2.0*y));
+
+    vec3 d = Sample(vec2(uv.x - 2.0*x, uv.y));
+    vec3 e = Sample(vec2(uv.x,         uv.y));
+    vec3 f = Sample(vec2(uv.x + 2.0*x, uv.y));
+
+    vec3 g = Sample(vec2(uv.x - 2.0*x, uv.y - 2.0*y));
+    vec3 h = Sample(vec2(uv.x,         uv.y - 2.0*y));
+    vec3 i = Sample(vec2(uv.x + 2.0*x, uv.y - 2.0*y));
+
+    vec3 j = Sample(vec2(uv.x - x, uv.y + y));
+    vec3 k = Sample(vec2(uv.x + x, uv.y + y));
+    vec3 l = Sample(vec2(uv.x - x, uv.y - y));
+    vec3 m = Sample(vec2(uv.x + x, uv.y - y));
+
+    vec3 color = e*0.125;
+    color += (a+c+g+i)*0.03125;
+    color += (b+d+f+h)*0.0625;
+    color += (j+k+l+m)*0.125;
+
+    float brightness = max(color.r, max(color.g, color.b));
+    float rq = clamp(brightness - u_Threshold.y, 0.0, u_Threshold.z);
+    rq = u_Threshold.w * rq * rq;
+    color *= max(rq, brightness - u_Threshold.x) / max(brightness, 0.00001);
+
+    return color;
+}
+
+void main()
+{
+    ivec2 thread = ivec2(gl_LocalInvocationID.xy);
+    ivec2 group = ivec2(gl_WorkGroupID.xy);
+
+    // First mip, 4 texels per thread straight from the scene colour
+    ivec2 firstMipSize = imageSize(u_Mips[0]);
+    vec2 texelSize = 1.0 / vec2(firstMipSize);
+
+    for (int quadrant = 0; quadrant < 4; quadrant++)
+    {
+        ivec2 local = thread + ivec2(quadrant & 1, quadrant >> 1) * 16;
+        ivec2 coord = group * 32 + local;
+
+        vec3 color = DownsampleSource((vec2(coord) + 0.5) * texelSize, texelSize);
+
+        if (all(lessThan(coord, firstMipSize)))
+            imageStore(u_Mips[0], coord, vec4(color, 1.0));
+
+        s_Tile[local.y][local.x] = color;
+    }
+
+    barrier();
+
+    // The rest of the tile, each level averages 2x2 texels of the one before it in shared memory
+    for (int level = 1; level < min(u_MipCount, TILE_MIPS); level++)
+    {
+        int tileSize = 32 >> level;
+        bool active = all(lessThan(thread, ivec2(tileSize)));
+
+        vec3 color = vec3(0.0);
+        if (active)
+        {
+            ivec2 source = thread * 2;
+            color = 0.25 * (s_Tile[source.y][source.x] + s_Tile[source.y][source.x + 1] +
+                            s_Tile[source.y + 1][source.x] + s_Tile[source.y + 1][source.x + 1]);
+
+            ivec2 coord = group * tileSize + thread;
+            if (all(lessThan(coord, imageSize(u_Mips[level]))))
+                imageStore(u_Mips[level], coord, vec4(color, 1.0));
+        }
+
+        barrier();
+
+        if (active)
+            s_Tile[thread.y][thread.x] = color;
+
+        barrier();
+    }
+
+    if (u_MipCount <= TILE_MIPS)
+        return;
+
+    // Only the last group to get here can be sure every tile of the last shared level has been written
+    memoryBarrier();
+    barrier();
+
+    if (gl_LocalInvocationIndex == 0)
+        s_LastGroup = atomicAdd(u_FinishedGroups, 1) == uint(u_GroupCount - 1);
+
+    barrier();
+
+    if (!s_LastGroup)
+        return;
+
+    // Ready for the next frame
+    if (gl_LocalInvocationIndex == 0)
+        u_FinishedGroups = 0;
+
+    for (int level = TILE_MIPS; level < u_MipCount; level++)
+    {
+        ivec2 sourceSize = imageSize(u_Mips[level - 1]);
+        ivec2 size = imageSize(u_Mips[level]);
+
+        for (int index = int(gl_LocalInvocationIndex); index < size.x * size.y; index += 256)
+        {
+            ivec2 coord = ivec2(index % size.x, index / size.x);
+            ivec2 source = coord * 2;
+            ivec2 sourceMax = sourceSize - 1;
+
+            vec3 color = 0.25 * (imageLoad(u_Mips[level - 1], min(source, sourceMax)).rgb +
+                                 imageLoad(u_Mips[level - 1], min(source + ivec2(1, 0), sourceMax)).rgb +
+                                 imageLoad(u_Mips[level - 1], min(source + ivec2(0, 1), sourceMax)).rgb +
+                                 imageLoad(u_Mips[level - 1], min(source + ivec2(1, 1), sourceMax)).rgb);
+
+            imageStore(u_Mips[level], coord, vec4(color, 1.0));
+        }
+
+        memoryBarrierImage();
+        barrier();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#type compute
+#version 450 core
+
+// Adds the tent filtered level u_SourceLevel onto the level above it, one dispatch per level
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(binding = 0) uniform sampler2D u_Bloom;
+layout(binding = 0, rgba16f) uniform image2D u_Target;
+
+uniform int u_SourceLevel;
+uniform float u_FilterRadius; // Default ~0.005
+
+vec3 Sample(vec2 uv)
+{
+    return textureLod(u_Bloom, uv, float(u_SourceLevel)).rgb;
+}
+
+void main()
+{
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(u_Target);
+
+    if (any(greaterThanEqual(coord, size)))
+        return;
+
+    vec2 uv = (vec2(coord) + 0.5) / vec2(size);
+    float x = u_FilterRadius;
+    float y = u_FilterRadius;
+
+    // 9-Tap Tent Filter
+    vec3 a = Sample(vec2(uv.x - x, uv.y + y));
+    vec3 b = Sample(vec2(uv.x,     uv.y + y));
+    vec3 c = Sample(vec2(uv.x + x, uv.y + y));
+
+    vec3 d = Sample(vec2(uv.x - x, uv.y));
+    vec3 e = Sample(vec2(uv.x,     uv.y));
+    vec3 f = Sample(vec2(uv.x + x, uv.y));
+
+    vec3 g = Sample(vec2(uv.x - x, uv.y - y));
+    vec3 h = Sample(vec2(uv.x,     uv.y - y));
+    vec3 i = Sample(vec2(uv.x + x, uv.y - y));
+
+    vec3 color = e*0.25;
+    color += (b+d+f+h)*0.125;
+    color += (a+c+g+i)*0.0625;
+
+    imageStore(u_Target, coord, vec4(imageLoad(u_Target, coord).rgb + color, 1.0));
+}
\ No newline at end of file
@@ -29,6 +29,46 @@ uniform float u_BloomIntensity; // Default 0.04
 uniform sampler2D u_OutlineTexture;
 uniform vec2 u_TexelSize;
 
+// 0 = bilinear, 1 = Catmull-Rom, used when the scene was rendered below the output resolution
+uniform int u_UpscaleFilter;
+uniform vec2 u_ScreenSize;
+
+// 9 bilinear taps instead of 16 point taps, the two middle weights of each axis share a fetch
+vec3 SampleCatmullRom(sampler2D tex, vec2 uv, vec2 texSize)
+{
+    vec2 samplePos = uv * texSize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 offset12 = w2 / w12;
+
+    vec2 texPos0 = (texPos1 - 1.0) / texSize;
+    vec2 texPos3 = (texPos1 + 2.0) / texSize;
+    vec2 texPos12 = (texPos1 + offset12) / texSize;
+
+    vec3 result = vec3(0.0);
+    result += texture(tex, vec2(texPos0.x, texPos0.y)).rgb * w0.x * w0.y;
+    result += texture(tex, vec2(texPos12.x, texPos0.y)).rgb * w12.x * w0.y;
+    result += texture(tex, vec2(texPos3.x, texPos0.y)).rgb * w3.x * w0.y;
+
+    result += texture(tex, vec2(texPos0.x, texPos12.y)).rgb * w0.x * w12.y;
+    result += texture(tex, vec2(texPos12.x, texPos12.y)).rgb * w12.x * w12.y;
+    result += texture(tex, vec2(texPos3.x, texPos12.y)).rgb * w3.x * w12.y;
+
+    result += texture(tex, vec2(texPos0.x, texPos3.y)).rgb * w0.x * w3.y;
+    result += texture(tex, vec2(texPos12.x, texPos3.y)).rgb * w12.x * w3.y;
+    result += texture(tex, vec2(texPos3.x, texPos3.y)).rgb * w3.x * w3.y;
+
+    // The negative lobes ring around bright edges
+    return max(result, vec3(0.0));
+}
+
 vec3 ACESFilm(vec3 x)
 {
     float a = 2.51;
@@ -41,7 +81,7 @@ vec3 ACESFilm(vec3 x)
 
 void main()
 {
-    vec3 hdrColor = texture(u_ScreenTexture, v_TexCoord).rgb;
+    vec3 hdrColor = u_UpscaleFilter == 1 ? SampleCatmullRom(u_ScreenTexture, v_TexCoord, u_ScreenSize) : texture(u_ScreenTexture, v_TexCoord).rgb;
     vec3 bloomColor = texture(u_BloomTexture, v_TexCoord).rgb;
 
     hdrColor += bloomColor * u_BloomIntensity;
@@ -1,15 +1,21 @@
 #include "rxnpch.h"
 #include "EditorLayer.h"
 #include "RXNEngine/Asset/ModelImporter.h"
+#include "RXNEngine/Core/JobSystem.h"
 #include "RXNEngine/Scripting/ScriptEngine.h"
+#include "RXNEngine/Serialization/ModelSerializer.h"
 
 #include <imgui.h>
 #include <ImGuizmo.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <chrono>
+
 namespace RXNEditor {
 
+	extern const std::filesystem::path g_AssetPath;
+
 	EditorLayer::EditorLayer(const std::string& name)
 		: Layer(name)
 	{
@@ -67,12 +73,24 @@ namespace RXNEditor {
             }
             case SceneState::Play:
             {
+                // Between frames, so the running scripts are migrated with nothing of theirs on the stack
+                ScriptEngine::ReloadIfModified(deltaTime);
                 m_ActiveScene->OnUpdateRuntime(deltaTime);
                 m_SceneRenderer->RenderRuntime();
                 break;
             }
         }
 
+        if (m_PickingPending)
+        {
+            int pickedID;
+            if (m_SceneRenderer->PollEntityIDAtMouse(pickedID))
+            {
+                SelectPickedEntity(pickedID);
+                m_PickingPending = false;
+            }
+        }
+
         m_FPS = 1.0f / deltaTime;
 	}
 
@@ -107,20 +125,21 @@ namespace RXNEditor {
                         glm::vec2 viewportSize = m_ViewportBounds[1] - m_ViewportBounds[0];
                         if (mx >= 0 && my >= 0 && mx < viewportSize.x && my < viewportSize.y)
                         {
-                            my = viewportSize.y - my;
-
-                            int pickedID = m_SceneRenderer->GetEntityIDAtMouse((int)mx, (int)my, *m_EditorCamera);
+                            int pixelX = (int)mx;
+                            int pixelY = (int)(viewportSize.y - my);
 
-                            if (pickedID > -1)
+                            switch (m_SceneRenderer->GetSettings().Picking)
                             {
-                                Entity pickedEntity = { (entt::entity)pickedID, m_ActiveScene.get() };
-                                pickedEntity = m_SceneHierarchyPanel.ResolvePickedEntity(pickedEntity);
-
-                                m_SceneHierarchyPanel.SetSelectedEntity(pickedEntity);
-                            }
-                            else
-                            {
-                                m_SceneHierarchyPanel.SetSelectedEntity({});
+                                case SceneRenderer::PickingMode::CPU:
+                                    SelectPickedEntity(m_SceneRenderer->GetEntityIDAtRay(CastRayFromMouse(mx, my)));
+                                    break;
+                                case SceneRenderer::PickingMode::GPUAsync:
+                                    m_SceneRenderer->RequestEntityIDAtMouse(pixelX, pixelY, *m_EditorCamera);
+                                    m_PickingPending = true;
+                                    break;
+                                case SceneRenderer::PickingMode::GPU:
+                                    SelectPickedEntity(m_SceneRenderer->GetEntityIDAtMouse(pixelX, pixelY, *m_EditorCamera));
+                                    break;
                             }
                         }
                     }
@@ -205,7 +224,7 @@ namespace RXNEditor {
 
                 if (ImGui::MenuItem("Save As...", NULL, false, p_open != NULL))
                 {
-                    std::string path = FileDialogs::SaveFile("Scene (*.rxns)\0*.rxns\0");
+                    std::string path = FileDialogs::SaveFile("Scene (*.rxns)\0*.rxns\0Binary Scene (*.rxsb)\0*.rxsb\0");
 
                     SaveSceneAs(path);
                 }
@@ -213,10 +232,30 @@ namespace RXNEditor {
 
                 if (ImGui::MenuItem("Open", NULL, false, p_open != NULL))
                 {
-                    std::string path = FileDialogs::OpenFile("Scene (*.rxns)\0*.rxns\0");
+                    std::string path = FileDialogs::OpenFile("Scene (*.rxns;*.rxsb)\0*.rxns;*.rxsb\0");
 
                     OpenScene(path);
                 }
+                ImGui::Separator();
+
+                if (ImGui::MenuItem("Convert Scene...", NULL, false, p_open != NULL))
+                {
+                    std::string path = FileDialogs::OpenFile("Scene (*.rxns;*.rxsb)\0*.rxns;*.rxsb\0");
+
+                    ConvertScene(path);
+                }
+
+                if (ImGui::MenuItem("Benchmark Scene Load", NULL, false, p_open != NULL))
+                    BenchmarkSceneLoad();
+
+                if (ImGui::MenuItem("Benchmark Script Update", NULL, false, p_open != NULL && m_SceneState == SceneState::Edit))
+                    BenchmarkScriptUpdate();
+
+                if (ImGui::MenuItem("Upgrade Mesh Caches", NULL, false, p_open != NULL))
+                {
+                    uint32_t upgraded = ModelSerializer::UpgradeDirectory(g_AssetPath);
+                    RXN_CORE_INFO("Upgraded {0} model caches under '{1}'", upgraded, g_AssetPath.string());
+                }
 
                 ImGui::EndMenu();
             }
@@ -322,7 +361,7 @@ namespace RXNEditor {
                     Ref<Cubemap> skybox = Cubemap::Create(path);
                     m_ActiveScene->SetSkybox(skybox);
                 }
-                else if(path.contains(".rxns"))
+                else if(path.contains(".rxns") || path.contains(".rxsb"))
                 {
                     OpenScene(std::filesystem::path(path).string());
                 }
@@ -348,8 +387,139 @@ namespace RXNEditor {
 
         ImGui::Text("Total Triangles: %d", stats.TotalIndices / 3);
 
+        ImGui::Text("Depth Pre-Pass: %s (%d draw calls)", stats.DepthPrePass ? "On" : "Off", stats.PrePassDrawCalls);
+        ImGui::Text("Transparent Draw Calls: %d", stats.TransparentDrawCalls);
+        ImGui::Text("Estimated Depth Complexity: %.2f", stats.EstimatedDepthComplexity);
+        ImGui::Text("Opaque Overdraw: %.2f shaded fragments/pixel", stats.OpaqueOverdraw);
+
+        auto poolStats = m_SceneRenderer->GetRenderTargetPoolStats();
+        ImGui::Text("Render Targets: %d (%d in use)", poolStats.TargetCount, poolStats.TargetsInUse);
+        ImGui::Text("Render Target Memory: %.2f MB", poolStats.MemoryBytes / (1024.0f * 1024.0f));
+
+        auto textureStats = AssetManager::GetTextureLoadStats();
+        ImGui::Text("Textures Decoding: %d", textureStats.PendingDecodes);
+        ImGui::Text("Textures Uploading: %d (%.2f MB)", textureStats.PendingUploads, textureStats.PendingUploadBytes / (1024.0f * 1024.0f));
+
+        auto streamingStats = TextureStreamer::GetStats();
+        ImGui::Text("Streamed Textures: %d (%d requests pending)", streamingStats.StreamedTextures, streamingStats.PendingRequests);
+        ImGui::Text("Texture Memory: %.2f / %.2f MB", streamingStats.ResidentBytes / (1024.0f * 1024.0f), streamingStats.BudgetBytes / (1024.0f * 1024.0f));
+
+        int textureBudget = (int)(TextureStreamer::GetBudget() / (1024 * 1024));
+        if (ImGui::DragInt("Texture Budget (MB)", &textureBudget, 8.0f, 16, 8192))
+            TextureStreamer::SetBudget((uint64_t)textureBudget * 1024 * 1024);
+
+        auto coroutineStats = ScriptEngine::GetCoroutineStats();
+        ImGui::Text("Script Coroutines: %d (%d sleeping)", coroutineStats.Active, coroutineStats.Sleeping);
+
+        glm::uvec2 renderResolution = m_SceneRenderer->GetRenderResolution();
+        ImGui::Text("Render Resolution: %dx%d (%.0f%%)", renderResolution.x, renderResolution.y, m_SceneRenderer->GetRenderScale() * 100.0f);
+        ImGui::Text("Scene GPU Time: %.2f ms", m_SceneRenderer->GetGPUFrameTime());
+
         ImGui::Text(std::to_string(m_FPS).c_str());
 
+        ImGui::Separator();
+
+        bool gpuProfiling = GPUProfiler::IsEnabled();
+        if (ImGui::Checkbox("Pass Timings", &gpuProfiling))
+            GPUProfiler::SetEnabled(gpuProfiling);
+
+        if (gpuProfiling && ImGui::BeginTable("PassTimings", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("GPU Avg");
+            ImGui::TableSetupColumn("GPU Min");
+            ImGui::TableSetupColumn("GPU Max");
+            ImGui::TableSetupColumn("CPU Avg");
+            ImGui::TableHeadersRow();
+
+            for (const auto& pass : GPUProfiler::GetPassStatistics())
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(pass.Name.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%.3f ms", pass.GPU.AvgMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f ms", pass.GPU.MinMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f ms", pass.GPU.MaxMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f ms", pass.CPU.AvgMs);
+            }
+
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Export Timings"))
+            GPUProfiler::ExportCSV("PassTimings.csv");
+
+        ImGui::Separator();
+
+        const auto& graphInfo = m_SceneRenderer->GetRenderGraphInfo();
+        if (ImGui::TreeNode("Render Graph"))
+        {
+            for (const auto& pass : graphInfo.Passes)
+            {
+                if (pass.Culled)
+                    ImGui::TextDisabled("%s (culled)", pass.Name.c_str());
+                else
+                    ImGui::TextUnformatted(pass.Name.c_str());
+
+                std::string reads, writes;
+                for (const auto& read : pass.Reads)
+                    reads += (reads.empty() ? "" : ", ") + read;
+                for (const auto& write : pass.Writes)
+                    writes += (writes.empty() ? "" : ", ") + write;
+
+                ImGui::Indent();
+                ImGui::TextDisabled("Reads: %s", reads.empty() ? "-" : reads.c_str());
+                ImGui::TextDisabled("Writes: %s", writes.empty() ? "-" : writes.c_str());
+                ImGui::Unindent();
+            }
+
+            if (ImGui::Button("Copy as Graphviz"))
+                ImGui::SetClipboardText(graphInfo.ToGraphviz().c_str());
+
+            ImGui::TreePop();
+        }
+
+        ImGui::End();
+
+        ImGui::Begin("Script Profiler");
+
+        bool scriptProfiling = ScriptEngine::IsProfilingEnabled();
+        if (ImGui::Checkbox("Profile Scripts", &scriptProfiling))
+            ScriptEngine::SetProfilingEnabled(scriptProfiling);
+
+        ImGui::SameLine();
+        if (ImGui::Button("Reset"))
+            ScriptEngine::ResetProfile();
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export Report"))
+            ScriptEngine::ExportProfile("ScriptProfile.csv");
+
+        if (ImGui::BeginTable("ScriptProfile", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+        {
+            ImGui::TableSetupColumn("Class");
+            ImGui::TableSetupColumn("Callback");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableSetupColumn("Avg");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableSetupColumn("Allocated");
+            ImGui::TableHeadersRow();
+
+            for (const auto& entry : ScriptEngine::GetProfile())
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(entry.ClassName.c_str());
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(ScriptEngine::GetCallbackName(entry.Callback));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", entry.Calls);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f ms", entry.TotalMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.4f ms", entry.TotalMs / entry.Calls);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f ms", entry.MaxMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f KB", entry.AllocatedBytes / 1024.0);
+            }
+
+            ImGui::EndTable();
+        }
+
         ImGui::End();
 
         if (m_ShowImportDialog)
@@ -544,6 +714,21 @@ namespace RXNEditor {
         return false;
     }
 
+    void EditorLayer::SelectPickedEntity(int pickedID)
+    {
+        if (pickedID > -1)
+        {
+            Entity pickedEntity = { (entt::entity)pickedID, m_ActiveScene.get() };
+            pickedEntity = m_SceneHierarchyPanel.ResolvePickedEntity(pickedEntity);
+
+            m_SceneHierarchyPanel.SetSelectedEntity(pickedEntity);
+        }
+        else
+        {
+            m_SceneHierarchyPanel.SetSelectedEntity({});
+        }
+    }
+
     Ray EditorLayer::CastRayFromMouse(float mx, float my)
     {
         float x = (2.0f * mx) / m_SceneRenderer->GetFinalPass()->GetSpecification().Width - 1.0f;
@@ -565,7 +750,135 @@ namespace RXNEditor {
         if (!path.empty())
         {
             SceneSerializer m_SceneSerializer(m_ActiveScene);
-            m_SceneSerializer.Serialize(path);
+            if (std::filesystem::path(path).extension() == ".rxsb")
+                m_SceneSerializer.SerializeBinary(path);
+            else
+                m_SceneSerializer.Serialize(path);
+        }
+    }
+
+    void EditorLayer::ConvertScene(const std::string& path)
+    {
+        if (path.empty())
+            return;
+
+        Ref<Scene> scene = CreateRef<Scene>();
+        SceneSerializer serializer(scene);
+        if (!serializer.Deserialize(path))
+            return;
+
+        std::filesystem::path output = path;
+        if (SceneSerializer::IsBinary(path))
+        {
+            output.replace_extension(".rxns");
+            serializer.Serialize(output.string());
+        }
+        else
+        {
+            output.replace_extension(".rxsb");
+            serializer.SerializeBinary(output.string());
+        }
+
+        RXN_CORE_INFO("Converted scene '{0}' to '{1}'", path, output.string());
+    }
+
+    void EditorLayer::BenchmarkSceneLoad()
+    {
+        std::filesystem::path directory = std::filesystem::temp_directory_path();
+        std::string yamlPath = (directory / "RXNSceneBenchmark.rxns").string();
+        std::string binaryPath = (directory / "RXNSceneBenchmark.rxsb").string();
+
+        SceneSerializer serializer(m_ActiveScene);
+        serializer.Serialize(yamlPath);
+        serializer.SerializeBinary(binaryPath);
+
+        // Meshes are cached by the AssetManager after the first load, so both formats only pay for the scene itself
+        constexpr int iterations = 5;
+        auto measure = [&](const std::string& scenePath)
+            {
+                float total = 0.0f;
+                for (int i = 0; i < iterations; i++)
+                {
+                    Ref<Scene> scene = CreateRef<Scene>();
+                    SceneSerializer loader(scene);
+
+                    auto start = std::chrono::steady_clock::now();
+                    loader.Deserialize(scenePath);
+                    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    total += elapsed.count();
+                }
+                return total / iterations;
+            };
+
+        float yamlTime = measure(yamlPath);
+        float binaryTime = measure(binaryPath);
+
+        RXN_CORE_INFO("Scene load benchmark ({0} entities, {1} runs): YAML {2:.2f} ms ({3} KB), binary {4:.2f} ms ({5} KB), {6:.1f}x faster",
+            m_ActiveScene->GetRaw().view<IDComponent>().size(), iterations,
+            yamlTime, std::filesystem::file_size(yamlPath) / 1024, binaryTime, std::filesystem::file_size(binaryPath) / 1024,
+            yamlTime / std::max(binaryTime, 0.001f));
+
+        std::filesystem::remove(yamlPath);
+        std::filesystem::remove(binaryPath);
+    }
+
+    void EditorLayer::BenchmarkScriptUpdate()
+    {
+        const std::string className = "UpdateBenchmark";
+        if (!ScriptEngine::EntityClassExists(className))
+        {
+            RXN_CORE_WARN("Script update benchmark needs the '{0}' script in the app assembly", className);
+            return;
+        }
+
+        constexpr int iterations = 10;
+        constexpr float deltaTime = 1.0f / 60.0f;
+
+        for (uint32_t entityCount : { 1000u, 10000u, 50000u })
+        {
+            Ref<Scene> scene = CreateRef<Scene>();
+            ScriptEngine::OnRuntimeStart(scene.get());
+
+            std::vector<entt::entity> entities;
+            entities.reserve(entityCount);
+            for (uint32_t i = 0; i < entityCount; i++)
+            {
+                Entity entity = scene->CreateEntity("Benchmark");
+                entity.AddComponent<ScriptComponent>(className);
+                ScriptEngine::OnCreateEntity(entity);
+                entities.push_back(entity);
+            }
+
+            auto measure = [&](const std::function<void()>& update)
+                {
+                    update();
+
+                    auto start = std::chrono::steady_clock::now();
+                    for (int i = 0; i < iterations; i++)
+                        update();
+                    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    return elapsed.count() / iterations;
+                };
+
+            // The dispatch Scene used before batching, one job and one managed call per entity
+            float perEntityTime = measure([&]()
+                {
+                    uint32_t groupSize = std::max((uint32_t)entities.size() / JobSystem::GetThreadCount(), 1u);
+                    JobSystem::Dispatch((uint32_t)entities.size(), groupSize, [&](JobDispatchArgs args)
+                        {
+                            ScriptEngine::OnUpdateEntity({ entities[args.JobIndex], scene.get() }, deltaTime);
+                        });
+                    JobSystem::Wait();
+                });
+            float batchedTime = measure([&]() { ScriptEngine::OnUpdateEntities(deltaTime); });
+
+            RXN_CORE_INFO("Script update benchmark ({0} entities, {1} runs): per entity {2:.3f} ms, batched {3:.3f} ms, {4:.1f}x faster",
+                entityCount, iterations, perEntityTime, batchedTime, perEntityTime / std::max(batchedTime, 0.001f));
+
+            for (entt::entity e : entities)
+                ScriptEngine::OnDestroyEntity({ e, scene.get() });
+
+            ScriptEngine::OnRuntimeStop();
         }
     }
 
@@ -29,11 +29,16 @@ namespace RXNEditor {
 		void NewScene();
 		void OpenScene(const std::string& path);
 		void SaveSceneAs(const std::string& path);
+		// Writes the scene at path in the other format next to it, YAML (.rxns) <-> binary (.rxsb)
+		void ConvertScene(const std::string& path);
+		void BenchmarkSceneLoad();
+		void BenchmarkScriptUpdate();
 		void OnScenePlay();
 		void OnSceneSimulate(); 
 		void OnSceneStop();
 
 		Ray CastRayFromMouse(float mx, float my);
+		void SelectPickedEntity(int pickedID);
 	private:
 		enum class SceneState
 		{
@@ -59,6 +64,7 @@ namespace RXNEditor {
 		glm::vec2 m_ViewportBounds[2];
 		bool m_ViewportFocused = false;
 		bool m_ViewportHovered = false;
+		bool m_PickingPending = false;
 
 		SceneState m_SceneState = SceneState::Edit;
 
@@ -22,8 +22,43 @@ namespace RXNEditor {
 		RXNEngine::UI::DrawFloatControl("Gamma", m_Context->GetSettings().Gamma, 0.1, 0.0f, 100.0f);
 
 		RXNEngine::UI::DrawFloatControl("Bloom Intensity", m_Context->GetSettings().BloomIntensity, 0.1f, 0.0f, 100.0f, 110.0f);
+		RXNEngine::UI::DrawCheckbox("Compute Bloom", m_Context->GetSettings().ComputeBloom);
+
+		int bloomMipCount = (int)m_Context->GetSettings().BloomMipCount;
+		if (RXNEngine::UI::DrawIntControl("Bloom Mips", bloomMipCount, 0.1f, 1.0f, 8.0f))
+			m_Context->GetSettings().BloomMipCount = (uint32_t)std::clamp(bloomMipCount, 1, 8);
 
 		RXNEngine::UI::DrawCheckbox("Show Colliders", m_Context->GetSettings().ShowColliders);
+
+		const char* pickingModes[] = { "GPU", "GPU (Async)", "CPU" };
+		int pickingMode = (int)m_Context->GetSettings().Picking;
+		if (ImGui::Combo("Picking", &pickingMode, pickingModes, IM_ARRAYSIZE(pickingModes)))
+			m_Context->GetSettings().Picking = (RXNEngine::SceneRenderer::PickingMode)pickingMode;
+
+		auto& settings = m_Context->GetSettings();
+
+		const char* depthPrePassModes[] = { "Off", "On", "Auto" };
+		int depthPrePassMode = (int)settings.DepthPrePass;
+		if (ImGui::Combo("Depth Pre-Pass", &depthPrePassMode, depthPrePassModes, IM_ARRAYSIZE(depthPrePassModes)))
+			settings.DepthPrePass = (RXNEngine::DepthPrePassMode)depthPrePassMode;
+
+		const char* transparencyModes[] = { "Sorted", "Weighted Blended OIT" };
+		int transparencyMode = (int)settings.Transparency;
+		if (ImGui::Combo("Transparency", &transparencyMode, transparencyModes, IM_ARRAYSIZE(transparencyModes)))
+			settings.Transparency = (RXNEngine::TransparencyMode)transparencyMode;
+
+		RXNEngine::UI::DrawCheckbox("Dynamic Resolution", settings.DynamicResolution);
+		if (settings.DynamicResolution)
+		{
+			RXNEngine::UI::DrawFloatControl("Target GPU Time", settings.TargetFrameTime, 0.1f, 1.0f, 100.0f, 110.0f);
+			RXNEngine::UI::DrawFloatControl("Min Scale", settings.MinRenderScale, 0.01f, 0.25f, 1.0f);
+			RXNEngine::UI::DrawFloatControl("Max Scale", settings.MaxRenderScale, 0.01f, 0.25f, 1.0f);
+
+			const char* upscaleFilters[] = { "Bilinear", "Catmull-Rom" };
+			int upscaleFilter = (int)settings.Upscale;
+			if (ImGui::Combo("Upscale", &upscaleFilter, upscaleFilters, IM_ARRAYSIZE(upscaleFilters)))
+				settings.Upscale = (RXNEngine::SceneRenderer::UpscaleFilter)upscaleFilter;
+		}
 		ImGui::End();
 	}
 }
@@ -554,6 +554,10 @@ namespace RXNEditor {
                     UI::DrawFloatControl("Velocity Threshold", component.CCDVelocityThreshold, 1.0f, 0.0f, 1000.0f, 130.0f);
                     ImGui::Unindent();
                 }
+
+                int layer = (int)component.Layer;
+                if (UI::DrawIntControl("Layer", layer, 0.1f, 0.0f, 31.0f))
+                    component.Layer = (uint32_t)std::clamp(layer, 0, 31);
             });
 
         DrawComponent<BoxColliderComponent>("Box Collider", entity, [](auto& component)
@@ -617,7 +621,7 @@ namespace RXNEditor {
                 {
                     if (m_Context->IsRunning())
                     {
-                        auto instance = ScriptEngine::GetEntityScriptInstance(entity.GetUUID());
+                        ScriptInstance* instance = ScriptEngine::GetEntityScriptInstance(entity);
                         if (instance)
                         {
                             const auto& fields = ScriptEngine::GetClassFields(component.ClassName);
@@ -627,59 +631,59 @@ namespace RXNEditor {
                                 {
                                 case ScriptFieldType::Float:
                                 {
-                                    float data = instance->GetFieldValue<float>(field.Name);
+                                    float data = instance->GetFieldValue<float>(field);
                                     if (UI::DrawFloatControl(field.Name.c_str(), data, 0.1f))
-                                        instance->SetFieldValue(field.Name, data);
+                                        instance->SetFieldValue(field, data);
                                     break;
                                 }
                                 case ScriptFieldType::Bool:
                                 {
-                                    bool data = instance->GetFieldValue<bool>(field.Name);
+                                    bool data = instance->GetFieldValue<bool>(field);
                                     if (UI::DrawCheckbox(field.Name.c_str(), data))
-                                        instance->SetFieldValue(field.Name, data);
+                                        instance->SetFieldValue(field, data);
                                     break;
                                 }
                                 case ScriptFieldType::Int:
                                 {
-                                    int data = instance->GetFieldValue<int>(field.Name);
+                                    int data = instance->GetFieldValue<int>(field);
                                     if (UI::DrawIntControl(field.Name.c_str(), data))
-                                        instance->SetFieldValue(field.Name, data);
+                                        instance->SetFieldValue(field, data);
                                     break;
                                 }
                                 case ScriptFieldType::Double:
                                 {
-                                    double data = instance->GetFieldValue<double>(field.Name);
+                                    double data = instance->GetFieldValue<double>(field);
                                     if (ImGui::DragScalar(field.Name.c_str(), ImGuiDataType_Double, &data, 0.1f))
-                                        instance->SetFieldValue(field.Name, data);
+                                        instance->SetFieldValue(field, data);
                                     break;
                                 }
                                 case ScriptFieldType::Vector2:
                                 {
-                                    glm::vec2 data = instance->GetFieldValue<glm::vec2>(field.Name);
+                                    glm::vec2 data = instance->GetFieldValue<glm::vec2>(field);
                                     if (UI::DrawVec2Control(field.Name.c_str(), data, 0.1f))
-                                        instance->SetFieldValue(field.Name, data);
+                                        instance->SetFieldValue(field, data);
                                     break;
                                 }
                                 case ScriptFieldType::Vector3:
                                 {
-                                    glm::vec3 data = instance->GetFieldValue<glm::vec3>(field.Name);
+                                    glm::vec3 data = instance->GetFieldValue<glm::vec3>(field);
                                     if (UI::DrawVec3Control(field.Name.c_str(), data, 0.1f))
-                                        instance->SetFieldValue(field.Name, data);
+                                        instance->SetFieldValue(field, data);
                                     break;
                                 }
                                 case ScriptFieldType::Vector4:
                                 {
-                                    glm::vec4 data = instance->GetFieldValue<glm::vec4>(field.Name);
+                                    glm::vec4 data = instance->GetFieldValue<glm::vec4>(field);
 
                                     if (field.Name.find("Color") != std::string::npos)
                                     {
                                         if (UI::DrawColor4Control(field.Name.c_str(), data))
-                                            instance->SetFieldValue(field.Name, data);
+                                            instance->SetFieldValue(field, data);
                                     }
                                     else
                                     {
                                         if (UI::DrawColor4Control(field.Name.c_str(), data, 0.1f))
-                                            instance->SetFieldValue(field.Name, data);
+                                            instance->SetFieldValue(field, data);
                                     }
                                     break;
                                 }
@@ -688,7 +692,7 @@ namespace RXNEditor {
                                     ImGui::Text("%s", field.Name.c_str());
                                     ImGui::SameLine();
 
-                                    uint64_t targetID = instance->GetFieldValue<uint64_t>(field.Name);
+                                    uint64_t targetID = instance->GetFieldValue<uint64_t>(field);
                                     std::string buttonText = targetID == 0 ? "None (Entity)" : std::to_string(targetID);
 
                                     if (targetID != 0)
@@ -707,7 +711,7 @@ namespace RXNEditor {
                                         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
                                         {
                                             UUID droppedEntityID = *(UUID*)payload->Data;
-                                            instance->SetFieldValue(field.Name, droppedEntityID);
+                                            instance->SetFieldValue(field, droppedEntityID);
                                         }
                                         ImGui::EndDragDropTarget();
                                     }
@@ -0,0 +1,32 @@
+#include "rxnpch.h"
+#include "NullBuffer.h"
+
+#include "NullRendererAPI.h"
+
+namespace RXNEngine {
+
+	// Vertex Buffer -------------------------------------------------------------------------------------
+
+	NullVertexBuffer::NullVertexBuffer(uint32_t size)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Size(size)
+	{
+	}
+
+	NullVertexBuffer::NullVertexBuffer(float* vertices, uint32_t size)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Size(size)
+	{
+	}
+
+	void NullVertexBuffer::SetData(const void* data, uint32_t size)
+	{
+		RXN_CORE_ASSERT(size <= m_Size, "Vertex buffer overflow!");
+	}
+
+	// Index Buffer --------------------------------------------------------------------------------------
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t* indices, uint32_t count)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Count(count)
+	{
+	}
+
+}
\ No newline at end of file
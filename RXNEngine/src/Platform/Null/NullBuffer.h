@@ -0,0 +1,44 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/Buffer.h"
+
+namespace RXNEngine {
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(uint32_t size);
+		NullVertexBuffer(float* vertices, uint32_t size);
+		virtual ~NullVertexBuffer() = default;
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override;
+
+		inline virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		inline virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		uint32_t GetSize() const { return m_Size; }
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32_t* indices, uint32_t count);
+		virtual ~NullIndexBuffer() = default;
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		uint32_t GetCount() const override { return m_Count; }
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Count;
+	};
+
+}
\ No newline at end of file
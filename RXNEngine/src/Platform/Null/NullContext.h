@@ -0,0 +1,14 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/GraphicsContext.h"
+
+namespace RXNEngine {
+
+	class NullContext : public GraphicsContext
+	{
+	public:
+		virtual void Init() override {}
+		virtual void SwapBuffers() override {}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/OcclusionQuery.h"
+
+namespace RXNEngine {
+
+	class NullOcclusionQuery : public OcclusionQuery
+	{
+	public:
+		virtual void Begin() override {}
+		virtual void End() override {}
+
+		virtual bool IsResultAvailable() const override { return true; }
+		virtual uint64_t GetSampleCount() const override { return 0; }
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/PixelReadback.h"
+
+namespace RXNEngine {
+
+	// Nothing is rasterized, every request resolves to "no entity" on the next poll
+	class NullPixelReadback : public PixelReadback
+	{
+	public:
+		virtual void Request(uint32_t attachmentIndex, int x, int y) override { m_Pending = true; }
+
+		virtual bool Poll(int& outValue) override
+		{
+			if (!m_Pending)
+				return false;
+
+			m_Pending = false;
+			outValue = -1;
+			return true;
+		}
+
+		virtual bool IsPending() const override { return m_Pending; }
+	private:
+		bool m_Pending = false;
+	};
+
+}
\ No newline at end of file
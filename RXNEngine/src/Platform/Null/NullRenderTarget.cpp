@@ -0,0 +1,46 @@
+#include "rxnpch.h"
+#include "NullRenderTarget.h"
+
+#include "NullRendererAPI.h"
+
+namespace RXNEngine {
+
+	NullRenderTarget::NullRenderTarget(const RenderTargetSpecification& spec)
+		: m_Specification(spec)
+	{
+		for (auto spec : m_Specification.Attachments.Attachments)
+		{
+			if (spec.TextureFormat == RenderTargetTextureFormat::DEPTH24STENCIL8)
+				continue;
+
+			m_ColorAttachments.push_back(NullRendererAPI::GenerateRendererID());
+			m_ClearValues.push_back(0);
+		}
+	}
+
+	void NullRenderTarget::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0)
+		{
+			RXN_CORE_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+	}
+
+	int NullRenderTarget::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		RXN_CORE_ASSERT(attachmentIndex < m_ClearValues.size());
+
+		return m_ClearValues[attachmentIndex];
+	}
+
+	void NullRenderTarget::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		RXN_CORE_ASSERT(attachmentIndex < m_ClearValues.size());
+
+		m_ClearValues[attachmentIndex] = value;
+	}
+
+}
\ No newline at end of file
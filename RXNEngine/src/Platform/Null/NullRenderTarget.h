@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RXNEngine/Renderer/RenderTarget.h"
+
+namespace RXNEngine {
+
+	class NullRenderTarget : public RenderTarget
+	{
+	public:
+		NullRenderTarget(const RenderTargetSpecification& spec);
+		virtual ~NullRenderTarget() = default;
+
+		virtual void Bind() override {}
+		virtual void Unbind() override {}
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+		// Returns the last value the attachment was cleared to, nothing is ever rasterized
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+
+		virtual void CopyDepthTo(const Ref<RenderTarget>& destination) override {}
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { RXN_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
+
+		virtual const RenderTargetSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		RenderTargetSpecification m_Specification;
+
+		std::vector<uint32_t> m_ColorAttachments;
+		std::vector<int> m_ClearValues;
+	};
+
+}
\ No newline at end of file
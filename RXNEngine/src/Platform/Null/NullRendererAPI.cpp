@@ -0,0 +1,64 @@
+#include "rxnpch.h"
+#include "NullRendererAPI.h"
+
+#include <atomic>
+
+namespace RXNEngine {
+
+	static NullRendererStatistics s_Statistics;
+	static std::atomic<uint32_t> s_NextRendererID = 1;
+
+	void NullRendererAPI::Init()
+	{
+		RXN_CORE_INFO("Null Renderer Info:");
+		RXN_CORE_INFO("  Headless, no GPU work will be submitted");
+
+		ResetStatistics();
+	}
+
+	void NullRendererAPI::Draw(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	{
+		s_Statistics.DrawCalls++;
+		s_Statistics.Vertices += vertexCount;
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	{
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+
+		s_Statistics.DrawCalls++;
+		s_Statistics.Indices += count;
+	}
+
+	void NullRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& transformBuffer,
+		uint32_t instanceCount, uint32_t indexCount, uint32_t baseIndex)
+	{
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+
+		s_Statistics.DrawCalls++;
+		s_Statistics.Indices += (uint64_t)count * instanceCount;
+		s_Statistics.Instances += instanceCount;
+	}
+
+	void NullRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	{
+		s_Statistics.DrawCalls++;
+		s_Statistics.Vertices += vertexCount;
+	}
+
+	const NullRendererStatistics& NullRendererAPI::GetStatistics()
+	{
+		return s_Statistics;
+	}
+
+	void NullRendererAPI::ResetStatistics()
+	{
+		s_Statistics = NullRendererStatistics();
+	}
+
+	uint32_t NullRendererAPI::GenerateRendererID()
+	{
+		return s_NextRendererID.fetch_add(1, std::memory_order_relaxed);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RXNEngine/Renderer/RendererAPI.h"
+
+namespace RXNEngine {
+
+	struct NullRendererStatistics
+	{
+		uint64_t DrawCalls = 0;
+		uint64_t Vertices = 0;
+		uint64_t Indices = 0;
+		uint64_t Instances = 0;
+	};
+
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override;
+
+		virtual void BindDefaultRenderTarget() override {}
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override {}
+		virtual void SetClearColor(const glm::vec4& color) override {}
+		virtual void Clear() override {}
+
+		virtual void SetDepthTest(bool enabled) override {}
+		virtual void SetDepthFunc(DepthFunc func) override {}
+		virtual void SetCullFace(CullFace face) override {}
+
+		virtual void SetBlend(bool enabled) override {}
+		virtual void SetBlendFunc(BlendFactor source, BlendFactor destination) override {}
+		virtual void SetBlendEquation(BlendEquation equation) override {}
+
+		virtual void SetStencilTest(bool enabled) override {}
+		virtual void SetStencilMask(uint32_t mask) override {}
+		virtual void SetStencilFunc(StencilFunc func, int ref, uint32_t mask) override {}
+		virtual void SetStencilOp(StencilOp fail, StencilOp zfail, StencilOp zpass) override {}
+
+		virtual void SetDepthMask(bool writeEnabled) override {}
+		virtual void SetColorMask(bool r, bool g, bool b, bool a) override {}
+
+		virtual void BindTextureID(uint32_t slot, uint32_t textureID) override {}
+
+		virtual void Draw(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& transformBuffer,
+			uint32_t instanceCount, uint32_t indexCount, uint32_t baseIndex) override;
+		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+
+		virtual void SetLineWidth(float width) override {}
+
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override {}
+		virtual void ComputeBarrier() override {}
+
+		// Totals of everything that would have been submitted to a GPU since Init
+		static const NullRendererStatistics& GetStatistics();
+		static void ResetStatistics();
+
+		// Null resources still hand out unique, non-zero IDs so ID based batching and lookups behave like on a GPU backend
+		static uint32_t GenerateRendererID();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "rxnpch.h"
+#include "NullShader.h"
+
+#include "NullRendererAPI.h"
+
+namespace RXNEngine {
+
+	NullShader::NullShader(const std::string& filepath)
+		: m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		std::filesystem::path path = filepath;
+		m_Name = path.stem().string();
+
+		if (!std::filesystem::exists(path))
+			RXN_CORE_ERROR("Could not open file '{0}'", filepath);
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_RendererID(NullRendererAPI::GenerateRendererID()), m_Name(name)
+	{
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/Shader.h"
+
+namespace RXNEngine {
+
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const std::string& filepath);
+		NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		~NullShader() = default;
+
+		void Bind() const override {}
+		void Unbind() const override {}
+
+		virtual const std::string& GetName() const override { return m_Name; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual void SetInt(const std::string& name, int value) override {}
+		virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override {}
+		virtual void SetFloat(const std::string& name, float value) override {}
+		virtual void SetFloat2(const std::string& name, const glm::vec2& value) override {}
+		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override {}
+		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override {}
+		virtual void SetMat3(const std::string& name, const glm::mat3& value) override {}
+		virtual void SetMat4(const std::string& name, const glm::mat4& value) override {}
+	private:
+		uint32_t m_RendererID;
+		std::string m_Name;
+	};
+
+}
\ No newline at end of file
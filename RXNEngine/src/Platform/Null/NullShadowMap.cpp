@@ -0,0 +1,16 @@
+#include "rxnpch.h"
+#include "NullShadowMap.h"
+
+#include "NullRendererAPI.h"
+
+namespace RXNEngine {
+
+	void NullShadowMap::Init(uint32_t size)
+	{
+		m_Size = size;
+
+		if (!m_RendererID)
+			m_RendererID = NullRendererAPI::GenerateRendererID();
+	}
+
+}
\ No newline at end of file
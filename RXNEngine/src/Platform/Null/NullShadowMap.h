@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RXNEngine/Renderer/ShadowMap.h"
+
+namespace RXNEngine {
+
+	class NullShadowMap : public ShadowMap
+	{
+	public:
+		virtual ~NullShadowMap() = default;
+
+		virtual void Init(uint32_t size) override;
+		virtual void BindWrite() override {}
+		virtual void BindRead(uint32_t slot) override {}
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Size = 0;
+	};
+
+}
\ No newline at end of file
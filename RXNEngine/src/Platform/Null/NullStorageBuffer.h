@@ -0,0 +1,22 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/StorageBuffer.h"
+
+namespace RXNEngine {
+
+	class NullStorageBuffer : public StorageBuffer
+	{
+	public:
+		NullStorageBuffer(uint32_t size, uint32_t binding)
+			: m_Size(size), m_Binding(binding) {}
+		virtual ~NullStorageBuffer() = default;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override
+		{
+			RXN_CORE_ASSERT(offset + size <= m_Size, "Storage buffer overflow!");
+		}
+	private:
+		uint32_t m_Size;
+		uint32_t m_Binding;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "rxnpch.h"
+#include "NullTexture.h"
+
+#include "NullRendererAPI.h"
+
+#include <stb_image.h>
+
+namespace RXNEngine {
+
+	namespace Utils {
+
+		static uint32_t ImageFormatBytesPerPixel(ImageFormat format)
+		{
+			switch (format)
+			{
+				case ImageFormat::R8:      return 1;
+				case ImageFormat::RGB8:    return 3;
+				case ImageFormat::RGBA8:   return 4;
+				case ImageFormat::RGBA32F: return 16;
+			}
+
+			RXN_CORE_ASSERT(false);
+			return 0;
+		}
+
+		static ImageFormat ChannelsToImageFormat(int channels)
+		{
+			switch (channels)
+			{
+				case 1: return ImageFormat::R8;
+				case 3: return ImageFormat::RGB8;
+			}
+
+			return ImageFormat::RGBA8;
+		}
+
+	}
+
+	// Texture 2D ----------------------------------------------------------------------------------------
+
+	NullTexture2D::NullTexture2D(const TextureSpecification& specification)
+		: m_Specification(specification), m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		m_MipCount = m_Specification.MipLevels ? m_Specification.MipLevels : (uint32_t)std::floor(std::log2(std::max(m_Specification.Width, m_Specification.Height))) + 1;
+		m_IsLoaded = true;
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path, bool loadImmediately)
+		: m_Path(path), m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		if (!loadImmediately)
+			return;
+
+		int width, height, channels;
+		if (stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			m_IsLoaded = true;
+			m_Specification.Width = width;
+			m_Specification.Height = height;
+			m_Specification.Format = Utils::ChannelsToImageFormat(channels);
+		}
+		else
+		{
+			RXN_CORE_ERROR("Failed to load texture: {0}", path);
+		}
+	}
+
+	NullTexture2D::NullTexture2D(const void* data, size_t size)
+		: m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		int width, height, channels;
+		if (stbi_info_from_memory((const stbi_uc*)data, (int)size, &width, &height, &channels))
+		{
+			m_IsLoaded = true;
+			m_Specification.Width = width;
+			m_Specification.Height = height;
+			m_Specification.Format = Utils::ChannelsToImageFormat(channels);
+		}
+		else
+		{
+			RXN_CORE_ERROR("Failed to load texture from memory!");
+		}
+	}
+
+	void NullTexture2D::SetData(void* data, uint32_t size)
+	{
+		uint32_t bytesPerPixel = Utils::ImageFormatBytesPerPixel(m_Specification.Format);
+		RXN_CORE_ASSERT(size == m_Specification.Width * m_Specification.Height * bytesPerPixel, "Data must be entire texture!");
+	}
+
+	void NullTexture2D::UploadImage(const TextureImage& image, uint32_t firstRow, uint32_t rowCount)
+	{
+		RXN_CORE_ASSERT(image.IsValid(), "Uploading an empty image!");
+
+		if (firstRow == 0)
+		{
+			m_IsLoaded = false;
+			m_Specification.Width = image.Width;
+			m_Specification.Height = image.Height;
+			m_Specification.Format = image.HDR ? ImageFormat::RGBA32F : Utils::ChannelsToImageFormat(image.Channels);
+			m_MipCount = image.IsCompressed() ? image.MipCount : 1;
+			m_BaseMip = image.FirstMip;
+		}
+
+		if (firstRow + rowCount >= image.GetMipHeight(image.FirstMip))
+			m_IsLoaded = true;
+	}
+
+	void NullTexture2D::SetBaseMip(uint32_t baseMip, const TextureImage& image)
+	{
+		RXN_CORE_ASSERT(m_IsLoaded && baseMip < m_MipCount);
+		RXN_CORE_ASSERT(baseMip >= m_BaseMip || (image.IsCompressed() && image.FirstMip <= baseMip), "Streamed in mips are missing!");
+
+		m_BaseMip = baseMip;
+	}
+
+	// Cubemap -------------------------------------------------------------------------------------------
+
+	NullCubemap::NullCubemap(const std::vector<std::string>& paths)
+		: m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		int width, height, channels;
+		m_IsLoaded = !paths.empty();
+		for (const auto& path : paths)
+		{
+			if (!stbi_info(path.c_str(), &width, &height, &channels))
+			{
+				RXN_CORE_ERROR("Failed to load cube map face: {0}", path);
+				m_IsLoaded = false;
+				continue;
+			}
+
+			m_Specification.Width = width;
+			m_Specification.Height = height;
+		}
+
+		if (!paths.empty())
+			m_Path = paths[0];
+	}
+
+	NullCubemap::NullCubemap(const std::string& path)
+		: m_Path(path), m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+		int width, height, channels;
+		if (stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			m_IsLoaded = true;
+			m_Specification.Width = width;
+			m_Specification.Height = height;
+			m_Specification.Format = ImageFormat::RGBA32F;
+		}
+		else
+		{
+			RXN_CORE_ERROR("Failed to load texture: {0}", path);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/Texture.h"
+
+namespace RXNEngine {
+
+	// Only image headers are read, pixel data is never decoded or stored
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		NullTexture2D(const TextureSpecification& specification);
+		NullTexture2D(const std::string& path, bool loadImmediately = true);
+		NullTexture2D(const void* data, size_t size);
+		virtual ~NullTexture2D() = default;
+
+		virtual const TextureSpecification& GetSpecification() const override { return m_Specification; }
+
+		virtual uint32_t GetWidth() const override { return m_Specification.Width; }
+		virtual uint32_t GetHeight() const override { return m_Specification.Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+
+		virtual const std::string& GetPath() const override { return m_Path; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+
+		virtual void Bind(uint32_t slot = 0) const override {}
+
+		virtual void UploadImage(const TextureImage& image, uint32_t firstRow, uint32_t rowCount) override;
+
+		virtual uint32_t GetMipCount() const override { return m_MipCount; }
+		virtual uint32_t GetBaseMip() const override { return m_BaseMip; }
+		virtual void SetBaseMip(uint32_t baseMip, const TextureImage& image) override;
+
+		virtual void BindImage(uint32_t unit, uint32_t mip, ImageAccess access) const override {}
+
+		virtual bool IsLoaded() const override { return m_IsLoaded; }
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+	private:
+		TextureSpecification m_Specification;
+		std::string m_Path;
+		bool m_IsLoaded = false;
+		uint32_t m_MipCount = 1, m_BaseMip = 0;
+		uint32_t m_RendererID;
+	};
+
+	class NullCubemap : public Cubemap
+	{
+	public:
+		NullCubemap(const std::vector<std::string>& paths);
+		NullCubemap(const std::string& path);
+		virtual ~NullCubemap() = default;
+
+		virtual uint32_t GetWidth() const override { return m_Specification.Width; }
+		virtual uint32_t GetHeight() const override { return m_Specification.Height; }
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual const std::string& GetPath() const override { return m_Path; }
+		virtual const TextureSpecification& GetSpecification() const override { return m_Specification; }
+
+		virtual void SetData(void* data, uint32_t size) override {}
+		virtual void Bind(uint32_t slot = 0) const override {}
+
+		virtual bool IsLoaded() const override { return m_IsLoaded; }
+
+		virtual bool operator==(const Texture& other) const override
+		{
+			return m_RendererID == other.GetRendererID();
+		}
+	private:
+		TextureSpecification m_Specification;
+		std::string m_Path;
+		bool m_IsLoaded = false;
+		uint32_t m_RendererID;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/TimerQuery.h"
+
+namespace RXNEngine {
+
+	class NullTimerQuery : public TimerQuery
+	{
+	public:
+		virtual void Begin() override {}
+		virtual void End() override {}
+
+		virtual bool IsResultAvailable() const override { return true; }
+		virtual uint64_t GetElapsedTime() const override { return 0; }
+	};
+
+}
\ No newline at end of file
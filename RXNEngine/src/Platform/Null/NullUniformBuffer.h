@@ -0,0 +1,22 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/UniformBuffer.h"
+
+namespace RXNEngine {
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+	public:
+		NullUniformBuffer(uint32_t size, uint32_t binding)
+			: m_Size(size), m_Binding(binding) {}
+		virtual ~NullUniformBuffer() = default;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override
+		{
+			RXN_CORE_ASSERT(offset + size <= m_Size, "Uniform buffer overflow!");
+		}
+	private:
+		uint32_t m_Size;
+		uint32_t m_Binding;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "rxnpch.h"
+#include "NullVertexArray.h"
+
+#include "NullRendererAPI.h"
+
+namespace RXNEngine {
+
+	NullVertexArray::NullVertexArray()
+		: m_RendererID(NullRendererAPI::GenerateRendererID())
+	{
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		RXN_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "VertexBuffer has no layout!");
+
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void NullVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+	{
+		m_IndexBuffer = indexBuffer;
+	}
+
+}
\ No newline at end of file
@@ -6,12 +6,25 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <stb_image.h>
+#include <fstream>
 
 namespace RXNEngine {
 
 	static Ref<VertexArray> s_CubeVAO;
 	static Ref<VertexArray> s_QuadVAO;
 
+	static constexpr uint32_t s_EnvironmentResolution = 1024;
+	static constexpr uint32_t s_IrradianceResolution = 32;
+	static constexpr uint32_t s_PrefilterResolution = 128;
+	static constexpr uint32_t s_PrefilterMipLevels = 5;
+	static constexpr uint32_t s_BRDFLUTResolution = 512;
+
+	static constexpr uint32_t s_IBLCacheVersion = 1;
+	static const char* s_BRDFLUTCachePath = "res/cache/ibl_brdf_lut.bin";
+
+	// The BRDF LUT doesn't depend on the environment, so every cubemap shares one texture
+	static uint32_t s_BRDFLUTMapID = 0;
+
 	static void RenderCube()
 	{
 		OPTICK_EVENT();
@@ -98,13 +111,133 @@ namespace RXNEngine {
 	}
 
 
+	static uint64_t HashFile(const std::string& path)
+	{
+		OPTICK_EVENT();
+
+		std::ifstream in(path, std::ios::binary);
+		if (!in.is_open())
+			return 0;
+
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		std::vector<char> buffer(1 << 16);
+		while (in)
+		{
+			in.read(buffer.data(), buffer.size());
+			std::streamsize count = in.gcount();
+			for (std::streamsize i = 0; i < count; i++)
+			{
+				hash ^= (uint8_t)buffer[i];
+				hash *= 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+
+	static void WriteCubemapLevels(std::ofstream& out, uint32_t rendererID, uint32_t size, uint32_t levels)
+	{
+		out.write((char*)&size, sizeof(uint32_t));
+		out.write((char*)&levels, sizeof(uint32_t));
+
+		std::vector<uint16_t> pixels;
+		for (uint32_t mip = 0; mip < levels; mip++)
+		{
+			uint32_t mipSize = std::max(size >> mip, 1u);
+			pixels.resize((size_t)mipSize * mipSize * 3 * 6);
+
+			glGetTextureSubImage(rendererID, mip, 0, 0, 0, mipSize, mipSize, 6, GL_RGB, GL_HALF_FLOAT,
+				(GLsizei)(pixels.size() * sizeof(uint16_t)), pixels.data());
+			out.write((char*)pixels.data(), pixels.size() * sizeof(uint16_t));
+		}
+	}
+
+	static uint32_t ReadCubemapLevels(std::ifstream& in, uint32_t expectedSize, uint32_t expectedLevels)
+	{
+		uint32_t size = 0, levels = 0;
+		in.read((char*)&size, sizeof(uint32_t));
+		in.read((char*)&levels, sizeof(uint32_t));
+		if (!in || size != expectedSize || levels != expectedLevels)
+			return 0;
+
+		uint32_t rendererID;
+		glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &rendererID);
+		glTextureStorage2D(rendererID, levels, GL_RGB16F, size, size);
+
+		std::vector<uint16_t> pixels;
+		for (uint32_t mip = 0; mip < levels; mip++)
+		{
+			uint32_t mipSize = std::max(size >> mip, 1u);
+			pixels.resize((size_t)mipSize * mipSize * 3 * 6);
+
+			in.read((char*)pixels.data(), pixels.size() * sizeof(uint16_t));
+			if (!in)
+			{
+				glDeleteTextures(1, &rendererID);
+				return 0;
+			}
+			glTextureSubImage3D(rendererID, mip, 0, 0, 0, mipSize, mipSize, 6, GL_RGB, GL_HALF_FLOAT, pixels.data());
+		}
+
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(rendererID, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(rendererID, GL_TEXTURE_MAX_LEVEL, levels - 1);
+
+		return rendererID;
+	}
+
+	static bool LoadBRDFLUTCache(uint32_t rendererID)
+	{
+		std::ifstream in(s_BRDFLUTCachePath, std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		uint32_t version = 0, size = 0;
+		in.read((char*)&version, sizeof(uint32_t));
+		in.read((char*)&size, sizeof(uint32_t));
+		if (!in || version != s_IBLCacheVersion || size != s_BRDFLUTResolution)
+			return false;
+
+		std::vector<uint16_t> pixels((size_t)size * size * 2);
+		in.read((char*)pixels.data(), pixels.size() * sizeof(uint16_t));
+		if (!in)
+			return false;
+
+		glTextureSubImage2D(rendererID, 0, 0, 0, size, size, GL_RG, GL_HALF_FLOAT, pixels.data());
+		return true;
+	}
+
+	static void WriteBRDFLUTCache(uint32_t rendererID)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(s_BRDFLUTCachePath).parent_path(), ec);
+
+		std::ofstream out(s_BRDFLUTCachePath, std::ios::binary);
+		if (!out.is_open())
+		{
+			RXN_CORE_WARN("Failed to write BRDF LUT cache: {0}", s_BRDFLUTCachePath);
+			return;
+		}
+
+		uint32_t size = s_BRDFLUTResolution;
+		std::vector<uint16_t> pixels((size_t)size * size * 2);
+		glGetTextureImage(rendererID, 0, GL_RG, GL_HALF_FLOAT, (GLsizei)(pixels.size() * sizeof(uint16_t)), pixels.data());
+
+		out.write((char*)&s_IBLCacheVersion, sizeof(uint32_t));
+		out.write((char*)&size, sizeof(uint32_t));
+		out.write((char*)pixels.data(), pixels.size() * sizeof(uint16_t));
+	}
+
 	OpenGLCubemap::OpenGLCubemap(const std::vector<std::string>& paths)
 	{
 		glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_RendererID);
 		glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
 
 		int width, height, channels;
-		stbi_set_flip_vertically_on_load(0);
+		stbi_set_flip_vertically_on_load_thread(0);
 
 		for (uint32_t i = 0; i < paths.size(); i++)
 		{
@@ -140,6 +273,15 @@ namespace RXNEngine {
 	OpenGLCubemap::OpenGLCubemap(const std::string& path)
 		: m_Path(path)
 	{
+		std::filesystem::path cachePath = path + ".iblcache";
+		uint64_t sourceHash = HashFile(path);
+
+		if (sourceHash && LoadIBLCache(cachePath, sourceHash))
+		{
+			CreateBRDFLUT();
+			return;
+		}
+
 		Ref<Texture2D> hdrTexture = Texture2D::Create(path);
 
 		uint32_t captureFBO, captureRBO;
@@ -149,7 +291,7 @@ namespace RXNEngine {
 		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
 		glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
 
-		int res = 1024;
+		int res = s_EnvironmentResolution;
 		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, res, res);
 		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, captureRBO);
 
@@ -200,6 +342,9 @@ namespace RXNEngine {
 		CreateIrradianceMap();
 		CreatePrefilterMap();
 		CreateBRDFLUT();
+
+		if (sourceHash)
+			WriteIBLCache(cachePath, sourceHash);
 	}
 
 	OpenGLCubemap::~OpenGLCubemap()
@@ -207,7 +352,6 @@ namespace RXNEngine {
 		glDeleteTextures(1, &m_RendererID);
 		glDeleteTextures(1, &m_IrradianceMapID);
 		glDeleteTextures(1, &m_PrefilterMapID);
-		glDeleteTextures(1, &m_BRDFLUTMapID);
 	}
 
 	void OpenGLCubemap::Bind(uint32_t slot) const
@@ -220,7 +364,7 @@ namespace RXNEngine {
 	{
 		OPTICK_EVENT();
 
-		int res = 32;
+		int res = s_IrradianceResolution;
 		uint32_t captureFBO, captureRBO;
 		glGenFramebuffers(1, &captureFBO);
 		glGenRenderbuffers(1, &captureRBO);
@@ -275,7 +419,7 @@ namespace RXNEngine {
 	{
 		OPTICK_EVENT();
 
-		int res = 128;
+		int res = s_PrefilterResolution;
 		uint32_t captureFBO, captureRBO;
 		glGenFramebuffers(1, &captureFBO);
 		glGenRenderbuffers(1, &captureRBO);
@@ -294,7 +438,7 @@ namespace RXNEngine {
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 4);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, s_PrefilterMipLevels - 1);
 
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
@@ -316,7 +460,7 @@ namespace RXNEngine {
 		glBindTextureUnit(0, m_RendererID);
 
 		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-		unsigned int maxMipLevels = 5;
+		unsigned int maxMipLevels = s_PrefilterMipLevels;
 		for (unsigned int mip = 0; mip < maxMipLevels; ++mip)
 		{
 			unsigned int mipWidth = res * std::pow(0.5, mip);
@@ -346,24 +490,34 @@ namespace RXNEngine {
 	{
 		OPTICK_EVENT();
 
-		glGenTextures(1, &m_BRDFLUTMapID);
-		glBindTexture(GL_TEXTURE_2D, m_BRDFLUTMapID);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, 0);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		if (s_BRDFLUTMapID)
+		{
+			m_BRDFLUTMapID = s_BRDFLUTMapID;
+			return;
+		}
+
+		int res = s_BRDFLUTResolution;
+		glCreateTextures(GL_TEXTURE_2D, 1, &s_BRDFLUTMapID);
+		glTextureStorage2D(s_BRDFLUTMapID, 1, GL_RG16F, res, res);
+		glTextureParameteri(s_BRDFLUTMapID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(s_BRDFLUTMapID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(s_BRDFLUTMapID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(s_BRDFLUTMapID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		m_BRDFLUTMapID = s_BRDFLUTMapID;
+
+		if (LoadBRDFLUTCache(s_BRDFLUTMapID))
+			return;
 
 		uint32_t captureFBO, captureRBO;
 		glGenFramebuffers(1, &captureFBO);
 		glGenRenderbuffers(1, &captureRBO);
 		glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
 		glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_BRDFLUTMapID, 0);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, res, res);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_BRDFLUTMapID, 0);
 
 		glDisable(GL_BLEND);
-		glViewport(0, 0, 512, 512);
+		glViewport(0, 0, res, res);
 		Ref<Shader> brdfShader = Shader::Create("res/shaders/ibl_brdf.glsl");
 		brdfShader->Bind();
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -374,5 +528,63 @@ namespace RXNEngine {
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 		glDeleteFramebuffers(1, &captureFBO);
 		glDeleteRenderbuffers(1, &captureRBO);
+
+		WriteBRDFLUTCache(s_BRDFLUTMapID);
+	}
+
+	bool OpenGLCubemap::LoadIBLCache(const std::filesystem::path& cachePath, uint64_t sourceHash)
+	{
+		OPTICK_EVENT();
+
+		std::ifstream in(cachePath, std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		char magic[4];
+		uint32_t version = 0;
+		uint64_t hash = 0;
+		in.read(magic, 4);
+		in.read((char*)&version, sizeof(uint32_t));
+		in.read((char*)&hash, sizeof(uint64_t));
+
+		if (!in || memcmp(magic, "IBL\0", 4) != 0 || version != s_IBLCacheVersion || hash != sourceHash)
+			return false;
+
+		m_RendererID = ReadCubemapLevels(in, s_EnvironmentResolution, 1);
+		m_IrradianceMapID = ReadCubemapLevels(in, s_IrradianceResolution, 1);
+		m_PrefilterMapID = ReadCubemapLevels(in, s_PrefilterResolution, s_PrefilterMipLevels);
+
+		if (!m_RendererID || !m_IrradianceMapID || !m_PrefilterMapID)
+		{
+			RXN_CORE_WARN("IBL cache is corrupt, regenerating: {0}", cachePath.string());
+
+			glDeleteTextures(1, &m_RendererID);
+			glDeleteTextures(1, &m_IrradianceMapID);
+			glDeleteTextures(1, &m_PrefilterMapID);
+			m_RendererID = m_IrradianceMapID = m_PrefilterMapID = 0;
+			return false;
+		}
+
+		return true;
+	}
+
+	void OpenGLCubemap::WriteIBLCache(const std::filesystem::path& cachePath, uint64_t sourceHash) const
+	{
+		OPTICK_EVENT();
+
+		std::ofstream out(cachePath, std::ios::binary);
+		if (!out.is_open())
+		{
+			RXN_CORE_WARN("Failed to write IBL cache: {0}", cachePath.string());
+			return;
+		}
+
+		out.write("IBL\0", 4);
+		out.write((char*)&s_IBLCacheVersion, sizeof(uint32_t));
+		out.write((char*)&sourceHash, sizeof(uint64_t));
+
+		WriteCubemapLevels(out, m_RendererID, s_EnvironmentResolution, 1);
+		WriteCubemapLevels(out, m_IrradianceMapID, s_IrradianceResolution, 1);
+		WriteCubemapLevels(out, m_PrefilterMapID, s_PrefilterResolution, s_PrefilterMipLevels);
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "RXNEngine/Renderer/GraphicsAPI/Shader.h"
 
 #include <vector>
+#include <filesystem>
 
 namespace RXNEngine {
 	class OpenGLCubemap : public Cubemap
@@ -35,6 +36,9 @@ namespace RXNEngine {
 		void CreateIrradianceMap();
 		void CreatePrefilterMap();
 		void CreateBRDFLUT();
+
+		bool LoadIBLCache(const std::filesystem::path& cachePath, uint64_t sourceHash);
+		void WriteIBLCache(const std::filesystem::path& cachePath, uint64_t sourceHash) const;
 	private:
 		uint32_t m_RendererID;
 		uint32_t m_IrradianceMapID = 0;
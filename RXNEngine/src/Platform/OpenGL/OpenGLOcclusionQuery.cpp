@@ -0,0 +1,42 @@
+#include "rxnpch.h"
+#include "OpenGLOcclusionQuery.h"
+
+#include <glad/glad.h>
+
+namespace RXNEngine {
+
+	OpenGLOcclusionQuery::OpenGLOcclusionQuery()
+	{
+		glCreateQueries(GL_SAMPLES_PASSED, 1, &m_QueryID);
+	}
+
+	OpenGLOcclusionQuery::~OpenGLOcclusionQuery()
+	{
+		glDeleteQueries(1, &m_QueryID);
+	}
+
+	void OpenGLOcclusionQuery::Begin()
+	{
+		glBeginQuery(GL_SAMPLES_PASSED, m_QueryID);
+	}
+
+	void OpenGLOcclusionQuery::End()
+	{
+		glEndQuery(GL_SAMPLES_PASSED);
+	}
+
+	bool OpenGLOcclusionQuery::IsResultAvailable() const
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(m_QueryID, GL_QUERY_RESULT_AVAILABLE, &available);
+		return available != 0;
+	}
+
+	uint64_t OpenGLOcclusionQuery::GetSampleCount() const
+	{
+		GLuint64 samples = 0;
+		glGetQueryObjectui64v(m_QueryID, GL_QUERY_RESULT, &samples);
+		return samples;
+	}
+
+}
\ No newline at end of file
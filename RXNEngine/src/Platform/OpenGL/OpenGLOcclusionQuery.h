@@ -0,0 +1,22 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/OcclusionQuery.h"
+
+namespace RXNEngine {
+
+	class OpenGLOcclusionQuery : public OcclusionQuery
+	{
+	public:
+		OpenGLOcclusionQuery();
+		virtual ~OpenGLOcclusionQuery();
+
+		virtual void Begin() override;
+		virtual void End() override;
+
+		virtual bool IsResultAvailable() const override;
+		virtual uint64_t GetSampleCount() const override;
+	private:
+		uint32_t m_QueryID = 0;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "rxnpch.h"
+#include "OpenGLPixelReadback.h"
+
+#include <glad/glad.h>
+
+namespace RXNEngine {
+
+	OpenGLPixelReadback::OpenGLPixelReadback()
+	{
+		for (auto& slot : m_Slots)
+		{
+			glCreateBuffers(1, &slot.BufferID);
+			glNamedBufferData(slot.BufferID, sizeof(int), nullptr, GL_STREAM_READ);
+		}
+	}
+
+	OpenGLPixelReadback::~OpenGLPixelReadback()
+	{
+		for (auto& slot : m_Slots)
+		{
+			if (slot.Fence)
+				glDeleteSync((GLsync)slot.Fence);
+			glDeleteBuffers(1, &slot.BufferID);
+		}
+	}
+
+	void OpenGLPixelReadback::Request(uint32_t attachmentIndex, int x, int y)
+	{
+		OPTICK_EVENT();
+
+		ReadbackSlot& slot = m_Slots[m_NextSlot];
+		m_NextSlot = (m_NextSlot + 1) % m_Slots.size();
+
+		// All slots in flight, the oldest request is dropped in favour of the new one
+		if (slot.Fence)
+			glDeleteSync((GLsync)slot.Fence);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.BufferID);
+		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		slot.Sequence = ++m_Sequence;
+	}
+
+	bool OpenGLPixelReadback::Poll(int& outValue)
+	{
+		bool found = false;
+
+		for (auto& slot : m_Slots)
+		{
+			if (!slot.Fence)
+				continue;
+
+			GLenum status = glClientWaitSync((GLsync)slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				continue;
+
+			glDeleteSync((GLsync)slot.Fence);
+			slot.Fence = nullptr;
+
+			if (slot.Sequence <= m_LastReturnedSequence)
+				continue;
+
+			glGetNamedBufferSubData(slot.BufferID, 0, sizeof(int), &outValue);
+			m_LastReturnedSequence = slot.Sequence;
+			found = true;
+		}
+
+		return found;
+	}
+
+	bool OpenGLPixelReadback::IsPending() const
+	{
+		for (const auto& slot : m_Slots)
+		{
+			if (slot.Fence)
+				return true;
+		}
+		return false;
+	}
+
+}
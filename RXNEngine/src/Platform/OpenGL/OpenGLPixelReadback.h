@@ -0,0 +1,32 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/PixelReadback.h"
+
+#include <array>
+
+namespace RXNEngine {
+
+	class OpenGLPixelReadback : public PixelReadback
+	{
+	public:
+		OpenGLPixelReadback();
+		virtual ~OpenGLPixelReadback();
+
+		virtual void Request(uint32_t attachmentIndex, int x, int y) override;
+		virtual bool Poll(int& outValue) override;
+		virtual bool IsPending() const override;
+	private:
+		struct ReadbackSlot
+		{
+			uint32_t BufferID = 0;
+			void* Fence = nullptr;
+			uint64_t Sequence = 0;
+		};
+
+		std::array<ReadbackSlot, 3> m_Slots;
+		uint32_t m_NextSlot = 0;
+		uint64_t m_Sequence = 0;
+		uint64_t m_LastReturnedSequence = 0;
+	};
+
+}
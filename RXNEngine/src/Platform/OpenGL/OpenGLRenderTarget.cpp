@@ -81,6 +81,7 @@ namespace RXNEngine {
 				case RenderTargetTextureFormat::RGBA8:       return GL_RGBA8;
 				case RenderTargetTextureFormat::RGBA16F:     return GL_RGBA16F;
 				case RenderTargetTextureFormat::RGBA32F:     return GL_RGBA32F;
+				case RenderTargetTextureFormat::R16F:        return GL_R16F;
 				case RenderTargetTextureFormat::RED_INTEGER: return GL_RED_INTEGER;
 			}
 
@@ -226,4 +227,18 @@ namespace RXNEngine {
 			Utils::TextureFormatToOpenGL(spec.TextureFormat), GL_INT, &value);
 	}
 
+	void OpenGLRenderTarget::CopyDepthTo(const Ref<RenderTarget>& destination)
+	{
+		RXN_CORE_ASSERT(m_DepthAttachment, "Render target has no depth attachment!");
+
+		uint32_t destinationID = std::static_pointer_cast<OpenGLRenderTarget>(destination)->m_RendererID;
+		const auto& destinationSpec = destination->GetSpecification();
+		RXN_CORE_ASSERT(destinationSpec.Width == m_Specification.Width && destinationSpec.Height == m_Specification.Height, "Depth can only be copied between targets of the same size!");
+
+		glBlitNamedFramebuffer(m_RendererID, destinationID,
+			0, 0, m_Specification.Width, m_Specification.Height,
+			0, 0, destinationSpec.Width, destinationSpec.Height,
+			GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+	}
+
 }
\ No newline at end of file
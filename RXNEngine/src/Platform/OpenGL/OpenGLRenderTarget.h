@@ -18,6 +18,8 @@ namespace RXNEngine {
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
 
+		virtual void CopyDepthTo(const Ref<RenderTarget>& destination) override;
+
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { RXN_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
 
 		virtual const RenderTargetSpecification& GetSpecification() const override { return m_Specification; }
@@ -283,6 +283,14 @@ namespace RXNEngine {
 		glLineWidth(width);
 	}
 
-}
+	void OpenGLRendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		glDispatchCompute(groupsX, groupsY, groupsZ);
+	}
 
+	void OpenGLRendererAPI::ComputeBarrier()
+	{
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+	}
 
+}
\ No newline at end of file
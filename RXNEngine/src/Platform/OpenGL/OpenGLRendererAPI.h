@@ -42,6 +42,9 @@ namespace RXNEngine {
 		virtual void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
 
 		void SetLineWidth(float width) override;
+
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+		virtual void ComputeBarrier() override;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "rxnpch.h"
+#include "OpenGLStorageBuffer.h"
+
+#include <glad/glad.h>
+
+namespace RXNEngine {
+
+	OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size, uint32_t binding)
+	{
+		std::vector<uint8_t> zeros(size, 0);
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, zeros.data(), GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+}
\ No newline at end of file
@@ -1,7 +1,13 @@
 #include "rxnpch.h"
 #include "OpenGLTexture.h"
 
-#include <stb_image.h>
+// S3TC is an extension glad wasn't generated with, every desktop driver exposes it
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
 
 namespace RXNEngine {
 
@@ -11,8 +17,9 @@ namespace RXNEngine {
 		{
 			switch (format)
 			{
-				case ImageFormat::RGB8:  return GL_RGB;
-				case ImageFormat::RGBA8: return GL_RGBA;
+				case ImageFormat::RGB8:    return GL_RGB;
+				case ImageFormat::RGBA8:   return GL_RGBA;
+				case ImageFormat::RGBA16F: return GL_RGBA;
 			}
 
 			RXN_CORE_ASSERT(false);
@@ -23,8 +30,22 @@ namespace RXNEngine {
 		{
 			switch (format)
 			{
-				case ImageFormat::RGB8:  return GL_RGB8;
-				case ImageFormat::RGBA8: return GL_RGBA8;
+				case ImageFormat::RGB8:    return GL_RGB8;
+				case ImageFormat::RGBA8:   return GL_RGBA8;
+				case ImageFormat::RGBA16F: return GL_RGBA16F;
+			}
+
+			RXN_CORE_ASSERT(false);
+			return 0;
+		}
+
+		static GLenum TextureCompressionToGLInternalFormat(TextureCompression compression)
+		{
+			switch (compression)
+			{
+				case TextureCompression::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+				case TextureCompression::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+				case TextureCompression::BC5: return GL_COMPRESSED_RG_RGTC2;
 			}
 
 			RXN_CORE_ASSERT(false);
@@ -39,135 +60,200 @@ namespace RXNEngine {
 		m_InternalFormat = Utils::ImageFormatToGLInternalFormat(m_Specification.Format);
 		m_DataFormat = Utils::ImageFormatToGLDataFormat(m_Specification.Format);
 
+		m_MipCount = m_Specification.MipLevels ? m_Specification.MipLevels : (uint32_t)std::floor(std::log2(std::max(m_Width, m_Height))) + 1;
+
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		glTextureStorage2D(m_RendererID, m_MipCount, m_InternalFormat, m_Width, m_Height);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		GLenum wrap = m_Specification.ClampToEdge ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, wrap);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, wrap);
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, bool loadImmediately)
 		: m_Path(path)
 	{
-		int width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
+		if (!loadImmediately)
+			return;
 
-		if (stbi_is_hdr(path.c_str()))
-		{
-			float* data = stbi_loadf(path.c_str(), &width, &height, &channels, 0);
-			if (data)
-			{
-				m_IsLoaded = true;
-				m_Width = width;
-				m_Height = height;
+		TextureImage image;
+		if (TextureImage::Decode(path, image))
+			UploadImage(image, 0, image.Height);
+	}
+
+	OpenGLTexture2D::OpenGLTexture2D(const void* data, size_t size)
+	{
+		TextureImage image;
+		if (TextureImage::Decode(data, size, image))
+			UploadImage(image, 0, image.Height);
+		else
+			RXN_CORE_ERROR("Failed to load texture from memory!");
+	}
 
-				m_InternalFormat = GL_RGB16F;
-				m_DataFormat = GL_RGB;
+	OpenGLTexture2D::~OpenGLTexture2D()
+	{
+		glDeleteTextures(1, &m_RendererID);
+	}
 
-				glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-				glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+	void OpenGLTexture2D::UploadImage(const TextureImage& image, uint32_t firstRow, uint32_t rowCount)
+	{
+		uint32_t baseWidth = image.GetMipWidth(image.FirstMip);
+		uint32_t baseHeight = image.GetMipHeight(image.FirstMip);
 
-				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		RXN_CORE_ASSERT(image.IsValid(), "Uploading an empty image!");
+		RXN_CORE_ASSERT(firstRow < baseHeight && firstRow % image.GetRowAlignment() == 0);
 
-				glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_FLOAT, data);
+		if (firstRow == 0)
+			AllocateStorage(image);
 
-				glGenerateTextureMipmap(m_RendererID);
+		rowCount = std::min(rowCount, baseHeight - firstRow);
 
-				stbi_image_free(data);
-			}
+		if (image.IsCompressed())
+		{
+			uint32_t blockRowSize = (baseWidth + 3) / 4 * TextureImage::GetBlockSize(image.Compression);
+			uint32_t blockRowCount = (rowCount + 3) / 4;
+			const uint8_t* blocks = image.CompressedData.data() + (uint64_t)(firstRow / 4) * blockRowSize;
+
+			glCompressedTextureSubImage2D(m_RendererID, 0, 0, firstRow, baseWidth, rowCount, m_InternalFormat,
+				blockRowSize * blockRowCount, blocks);
 		}
 		else
 		{
-			stbi_uc* data = nullptr;
-			data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+			const uint8_t* pixels = (const uint8_t*)image.Pixels + (uint64_t)firstRow * image.GetRowSize();
 
-			if (data)
-			{
-				m_IsLoaded = true;
+			// RGB rows aren't 4 byte aligned for most widths
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glTextureSubImage2D(m_RendererID, 0, 0, firstRow, baseWidth, rowCount, m_DataFormat, image.HDR ? GL_FLOAT : GL_UNSIGNED_BYTE, pixels);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
 
-				m_Width = width;
-				m_Height = height;
+		if (firstRow + rowCount < baseHeight)
+			return;
 
-				GLenum internalFormat = GL_RGBA8, dataFormat = GL_RGBA;
+		if (image.IsCompressed())
+		{
+			// The cooker already built the mip chain, the driver can't generate mips for block formats
+			for (uint32_t level = image.FirstMip + 1; level < image.MipCount; level++)
+			{
+				glCompressedTextureSubImage2D(m_RendererID, level - m_BaseMip, 0, 0, image.GetMipWidth(level), image.GetMipHeight(level), m_InternalFormat,
+					image.GetMipSize(level), image.CompressedData.data() + image.GetMipOffset(level));
+			}
+		}
+		else
+		{
+			glGenerateTextureMipmap(m_RendererID);
+		}
 
-				m_InternalFormat = internalFormat;
-				m_DataFormat = dataFormat;
+		m_IsLoaded = true;
+	}
 
-				glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-				glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+	void OpenGLTexture2D::SetBaseMip(uint32_t baseMip, const TextureImage& image)
+	{
+		RXN_CORE_ASSERT(m_IsLoaded && baseMip < m_MipCount);
 
-				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		if (baseMip == m_BaseMip)
+			return;
 
-				GLfloat maxAnisotropy;
-				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
-				glTextureParameterf(m_RendererID, GL_TEXTURE_MAX_ANISOTROPY, maxAnisotropy);
+		RXN_CORE_ASSERT(baseMip > m_BaseMip || (image.IsCompressed() && image.FirstMip <= baseMip), "Streamed in mips are missing!");
 
-				glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
-				glGenerateTextureMipmap(m_RendererID);
+		// Immutable storage can't grow, the new chain gets its own texture and the levels that stay resident are copied over on the GPU
+		uint32_t rendererID;
+		glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+		glTextureStorage2D(rendererID, m_MipCount - baseMip, m_InternalFormat, GetMipWidth(baseMip), GetMipHeight(baseMip));
+		SetSamplerParameters(rendererID, false);
 
-				stbi_image_free(data);
-			}
+		for (uint32_t level = std::max(baseMip, m_BaseMip); level < m_MipCount; level++)
+		{
+			glCopyImageSubData(m_RendererID, GL_TEXTURE_2D, level - m_BaseMip, 0, 0, 0,
+				rendererID, GL_TEXTURE_2D, level - baseMip, 0, 0, 0, GetMipWidth(level), GetMipHeight(level), 1);
 		}
+
+		for (uint32_t level = baseMip; level < m_BaseMip; level++)
+		{
+			glCompressedTextureSubImage2D(rendererID, level - baseMip, 0, 0, GetMipWidth(level), GetMipHeight(level), m_InternalFormat,
+				image.GetMipSize(level), image.CompressedData.data() + image.GetMipOffset(level));
+		}
+
+		glDeleteTextures(1, &m_RendererID);
+		m_RendererID = rendererID;
+		m_BaseMip = baseMip;
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(const void* data, size_t size)
+	void OpenGLTexture2D::AllocateStorage(const TextureImage& image)
 	{
-		int width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
+		if (m_RendererID)
+			glDeleteTextures(1, &m_RendererID);
 
-		stbi_uc* imageData = stbi_load_from_memory((const stbi_uc*)data, (int)size, &width, &height, &channels, 0);
+		m_IsLoaded = false;
+		m_Width = image.Width;
+		m_Height = image.Height;
+		m_Specification.Width = m_Width;
+		m_Specification.Height = m_Height;
+		m_Specification.GenerateMips = true;
 
-		if (imageData)
+		if (image.IsCompressed())
 		{
-			m_IsLoaded = true;
-			m_Width = width;
-			m_Height = height;
+			m_Specification.Format = ImageFormat::RGBA8;
+			m_InternalFormat = Utils::TextureCompressionToGLInternalFormat(image.Compression);
+			m_DataFormat = GL_RGBA;
+		}
+		else if (image.HDR)
+		{
+			m_InternalFormat = GL_RGB16F;
+			m_DataFormat = GL_RGB;
+		}
+		else
+		{
+			m_Specification.Format = image.Channels == 3 ? ImageFormat::RGB8 : ImageFormat::RGBA8;
+			m_InternalFormat = Utils::ImageFormatToGLInternalFormat(m_Specification.Format);
+			m_DataFormat = Utils::ImageFormatToGLDataFormat(m_Specification.Format);
+		}
 
-			GLenum internalFormat = 0, dataFormat = 0;
-			if (channels == 4)
-			{
-				internalFormat = GL_RGBA8;
-				dataFormat = GL_RGBA;
-			}
-			else if (channels == 3)
-			{
-				internalFormat = GL_RGB8;
-				dataFormat = GL_RGB;
-			}
+		m_MipCount = image.IsCompressed() ? image.MipCount : (uint32_t)std::floor(std::log2(std::max(m_Width, m_Height))) + 1;
+		m_BaseMip = image.FirstMip;
 
-			m_InternalFormat = internalFormat;
-			m_DataFormat = dataFormat;
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+		glTextureStorage2D(m_RendererID, m_MipCount - m_BaseMip, m_InternalFormat, GetMipWidth(m_BaseMip), GetMipHeight(m_BaseMip));
+		SetSamplerParameters(m_RendererID, image.HDR);
+	}
 
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-			glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+	void OpenGLTexture2D::BindImage(uint32_t unit, uint32_t mip, ImageAccess access) const
+	{
+		RXN_CORE_ASSERT(mip < m_MipCount, "Binding a mip the texture doesn't have!");
 
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		GLenum glAccess = GL_READ_WRITE;
+		switch (access)
+		{
+			case ImageAccess::ReadOnly:  glAccess = GL_READ_ONLY; break;
+			case ImageAccess::WriteOnly: glAccess = GL_WRITE_ONLY; break;
+			case ImageAccess::ReadWrite: glAccess = GL_READ_WRITE; break;
+		}
+
+		glBindImageTexture(unit, m_RendererID, mip - m_BaseMip, GL_FALSE, 0, glAccess, m_InternalFormat);
+	}
 
-			glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, imageData);
+	void OpenGLTexture2D::SetSamplerParameters(uint32_t rendererID, bool clampToEdge)
+	{
+		glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-			stbi_image_free(imageData);
+		if (clampToEdge)
+		{
+			glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		}
 		else
 		{
-			RXN_CORE_ERROR("Failed to load texture from memory!");
-		}
-	}
+			glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	OpenGLTexture2D::~OpenGLTexture2D()
-	{
-		glDeleteTextures(1, &m_RendererID);
+			GLfloat maxAnisotropy;
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+			glTextureParameterf(rendererID, GL_TEXTURE_MAX_ANISOTROPY, maxAnisotropy);
+		}
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
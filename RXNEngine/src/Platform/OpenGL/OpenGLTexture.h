@@ -10,7 +10,7 @@ namespace RXNEngine {
 	{
 	public:
 		OpenGLTexture2D(const TextureSpecification& specification);
-		OpenGLTexture2D(const std::string& path);
+		OpenGLTexture2D(const std::string& path, bool loadImmediately = true);
 		OpenGLTexture2D(const void* data, size_t size);
 		virtual ~OpenGLTexture2D();
 
@@ -26,19 +26,34 @@ namespace RXNEngine {
 
 		virtual void Bind(uint32_t slot = 0) const override;
 
+		virtual void UploadImage(const TextureImage& image, uint32_t firstRow, uint32_t rowCount) override;
+
+		virtual uint32_t GetMipCount() const override { return m_MipCount; }
+		virtual uint32_t GetBaseMip() const override { return m_BaseMip; }
+		virtual void SetBaseMip(uint32_t baseMip, const TextureImage& image) override;
+
+		virtual void BindImage(uint32_t unit, uint32_t mip, ImageAccess access) const override;
+
 		virtual bool IsLoaded() const override { return m_IsLoaded; }
 
 		virtual bool operator==(const Texture& other) const override
 		{
 			return m_RendererID == other.GetRendererID();
 		}
+	private:
+		void AllocateStorage(const TextureImage& image);
+		static void SetSamplerParameters(uint32_t rendererID, bool clampToEdge);
+
+		uint32_t GetMipWidth(uint32_t level) const { return std::max(m_Width >> level, 1u); }
+		uint32_t GetMipHeight(uint32_t level) const { return std::max(m_Height >> level, 1u); }
 	private:
 		TextureSpecification m_Specification;
 
 		std::string m_Path;
 		bool m_IsLoaded = false;
-		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
-		GLenum m_InternalFormat, m_DataFormat;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_MipCount = 1, m_BaseMip = 0;
+		uint32_t m_RendererID = 0;
+		GLenum m_InternalFormat = 0, m_DataFormat = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "rxnpch.h"
+#include "OpenGLTimerQuery.h"
+
+#include <glad/glad.h>
+
+namespace RXNEngine {
+
+	OpenGLTimerQuery::OpenGLTimerQuery()
+	{
+		glCreateQueries(GL_TIMESTAMP, 2, m_QueryIDs);
+	}
+
+	OpenGLTimerQuery::~OpenGLTimerQuery()
+	{
+		glDeleteQueries(2, m_QueryIDs);
+	}
+
+	void OpenGLTimerQuery::Begin()
+	{
+		glQueryCounter(m_QueryIDs[0], GL_TIMESTAMP);
+	}
+
+	void OpenGLTimerQuery::End()
+	{
+		glQueryCounter(m_QueryIDs[1], GL_TIMESTAMP);
+	}
+
+	bool OpenGLTimerQuery::IsResultAvailable() const
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(m_QueryIDs[1], GL_QUERY_RESULT_AVAILABLE, &available);
+		return available != 0;
+	}
+
+	uint64_t OpenGLTimerQuery::GetElapsedTime() const
+	{
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(m_QueryIDs[0], GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(m_QueryIDs[1], GL_QUERY_RESULT, &end);
+		return end > begin ? end - begin : 0;
+	}
+
+}
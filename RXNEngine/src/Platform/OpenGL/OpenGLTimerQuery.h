@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/TimerQuery.h"
+
+namespace RXNEngine {
+
+	class OpenGLTimerQuery : public TimerQuery
+	{
+	public:
+		OpenGLTimerQuery();
+		virtual ~OpenGLTimerQuery();
+
+		virtual void Begin() override;
+		virtual void End() override;
+
+		virtual bool IsResultAvailable() const override;
+		virtual uint64_t GetElapsedTime() const override;
+	private:
+		// Timestamp pairs rather than GL_TIME_ELAPSED, which can't be nested
+		uint32_t m_QueryIDs[2] = { 0, 0 };
+	};
+
+}
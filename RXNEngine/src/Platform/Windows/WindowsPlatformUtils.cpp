@@ -57,4 +57,42 @@ namespace RXNEngine {
 		return std::string();
 	}
 
+	MappedFile::MappedFile(const std::string& filepath)
+	{
+		// Share delete so a cache can be replaced on disk while an older version is still mapped
+		HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		m_Data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		m_Size = m_Data ? (uint64_t)size.QuadPart : 0;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_Data)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle)
+			CloseHandle(m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle(m_FileHandle);
+	}
+
 }
\ No newline at end of file
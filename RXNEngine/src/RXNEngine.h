@@ -16,6 +16,7 @@
 #include "RXNEngine/Renderer/SceneRenderer.h"
 #include "RXNEngine/Renderer/RenderCommand.h"
 #include "RXNEngine/Renderer/RenderTarget.h"
+#include "RXNEngine/Renderer/GPUProfiler.h"
 
 #include "RXNEngine/Renderer/GraphicsAPI/Buffer.h"
 #include "RXNEngine/Renderer/GraphicsAPI/Shader.h"
@@ -27,6 +28,7 @@
 #include "RXNEngine/Renderer/GraphicsAPI/Texture.h"
 
 #include "RXNEngine/Asset/AssetManager.h"
+#include "RXNEngine/Asset/TextureStreamer.h"
 
 #include "RXNEngine/Scene/Components.h"
 #include "RXNEngine/Scene/Scene.h"
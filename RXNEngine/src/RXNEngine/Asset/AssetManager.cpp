@@ -1,14 +1,25 @@
 #include "rxnpch.h"
 #include "AssetManager.h"
 
+#include "RXNEngine/Asset/TextureStreamer.h"
 #include "RXNEngine/Core/JobSystem.h"
 #include "RXNEngine/Scripting/ScriptEngine.h"
 
+#include <chrono>
+
 namespace RXNEngine {
 
     std::mutex AssetManager::s_AsyncMutex;
     std::vector<AssetManager::AsyncLoadTask*> AssetManager::s_FinishedTasks;
 
+    std::mutex AssetManager::s_TextureMutex;
+    std::vector<AssetManager::TextureLoadTask*> AssetManager::s_DecodedTextures;
+    std::atomic<uint32_t> AssetManager::s_PendingTextureDecodes = 0;
+    float AssetManager::s_TextureUploadBudget = 4.0f;
+
+    // Large images are uploaded in bands of rows so a single 4K texture doesn't blow the frame budget
+    static constexpr uint32_t s_TextureUploadChunkSize = 4 * 1024 * 1024;
+
     std::unordered_map<std::string, Ref<StaticMesh>> AssetManager::s_Meshes;
     std::unordered_map<std::string, Ref<Shader>> AssetManager::s_Shaders;
     std::unordered_map<std::string, Ref<Texture2D>> AssetManager::m_Textures;
@@ -67,19 +78,104 @@ namespace RXNEngine {
         return newMesh;
     }
 
-    Ref<Texture2D> AssetManager::GetTexture(const std::string& path)
+    Ref<Texture2D> AssetManager::GetTexture(const std::string& path, TextureUsage usage)
     {
         if (m_Textures.find(path) != m_Textures.end())
             return m_Textures[path];
 
-        Ref<Texture2D> newTexture = Texture2D::Create(path);
+        Ref<Texture2D> newTexture = Texture2D::CreatePending(path);
+
+        if (!newTexture)
+            return nullptr;
+
+        m_Textures[path] = newTexture;
 
-        if (newTexture)
-            m_Textures[path] = newTexture;
+        s_PendingTextureDecodes++;
+        JobSystem::ExecuteBackground([newTexture, path, usage]()
+            {
+                OPTICK_EVENT("AssetManager::DecodeTexture");
+
+                TextureLoadTask* task = new TextureLoadTask();
+                task->Texture = newTexture;
+                TextureCooker::Load(path, usage, task->Image, TextureStreamer::IsEnabled() ? TextureStreamer::GetInitialResidentSize() : 0);
+
+                std::lock_guard<std::mutex> lock(s_TextureMutex);
+                s_DecodedTextures.push_back(task);
+                s_PendingTextureDecodes--;
+            });
 
         return newTexture;
     }
 
+    TextureLoadStatistics AssetManager::GetTextureLoadStats()
+    {
+        TextureLoadStatistics stats;
+        stats.PendingDecodes = s_PendingTextureDecodes.load();
+
+        std::lock_guard<std::mutex> lock(s_TextureMutex);
+        stats.PendingUploads = (uint32_t)s_DecodedTextures.size();
+        for (const TextureLoadTask* task : s_DecodedTextures)
+            stats.PendingUploadBytes += task->Image.GetSize() - (uint64_t)task->UploadedRows * task->Image.GetRowSize();
+
+        return stats;
+    }
+
+    void AssetManager::UploadPendingTextures()
+    {
+        OPTICK_EVENT();
+
+        auto start = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            TextureLoadTask* task = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(s_TextureMutex);
+                if (s_DecodedTextures.empty())
+                    break;
+
+                task = s_DecodedTextures.front();
+            }
+
+            const TextureImage& image = task->Image;
+            bool finished = true;
+
+            if (image.IsValid())
+            {
+                uint32_t height = image.GetMipHeight(image.FirstMip);
+                uint32_t alignment = image.GetRowAlignment();
+                uint32_t rowCount = std::max(1u, s_TextureUploadChunkSize / image.GetRowSize());
+                rowCount = (rowCount + alignment - 1) / alignment * alignment;
+                rowCount = std::min(rowCount, height - task->UploadedRows);
+
+                task->Texture->UploadImage(image, task->UploadedRows, rowCount);
+                task->UploadedRows += rowCount;
+
+                finished = task->UploadedRows == height;
+
+                if (finished && image.IsCompressed())
+                    TextureStreamer::Register(task->Texture, TextureCooker::GetCachePath(task->Texture->GetPath()), image);
+            }
+            else
+            {
+                RXN_CORE_ERROR("Failed to load texture: {0}", task->Texture->GetPath());
+            }
+
+            if (finished)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(s_TextureMutex);
+                    s_DecodedTextures.erase(s_DecodedTextures.begin());
+                }
+                delete task;
+            }
+
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= s_TextureUploadBudget)
+                break;
+        }
+    }
+
     void AssetManager::Clear()
     {
         s_Meshes.clear();
@@ -94,7 +190,7 @@ namespace RXNEngine {
             return;
         }
 
-        JobSystem::Execute([path, entityID]()
+        JobSystem::ExecuteBackground([path, entityID]()
             {
                 AsyncLoadTask* task = new AsyncLoadTask();
                 task->EntityID = entityID;
@@ -114,6 +210,9 @@ namespace RXNEngine {
 
     void AssetManager::Update()
     {
+        UploadPendingTextures();
+        TextureStreamer::Update();
+
         std::lock_guard<std::mutex> lock(s_AsyncMutex);
         if (s_FinishedTasks.empty()) return;
 
@@ -1,18 +1,30 @@
 #pragma once
 #include "RXNEngine/Asset/StaticMesh.h"
 #include "RXNEngine/Renderer/GraphicsAPI/Shader.h"
+#include "RXNEngine/Renderer/GraphicsAPI/Texture.h"
 #include "RXNEngine/Asset/ModelImporter.h"
+#include "RXNEngine/Asset/TextureCooker.h"
 
 #include <unordered_map>
 #include <string>
+#include <atomic>
 
 namespace RXNEngine {
 
+    struct TextureLoadStatistics
+    {
+        uint32_t PendingDecodes = 0;
+        uint32_t PendingUploads = 0;
+        uint64_t PendingUploadBytes = 0;
+    };
+
     class AssetManager
     {
     public:
         static Ref<StaticMesh> GetMesh(const std::string& path);
-        static Ref<Texture2D> GetTexture(const std::string& path);
+        // Cooks/decodes on a worker and uploads during Update(), the texture reports !IsLoaded() until then.
+        // The usage of the first request decides the compression format
+        static Ref<Texture2D> GetTexture(const std::string& path, TextureUsage usage = TextureUsage::Color);
         static Ref<Shader> GetShader(const std::string& path);
 
         static void Clear();
@@ -20,6 +32,13 @@ namespace RXNEngine {
         static void LoadMeshAsync(const std::string& path, uint64_t entityID);
         static void Update();
 
+        static void SetTextureUploadBudget(float milliseconds) { s_TextureUploadBudget = milliseconds; }
+        static float GetTextureUploadBudget() { return s_TextureUploadBudget; }
+        static TextureLoadStatistics GetTextureLoadStats();
+
+    private:
+        static void UploadPendingTextures();
+
     private:
         struct AsyncLoadTask {
             uint64_t EntityID;
@@ -27,9 +46,20 @@ namespace RXNEngine {
             ImporterData Data;
         };
 
+        struct TextureLoadTask {
+            Ref<Texture2D> Texture;
+            TextureImage Image;
+            uint32_t UploadedRows = 0;
+        };
+
         static std::mutex s_AsyncMutex;
         static std::vector<AsyncLoadTask*> s_FinishedTasks;
 
+        static std::mutex s_TextureMutex;
+        static std::vector<TextureLoadTask*> s_DecodedTextures;
+        static std::atomic<uint32_t> s_PendingTextureDecodes;
+        static float s_TextureUploadBudget;
+
         static std::unordered_map<std::string, Ref<StaticMesh>> s_Meshes;
         static std::unordered_map<std::string, Ref<Shader>> s_Shaders;
         static std::unordered_map<std::string, Ref<Texture2D>> m_Textures;
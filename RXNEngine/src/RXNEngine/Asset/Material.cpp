@@ -19,8 +19,9 @@ namespace RXNEngine {
         m_Shader->SetFloat("u_AO", m_Parameters.AO);
         m_Shader->SetFloat("u_Tiling", m_Parameters.Tiling);
 
+        // Textures still streaming in fall back to the same defaults as missing ones
         // Slot 0: Albedo
-        if (m_AlbedoMap)
+        if (m_AlbedoMap && m_AlbedoMap->IsLoaded())
         {
             m_AlbedoMap->Bind(0);
             m_Shader->SetInt("u_UseAlbedoMap", 1);
@@ -33,7 +34,7 @@ namespace RXNEngine {
         m_Shader->SetInt("u_AlbedoMap", 0);
 
         // Slot 1: Normal
-        if (m_NormalMap)
+        if (m_NormalMap && m_NormalMap->IsLoaded())
         {
             m_NormalMap->Bind(1);
             m_Shader->SetInt("u_UseNormalMap", 1);
@@ -46,7 +47,7 @@ namespace RXNEngine {
         m_Shader->SetInt("u_NormalMap", 1);
 
         // Slot 2: Metal/Rough (Often packed)
-        if (m_MetalnessRoughnessMap) 
+        if (m_MetalnessRoughnessMap && m_MetalnessRoughnessMap->IsLoaded()) 
         { 
             m_MetalnessRoughnessMap->Bind(2);
             m_Shader->SetInt("u_MetallicMap", 2);
@@ -61,7 +62,7 @@ namespace RXNEngine {
         m_Shader->SetInt("u_MetalnessRoughnessMap", 2);
 
         // Slot 3: Ambient Occlusion (AO)
-        if (m_AOMap)
+        if (m_AOMap && m_AOMap->IsLoaded())
         { 
             m_AOMap->Bind(3);
             m_Shader->SetInt("u_UseAOMap", 1);
@@ -74,7 +75,7 @@ namespace RXNEngine {
         m_Shader->SetInt("u_AOMap", 3);
 
         // Slot 4: Emissive
-        if (m_EmissiveMap)
+        if (m_EmissiveMap && m_EmissiveMap->IsLoaded())
         { 
             m_EmissiveMap->Bind(4);
             m_Shader->SetInt("u_UseEmissiveMap", 1);
@@ -43,6 +43,7 @@ namespace RXNEngine {
 		Ref<Texture2D> GetNormalMap() const { return m_NormalMap; }
 		Ref<Texture2D> GetMetalnessRoughnessMap() const { return m_MetalnessRoughnessMap; }
 		Ref<Texture2D> GetAOMap() const { return m_AOMap; }
+		Ref<Texture2D> GetEmissiveMap() const { return m_EmissiveMap; }
 
 		Ref<Shader> GetShader() const { return m_Shader; }
 
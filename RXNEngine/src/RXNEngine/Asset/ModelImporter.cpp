@@ -329,7 +329,7 @@ namespace RXNEngine {
 				rxnMat->SetAlbedoMap(AssetManager::GetTexture(desc.AlbedoPath));
 
 			if (!desc.NormalPath.empty())
-				rxnMat->SetNormalMap(AssetManager::GetTexture(desc.NormalPath));
+				rxnMat->SetNormalMap(AssetManager::GetTexture(desc.NormalPath, TextureUsage::NormalMap));
 
 			if (!desc.MetalRoughPath.empty())
 				rxnMat->SetMetalnessRoughnessMap(AssetManager::GetTexture(desc.MetalRoughPath));
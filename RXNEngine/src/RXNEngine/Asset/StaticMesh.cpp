@@ -7,10 +7,30 @@ namespace RXNEngine {
 	StaticMesh::StaticMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
 		const std::vector<Submesh>& submeshes, const std::vector<Ref<Material>>& materials)
 		: m_Submeshes(submeshes), m_Materials(materials), m_Vertices(vertices), m_Indices(indices)
+	{
+		m_VertexView = m_Vertices;
+		m_IndexView = m_Indices;
+
+		std::vector<glm::vec3> positions(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++)
+			positions[i] = vertices[i].Position;
+
+		CreateBuffers(m_VertexView, positions, m_IndexView);
+	}
+
+	StaticMesh::StaticMesh(const Ref<MappedFile>& mapping, std::span<const Vertex> vertices, std::span<const glm::vec3> positions,
+		std::span<const uint32_t> indices, const std::vector<Submesh>& submeshes, const std::vector<Ref<Material>>& materials)
+		: m_Submeshes(submeshes), m_Materials(materials), m_Mapping(mapping), m_VertexView(vertices), m_IndexView(indices)
+	{
+		RXN_CORE_ASSERT(positions.size() == vertices.size(), "Position stream doesn't match the vertex count!");
+		CreateBuffers(vertices, positions, indices);
+	}
+
+	void StaticMesh::CreateBuffers(std::span<const Vertex> vertices, std::span<const glm::vec3> positions, std::span<const uint32_t> indices)
 	{
 		m_VAO = VertexArray::Create();
 
-		Ref<VertexBuffer> vbo = VertexBuffer::Create((float*)vertices.data(), vertices.size() * sizeof(Vertex));
+		Ref<VertexBuffer> vbo = VertexBuffer::Create((float*)vertices.data(), (uint32_t)vertices.size_bytes());
 		vbo->SetLayout({
 			{ ShaderDataType::Float3, "a_Position" },
 			{ ShaderDataType::Float3, "a_Normal" },
@@ -18,8 +38,75 @@ namespace RXNEngine {
 			});
 		m_VAO->AddVertexBuffer(vbo);
 
-		Ref<IndexBuffer> ibo = IndexBuffer::Create((uint32_t*)indices.data(), indices.size());
+		Ref<IndexBuffer> ibo = IndexBuffer::Create((uint32_t*)indices.data(), (uint32_t)indices.size());
 		m_VAO->SetIndexBuffer(ibo);
+
+		m_PositionVAO = VertexArray::Create();
+
+		Ref<VertexBuffer> positionVBO = VertexBuffer::Create((float*)positions.data(), (uint32_t)positions.size_bytes());
+		positionVBO->SetLayout({
+			{ ShaderDataType::Float3, "a_Position" }
+			});
+		m_PositionVAO->AddVertexBuffer(positionVBO);
+		m_PositionVAO->SetIndexBuffer(ibo);
+	}
+
+	const BVH& StaticMesh::GetSubmeshBVH(uint32_t submeshIndex) const
+	{
+		RXN_CORE_ASSERT(submeshIndex < m_Submeshes.size(), "Submesh index out of range!");
+
+		std::lock_guard<std::mutex> lock(m_BVHMutex);
+
+		if (m_SubmeshBVHs.empty())
+			m_SubmeshBVHs.resize(m_Submeshes.size());
+
+		Scope<BVH>& bvh = m_SubmeshBVHs[submeshIndex];
+		if (!bvh)
+		{
+			const Submesh& submesh = m_Submeshes[submeshIndex];
+			uint32_t triangleCount = submesh.IndexCount / 3;
+
+			std::vector<AABB> triangleBounds(triangleCount);
+			for (uint32_t i = 0; i < triangleCount; i++)
+			{
+				uint32_t base = submesh.BaseIndex + i * 3;
+				const glm::vec3& v0 = m_VertexView[m_IndexView[base + 0]].Position;
+				const glm::vec3& v1 = m_VertexView[m_IndexView[base + 1]].Position;
+				const glm::vec3& v2 = m_VertexView[m_IndexView[base + 2]].Position;
+
+				triangleBounds[i].Min = glm::min(v0, glm::min(v1, v2));
+				triangleBounds[i].Max = glm::max(v0, glm::max(v1, v2));
+			}
+
+			bvh = CreateScope<BVH>();
+			bvh->Build(triangleBounds);
+		}
+
+		return *bvh;
+	}
+
+	bool StaticMesh::Raycast(const Ray& ray, uint32_t submeshIndex, float& closestT) const
+	{
+		OPTICK_EVENT();
+
+		const BVH& bvh = GetSubmeshBVH(submeshIndex);
+		const Submesh& submesh = m_Submeshes[submeshIndex];
+
+		return bvh.Raycast(ray, closestT, [&](uint32_t triangle, float& closest)
+			{
+				uint32_t base = submesh.BaseIndex + triangle * 3;
+				const glm::vec3& v0 = m_VertexView[m_IndexView[base + 0]].Position;
+				const glm::vec3& v1 = m_VertexView[m_IndexView[base + 1]].Position;
+				const glm::vec3& v2 = m_VertexView[m_IndexView[base + 2]].Position;
+
+				float t;
+				if (Math::IntersectRayTriangle(ray, v0, v1, v2, t) && t < closest)
+				{
+					closest = t;
+					return true;
+				}
+				return false;
+			});
 	}
 
 }
\ No newline at end of file
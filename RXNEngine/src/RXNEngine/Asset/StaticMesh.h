@@ -3,9 +3,13 @@
 #include "RXNEngine/Renderer/GraphicsAPI/VertexArray.h"
 #include "RXNEngine/Asset/Material.h"
 #include "RXNEngine/Math/Math.h"
+#include "RXNEngine/Math/BVH.h"
+#include "RXNEngine/Utils/PlatformUtils.h"
 
 #include <vector>
 #include <string>
+#include <span>
+#include <mutex>
 
 namespace RXNEngine {
 
@@ -33,20 +37,41 @@ namespace RXNEngine {
 	public:
 		StaticMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
 			const std::vector<Submesh>& submeshes, const std::vector<Ref<Material>>& materials);
+		// Uploads straight from a mapped cache file and keeps the mapping alive as the CPU copy, nothing is copied
+		StaticMesh(const Ref<MappedFile>& mapping, std::span<const Vertex> vertices, std::span<const glm::vec3> positions,
+			std::span<const uint32_t> indices, const std::vector<Submesh>& submeshes, const std::vector<Ref<Material>>& materials);
 		~StaticMesh() = default;
 
 		Ref<VertexArray> GetVertexArray() const { return m_VAO; }
+		// Positions only, shares the index buffer. Depth-only passes fetch a third of the vertex data through it
+		Ref<VertexArray> GetPositionVertexArray() const { return m_PositionVAO; }
 		const std::vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
 		const std::vector<Ref<Material>>& GetMaterials() const { return m_Materials; }
-		const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
-		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+		std::span<const Vertex> GetVertices() const { return m_VertexView; }
+		std::span<const uint32_t> GetIndices() const { return m_IndexView; }
+
+		// Triangle BVH in mesh space, built on first use
+		const BVH& GetSubmeshBVH(uint32_t submeshIndex) const;
+
+		// Ray must be in mesh space, closestT is lowered on a hit closer than its current value
+		bool Raycast(const Ray& ray, uint32_t submeshIndex, float& closestT) const;
+	private:
+		void CreateBuffers(std::span<const Vertex> vertices, std::span<const glm::vec3> positions, std::span<const uint32_t> indices);
 	private:
 		Ref<VertexArray> m_VAO;
+		Ref<VertexArray> m_PositionVAO;
 		std::vector<Submesh> m_Submeshes;
 		std::vector<Ref<Material>> m_Materials;
 
+		// Either owned or pointing into m_Mapping
 		std::vector<Vertex> m_Vertices;
 		std::vector<uint32_t> m_Indices;
+		Ref<MappedFile> m_Mapping;
+		std::span<const Vertex> m_VertexView;
+		std::span<const uint32_t> m_IndexView;
+
+		mutable std::vector<Scope<BVH>> m_SubmeshBVHs;
+		mutable std::mutex m_BVHMutex;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,506 @@
+#include "rxnpch.h"
+#include "TextureCooker.h"
+
+#include <fstream>
+
+namespace RXNEngine {
+
+	static constexpr uint32_t s_TextureCacheVersion = 1;
+
+	bool TextureCooker::s_Enabled = true;
+
+	namespace Utils {
+
+		static uint16_t PackRGB565(const float color[3])
+		{
+			uint32_t r = (uint32_t)std::clamp(color[0] * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f);
+			uint32_t g = (uint32_t)std::clamp(color[1] * (63.0f / 255.0f) + 0.5f, 0.0f, 63.0f);
+			uint32_t b = (uint32_t)std::clamp(color[2] * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f);
+			return (uint16_t)((r << 11) | (g << 5) | b);
+		}
+
+		static void UnpackRGB565(uint16_t packed, float outColor[3])
+		{
+			uint32_t r = (packed >> 11) & 31;
+			uint32_t g = (packed >> 5) & 63;
+			uint32_t b = packed & 31;
+			outColor[0] = (float)((r << 3) | (r >> 2));
+			outColor[1] = (float)((g << 2) | (g >> 4));
+			outColor[2] = (float)((b << 3) | (b >> 2));
+		}
+
+		// Edge blocks of non multiple of 4 images repeat the last row/column
+		static void FetchBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t outBlock[64])
+		{
+			for (uint32_t y = 0; y < 4; y++)
+			{
+				uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+				for (uint32_t x = 0; x < 4; x++)
+				{
+					uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+					memcpy(&outBlock[(y * 4 + x) * 4], &pixels[((size_t)sourceY * width + sourceX) * 4], 4);
+				}
+			}
+		}
+
+		static void EncodeBC1Block(const uint8_t block[64], uint8_t* out)
+		{
+			float mean[3] = { 0.0f, 0.0f, 0.0f };
+			for (uint32_t i = 0; i < 16; i++)
+				for (uint32_t c = 0; c < 3; c++)
+					mean[c] += block[i * 4 + c] / 16.0f;
+
+			// xx, xy, xz, yy, yz, zz
+			float covariance[6] = {};
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				float r = block[i * 4 + 0] - mean[0];
+				float g = block[i * 4 + 1] - mean[1];
+				float b = block[i * 4 + 2] - mean[2];
+				covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+				covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+			}
+
+			// Power iteration for the principal axis of the block's colours
+			float axis[3] = { 1.0f, 1.0f, 1.0f };
+			for (uint32_t iteration = 0; iteration < 8; iteration++)
+			{
+				float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+				float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+				float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+
+				float length = std::max({ std::abs(x), std::abs(y), std::abs(z) });
+				if (length < 1e-6f)
+					break;
+
+				axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+			}
+
+			float axisLengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+			float minT = FLT_MAX, maxT = -FLT_MAX;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				float t = ((block[i * 4 + 0] - mean[0]) * axis[0] + (block[i * 4 + 1] - mean[1]) * axis[1] + (block[i * 4 + 2] - mean[2]) * axis[2]) / axisLengthSq;
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+
+			// Insetting the endpoints trades the extremes for lower average error
+			float inset = (maxT - minT) / 16.0f;
+			minT += inset;
+			maxT -= inset;
+
+			float endpoint0[3], endpoint1[3];
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				endpoint0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+				endpoint1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+			}
+
+			uint16_t color0 = PackRGB565(endpoint0);
+			uint16_t color1 = PackRGB565(endpoint1);
+
+			// color0 > color1 selects the opaque four colour mode
+			if (color0 < color1)
+				std::swap(color0, color1);
+
+			uint32_t indices = 0;
+			if (color0 != color1)
+			{
+				float palette[4][3];
+				UnpackRGB565(color0, palette[0]);
+				UnpackRGB565(color1, palette[1]);
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+					palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+				}
+
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					uint32_t bestIndex = 0;
+					float bestDistance = FLT_MAX;
+					for (uint32_t p = 0; p < 4; p++)
+					{
+						float dr = block[i * 4 + 0] - palette[p][0];
+						float dg = block[i * 4 + 1] - palette[p][1];
+						float db = block[i * 4 + 2] - palette[p][2];
+						float distance = dr * dr + dg * dg + db * db;
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = p;
+						}
+					}
+					indices |= bestIndex << (i * 2);
+				}
+			}
+
+			memcpy(out + 0, &color0, sizeof(uint16_t));
+			memcpy(out + 2, &color1, sizeof(uint16_t));
+			memcpy(out + 4, &indices, sizeof(uint32_t));
+		}
+
+		// Single channel block, used for BC3 alpha and both BC5 channels
+		static void EncodeBC4Block(const uint8_t block[64], uint32_t channel, uint8_t* out)
+		{
+			uint8_t minValue = 255, maxValue = 0;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				minValue = std::min(minValue, block[i * 4 + channel]);
+				maxValue = std::max(maxValue, block[i * 4 + channel]);
+			}
+
+			out[0] = maxValue;
+			out[1] = minValue;
+
+			uint64_t indices = 0;
+			if (maxValue != minValue)
+			{
+				// maxValue > minValue selects the eight value mode
+				float palette[8];
+				palette[0] = maxValue;
+				palette[1] = minValue;
+				for (uint32_t p = 2; p < 8; p++)
+					palette[p] = ((8 - p) * maxValue + (p - 1) * minValue) / 7.0f;
+
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					uint64_t bestIndex = 0;
+					float bestDistance = FLT_MAX;
+					for (uint32_t p = 0; p < 8; p++)
+					{
+						float distance = std::abs(block[i * 4 + channel] - palette[p]);
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = p;
+						}
+					}
+					indices |= bestIndex << (i * 3);
+				}
+			}
+
+			for (uint32_t i = 0; i < 6; i++)
+				out[2 + i] = (uint8_t)(indices >> (i * 8));
+		}
+
+		static void EncodeLevel(const uint8_t* pixels, uint32_t width, uint32_t height, TextureCompression compression, uint8_t* out)
+		{
+			uint32_t blocksX = (width + 3) / 4;
+			uint32_t blocksY = (height + 3) / 4;
+			uint32_t blockSize = TextureImage::GetBlockSize(compression);
+
+			uint8_t block[64];
+			for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+			{
+				for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+				{
+					FetchBlock(pixels, width, height, blockX, blockY, block);
+
+					switch (compression)
+					{
+						case TextureCompression::BC1:
+							EncodeBC1Block(block, out);
+							break;
+						case TextureCompression::BC3:
+							EncodeBC4Block(block, 3, out);
+							EncodeBC1Block(block, out + 8);
+							break;
+						case TextureCompression::BC5:
+							EncodeBC4Block(block, 0, out);
+							EncodeBC4Block(block, 1, out + 8);
+							break;
+					}
+
+					out += blockSize;
+				}
+			}
+		}
+
+		// 2x2 box filter, normal maps are renormalized so the shorter mips don't flatten the lighting
+		static std::vector<uint8_t> Downsample(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, bool isNormalMap)
+		{
+			uint32_t mipWidth = std::max(width / 2, 1u);
+			uint32_t mipHeight = std::max(height / 2, 1u);
+			std::vector<uint8_t> result((size_t)mipWidth * mipHeight * 4);
+
+			for (uint32_t y = 0; y < mipHeight; y++)
+			{
+				for (uint32_t x = 0; x < mipWidth; x++)
+				{
+					uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+					uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+
+					float sum[4] = {};
+					for (uint32_t sample : { y0 * width + x0, y0 * width + x1, y1 * width + x0, y1 * width + x1 })
+						for (uint32_t c = 0; c < 4; c++)
+							sum[c] += pixels[(size_t)sample * 4 + c] * 0.25f;
+
+					if (isNormalMap)
+					{
+						glm::vec3 normal = glm::vec3(sum[0], sum[1], sum[2]) / 127.5f - 1.0f;
+						float length = glm::length(normal);
+						normal = length > 1e-6f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+						sum[0] = (normal.x + 1.0f) * 127.5f;
+						sum[1] = (normal.y + 1.0f) * 127.5f;
+						sum[2] = (normal.z + 1.0f) * 127.5f;
+					}
+
+					uint8_t* destination = &result[((size_t)y * mipWidth + x) * 4];
+					for (uint32_t c = 0; c < 4; c++)
+						destination[c] = (uint8_t)std::clamp(sum[c] + 0.5f, 0.0f, 255.0f);
+				}
+			}
+
+			return result;
+		}
+
+		static int64_t GetSourceTimestamp(const std::string& path)
+		{
+			std::error_code error;
+			auto time = std::filesystem::last_write_time(path, error);
+			return error ? 0 : (int64_t)time.time_since_epoch().count();
+		}
+
+		struct TextureCacheHeader
+		{
+			uint64_t SourceSize = 0;
+			int64_t SourceTimestamp = 0;
+			uint32_t Usage = 0;
+			uint64_t DataSize = 0;
+		};
+
+		// Leaves the stream at the start of the mip data
+		static bool ReadCacheHeader(std::ifstream& in, TextureCacheHeader& outHeader, TextureImage& outImage)
+		{
+			char magic[4];
+			uint32_t version = 0, compression = 0;
+
+			in.read(magic, 4);
+			in.read((char*)&version, sizeof(uint32_t));
+			in.read((char*)&outHeader.SourceSize, sizeof(uint64_t));
+			in.read((char*)&outHeader.SourceTimestamp, sizeof(int64_t));
+			in.read((char*)&outHeader.Usage, sizeof(uint32_t));
+			in.read((char*)&compression, sizeof(uint32_t));
+			in.read((char*)&outImage.Width, sizeof(uint32_t));
+			in.read((char*)&outImage.Height, sizeof(uint32_t));
+			in.read((char*)&outImage.MipCount, sizeof(uint32_t));
+			in.read((char*)&outHeader.DataSize, sizeof(uint64_t));
+
+			outImage.Channels = 4;
+			outImage.Compression = (TextureCompression)compression;
+
+			return in && memcmp(magic, "RXT\0", 4) == 0 && version == s_TextureCacheVersion;
+		}
+
+	}
+
+	bool TextureCooker::Load(const std::string& path, TextureUsage usage, TextureImage& outImage, uint32_t maxResidentSize)
+	{
+		OPTICK_EVENT();
+
+		if (!s_Enabled)
+			return TextureImage::Decode(path, outImage);
+
+		std::filesystem::path cachePath = GetCachePath(path);
+		if (ReadCache(cachePath, path, usage, maxResidentSize, outImage))
+			return true;
+
+		TextureImage source;
+		if (!TextureImage::Decode(path, source))
+			return false;
+
+		if (!Cook(source, usage, outImage))
+		{
+			outImage = std::move(source);
+			return true;
+		}
+
+		WriteCache(cachePath, path, usage, outImage);
+
+		if (maxResidentSize)
+		{
+			uint32_t firstMip = GetFirstResidentMip(outImage, maxResidentSize);
+			outImage.CompressedData.erase(outImage.CompressedData.begin(), outImage.CompressedData.begin() + outImage.GetMipOffset(firstMip));
+			outImage.FirstMip = firstMip;
+		}
+
+		return true;
+	}
+
+	bool TextureCooker::Cook(const TextureImage& source, TextureUsage usage, TextureImage& outImage)
+	{
+		OPTICK_EVENT();
+
+		if (!source.Pixels || source.HDR || source.IsCompressed())
+			return false;
+
+		// Everything is encoded from RGBA8
+		std::vector<uint8_t> pixels((size_t)source.Width * source.Height * 4);
+		const uint8_t* sourcePixels = (const uint8_t*)source.Pixels;
+		bool hasAlpha = false;
+		for (size_t i = 0; i < (size_t)source.Width * source.Height; i++)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+				pixels[i * 4 + c] = c < source.Channels ? sourcePixels[i * source.Channels + c] : 255;
+
+			hasAlpha |= pixels[i * 4 + 3] < 255;
+		}
+
+		TextureImage image;
+		image.Width = source.Width;
+		image.Height = source.Height;
+		image.Channels = 4;
+		image.MipCount = (uint32_t)std::floor(std::log2(std::max(image.Width, image.Height))) + 1;
+
+		if (usage == TextureUsage::NormalMap)
+			image.Compression = TextureCompression::BC5;
+		else
+			image.Compression = hasAlpha ? TextureCompression::BC3 : TextureCompression::BC1;
+
+		image.CompressedData.resize(image.GetMipOffset(image.MipCount));
+
+		for (uint32_t level = 0; level < image.MipCount; level++)
+		{
+			uint32_t width = image.GetMipWidth(level);
+			uint32_t height = image.GetMipHeight(level);
+
+			Utils::EncodeLevel(pixels.data(), width, height, image.Compression, image.CompressedData.data() + image.GetMipOffset(level));
+
+			if (level + 1 < image.MipCount)
+				pixels = Utils::Downsample(pixels, width, height, usage == TextureUsage::NormalMap);
+		}
+
+		outImage = std::move(image);
+		return true;
+	}
+
+	std::filesystem::path TextureCooker::GetCachePath(const std::string& path)
+	{
+		return std::filesystem::path(path + ".rxntex");
+	}
+
+	bool TextureCooker::ReadCache(const std::filesystem::path& cachePath, const std::string& sourcePath, TextureUsage usage, uint32_t maxResidentSize, TextureImage& outImage)
+	{
+		OPTICK_EVENT();
+
+		std::ifstream in(cachePath, std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		Utils::TextureCacheHeader header;
+		TextureImage image;
+		if (!Utils::ReadCacheHeader(in, header, image))
+			return false;
+
+		std::error_code error;
+		uint64_t currentSourceSize = std::filesystem::file_size(sourcePath, error);
+
+		// Sizes and timestamps rather than a content hash, hashing every texture on each launch would cost more than it saves
+		if (header.SourceSize != (error ? 0 : currentSourceSize) || header.SourceTimestamp != Utils::GetSourceTimestamp(sourcePath) ||
+			header.Usage != (uint32_t)usage)
+			return false;
+
+		if (!image.IsCompressed() || image.Width == 0 || image.Height == 0 || header.DataSize != image.GetMipOffset(image.MipCount))
+		{
+			RXN_CORE_WARN("Texture cache is corrupt, recooking: {0}", cachePath.string());
+			return false;
+		}
+
+		// Only the mip tail is read, the streamer pulls in the rest once the texture is seen up close
+		uint32_t firstMip = maxResidentSize ? GetFirstResidentMip(image, maxResidentSize) : 0;
+		uint64_t skippedSize = image.GetMipOffset(firstMip);
+
+		in.seekg(skippedSize, std::ios::cur);
+		image.FirstMip = firstMip;
+		image.CompressedData.resize(header.DataSize - skippedSize);
+		in.read((char*)image.CompressedData.data(), image.CompressedData.size());
+		if (!in)
+		{
+			RXN_CORE_WARN("Texture cache is corrupt, recooking: {0}", cachePath.string());
+			return false;
+		}
+
+		outImage = std::move(image);
+		return true;
+	}
+
+	bool TextureCooker::LoadMips(const std::filesystem::path& cachePath, uint32_t firstMip, uint32_t endMip, TextureImage& outImage)
+	{
+		OPTICK_EVENT();
+
+		std::ifstream in(cachePath, std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		Utils::TextureCacheHeader header;
+		TextureImage image;
+		if (!Utils::ReadCacheHeader(in, header, image) || !image.IsCompressed() || firstMip >= endMip || endMip > image.MipCount ||
+			header.DataSize != image.GetMipOffset(image.MipCount))
+		{
+			RXN_CORE_WARN("Failed to stream mips from texture cache: {0}", cachePath.string());
+			return false;
+		}
+
+		uint64_t offset = image.GetMipOffset(firstMip);
+		uint64_t size = image.GetMipOffset(endMip) - offset;
+
+		in.seekg(offset, std::ios::cur);
+		image.FirstMip = firstMip;
+		image.CompressedData.resize(size);
+		in.read((char*)image.CompressedData.data(), size);
+		if (!in)
+		{
+			RXN_CORE_WARN("Failed to stream mips from texture cache: {0}", cachePath.string());
+			return false;
+		}
+
+		outImage = std::move(image);
+		return true;
+	}
+
+	uint32_t TextureCooker::GetFirstResidentMip(const TextureImage& image, uint32_t maxResidentSize)
+	{
+		uint32_t level = 0;
+		while (level + 1 < image.MipCount && std::max(image.GetMipWidth(level), image.GetMipHeight(level)) > maxResidentSize)
+			level++;
+
+		return level;
+	}
+
+	void TextureCooker::WriteCache(const std::filesystem::path& cachePath, const std::string& sourcePath, TextureUsage usage, const TextureImage& image)
+	{
+		OPTICK_EVENT();
+
+		std::ofstream out(cachePath, std::ios::binary);
+		if (!out.is_open())
+		{
+			RXN_CORE_WARN("Failed to write texture cache: {0}", cachePath.string());
+			return;
+		}
+
+		std::error_code error;
+		uint64_t sourceSize = std::filesystem::file_size(sourcePath, error);
+		if (error)
+			sourceSize = 0;
+
+		int64_t sourceTimestamp = Utils::GetSourceTimestamp(sourcePath);
+		uint32_t cachedUsage = (uint32_t)usage;
+		uint32_t compression = (uint32_t)image.Compression;
+		uint64_t dataSize = image.CompressedData.size();
+
+		out.write("RXT\0", 4);
+		out.write((char*)&s_TextureCacheVersion, sizeof(uint32_t));
+		out.write((char*)&sourceSize, sizeof(uint64_t));
+		out.write((char*)&sourceTimestamp, sizeof(int64_t));
+		out.write((char*)&cachedUsage, sizeof(uint32_t));
+		out.write((char*)&compression, sizeof(uint32_t));
+		out.write((char*)&image.Width, sizeof(uint32_t));
+		out.write((char*)&image.Height, sizeof(uint32_t));
+		out.write((char*)&image.MipCount, sizeof(uint32_t));
+		out.write((char*)&dataSize, sizeof(uint64_t));
+		out.write((char*)image.CompressedData.data(), dataSize);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/Texture.h"
+
+#include <filesystem>
+
+namespace RXNEngine {
+
+	// What the texture is sampled as, picks the block format it gets cooked to
+	enum class TextureUsage
+	{
+		Color = 0,
+		NormalMap
+	};
+
+	// Converts source images into block compressed textures with a precomputed mip chain and caches the result
+	// next to the source as <file>.rxntex, so later launches skip decoding and encoding entirely
+	class TextureCooker
+	{
+	public:
+		// Returns the cooked image, cooking and writing the cache first if it is missing or older than the source.
+		// HDR images aren't compressed and come back decoded. A non zero maxResidentSize keeps only the mips
+		// that fit in it, starting the texture at its mip tail. Safe to call from worker threads
+		static bool Load(const std::string& path, TextureUsage usage, TextureImage& outImage, uint32_t maxResidentSize = 0);
+
+		// Reads levels [firstMip, endMip) from a cache written by Load
+		static bool LoadMips(const std::filesystem::path& cachePath, uint32_t firstMip, uint32_t endMip, TextureImage& outImage);
+		static uint32_t GetFirstResidentMip(const TextureImage& image, uint32_t maxResidentSize);
+
+		static bool Cook(const TextureImage& source, TextureUsage usage, TextureImage& outImage);
+
+		static std::filesystem::path GetCachePath(const std::string& path);
+
+		static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+		static bool IsEnabled() { return s_Enabled; }
+	private:
+		static bool ReadCache(const std::filesystem::path& cachePath, const std::string& sourcePath, TextureUsage usage, uint32_t maxResidentSize, TextureImage& outImage);
+		static void WriteCache(const std::filesystem::path& cachePath, const std::string& sourcePath, TextureUsage usage, const TextureImage& image);
+	private:
+		static bool s_Enabled;
+	};
+
+}
\ No newline at end of file
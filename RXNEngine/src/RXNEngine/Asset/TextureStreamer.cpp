@@ -0,0 +1,260 @@
+#include "rxnpch.h"
+#include "TextureStreamer.h"
+
+#include "RXNEngine/Asset/AssetManager.h"
+#include "RXNEngine/Asset/TextureCooker.h"
+#include "RXNEngine/Core/JobSystem.h"
+
+#include <chrono>
+
+namespace RXNEngine {
+
+    std::unordered_map<Texture2D*, TextureStreamer::StreamedTexture> TextureStreamer::s_Textures;
+
+    std::mutex TextureStreamer::s_TaskMutex;
+    std::vector<TextureStreamer::StreamTask*> TextureStreamer::s_FinishedTasks;
+    uint32_t TextureStreamer::s_PendingRequests = 0;
+
+    uint64_t TextureStreamer::s_FrameIndex = 0;
+    bool TextureStreamer::s_Enabled = true;
+    uint64_t TextureStreamer::s_Budget = 512ull * 1024 * 1024;
+    uint32_t TextureStreamer::s_InitialResidentSize = 128;
+
+    // Frames a texture keeps its sharper mips after it stops asking for them, stops mips popping in and out at a boundary
+    static constexpr uint64_t s_EvictionDelay = 120;
+    static constexpr uint32_t s_MaxPendingRequests = 4;
+
+    void TextureStreamer::Register(const Ref<Texture2D>& texture, const std::filesystem::path& cachePath, const TextureImage& image)
+    {
+        if (!s_Enabled || !texture || !image.IsCompressed())
+            return;
+
+        StreamedTexture entry;
+        entry.Texture = texture;
+        entry.CachePath = cachePath;
+        entry.Layout.Width = image.Width;
+        entry.Layout.Height = image.Height;
+        entry.Layout.Channels = image.Channels;
+        entry.Layout.Compression = image.Compression;
+        entry.Layout.MipCount = image.MipCount;
+
+        entry.TailMip = TextureCooker::GetFirstResidentMip(entry.Layout, s_InitialResidentSize);
+        entry.RequestedMip = entry.TailMip;
+        entry.WantedMip = entry.TailMip;
+        entry.WantedFrame = s_FrameIndex;
+
+        s_Textures[texture.get()] = std::move(entry);
+    }
+
+    void TextureStreamer::RequestMaterial(const Material& material, float screenSize)
+    {
+        if (!s_Enabled || s_Textures.empty())
+            return;
+
+        // Tiling repeats the texture across the surface, each repetition only covers a fraction of the draw
+        float tileSize = screenSize / std::max(material.GetParameters().Tiling, 0.01f);
+
+        Request(material.GetAlbedoMap(), tileSize);
+        Request(material.GetNormalMap(), tileSize);
+        Request(material.GetMetalnessRoughnessMap(), tileSize);
+        Request(material.GetAOMap(), tileSize);
+        Request(material.GetEmissiveMap(), tileSize);
+    }
+
+    void TextureStreamer::Request(const Ref<Texture2D>& texture, float screenSize)
+    {
+        if (!texture)
+            return;
+
+        auto it = s_Textures.find(texture.get());
+        if (it == s_Textures.end())
+            return;
+
+        StreamedTexture& entry = it->second;
+
+        // One texel per pixel, anything sharper would be minified away by the sampler
+        float texels = (float)std::max(entry.Layout.Width, entry.Layout.Height);
+        float level = std::log2(texels / std::max(screenSize, 1.0f));
+        uint32_t mip = level <= 0.0f ? 0 : std::min((uint32_t)level, entry.TailMip);
+
+        entry.RequestedMip = std::min(entry.RequestedMip, mip);
+    }
+
+    void TextureStreamer::Update()
+    {
+        OPTICK_EVENT();
+
+        ApplyFinishedRequests();
+
+        for (auto it = s_Textures.begin(); it != s_Textures.end();)
+        {
+            if (it->second.Texture.expired())
+                it = s_Textures.erase(it);
+            else
+                ++it;
+        }
+
+        if (!s_Enabled)
+            return;
+
+        struct Target
+        {
+            Texture2D* Key;
+            StreamedTexture* Entry;
+            Ref<Texture2D> Texture;
+            uint32_t BaseMip;
+        };
+
+        std::vector<Target> targets;
+        targets.reserve(s_Textures.size());
+        uint64_t totalSize = 0;
+
+        for (auto& [key, entry] : s_Textures)
+        {
+            // Sharper requests are taken immediately, blurrier ones only once they've held for a while
+            if (entry.RequestedMip <= entry.WantedMip || s_FrameIndex - entry.WantedFrame > s_EvictionDelay)
+            {
+                entry.WantedMip = entry.RequestedMip;
+                entry.WantedFrame = s_FrameIndex;
+            }
+
+            entry.RequestedMip = entry.TailMip;
+
+            Ref<Texture2D> texture = entry.Texture.lock();
+            uint32_t baseMip = texture->GetBaseMip();
+
+            uint32_t target = entry.WantedMip;
+            if (entry.Failed || entry.Pending)
+                target = std::max(target, baseMip);
+
+            totalSize += GetResidentSize(entry.Layout, target);
+            targets.push_back({ key, &entry, texture, target });
+        }
+
+        // Over budget the sharpest textures drop a level first, the mip tail always stays resident
+        while (totalSize > s_Budget)
+        {
+            Target* sharpest = nullptr;
+            for (Target& target : targets)
+            {
+                if (target.BaseMip < target.Entry->TailMip && !target.Entry->Pending && (!sharpest || target.BaseMip < sharpest->BaseMip))
+                    sharpest = &target;
+            }
+
+            if (!sharpest)
+                break;
+
+            totalSize -= sharpest->Entry->Layout.GetMipSize(sharpest->BaseMip);
+            sharpest->BaseMip++;
+        }
+
+        for (Target& target : targets)
+        {
+            StreamedTexture& entry = *target.Entry;
+            uint32_t baseMip = target.Texture->GetBaseMip();
+
+            if (entry.Pending || target.BaseMip == baseMip)
+                continue;
+
+            // Dropping levels is a copy on the GPU, no need to go through the cache
+            if (target.BaseMip > baseMip)
+            {
+                target.Texture->SetBaseMip(target.BaseMip, TextureImage());
+                continue;
+            }
+
+            if (s_PendingRequests >= s_MaxPendingRequests)
+                continue;
+
+            StreamTask* task = new StreamTask();
+            task->Key = target.Key;
+            task->Texture = target.Texture;
+            task->BaseMip = target.BaseMip;
+
+            entry.Pending = true;
+            s_PendingRequests++;
+
+            JobSystem::ExecuteBackground([task, cachePath = entry.CachePath, endMip = baseMip]()
+                {
+                    OPTICK_EVENT("TextureStreamer::LoadMips");
+
+                    task->Succeeded = TextureCooker::LoadMips(cachePath, task->BaseMip, endMip, task->Image);
+
+                    std::lock_guard<std::mutex> lock(s_TaskMutex);
+                    s_FinishedTasks.push_back(task);
+                });
+        }
+
+        s_FrameIndex++;
+    }
+
+    void TextureStreamer::ApplyFinishedRequests()
+    {
+        OPTICK_EVENT();
+
+        auto start = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            StreamTask* task = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(s_TaskMutex);
+                if (s_FinishedTasks.empty())
+                    break;
+
+                task = s_FinishedTasks.front();
+                s_FinishedTasks.erase(s_FinishedTasks.begin());
+            }
+
+            s_PendingRequests--;
+
+            auto it = s_Textures.find(task->Key);
+            if (it != s_Textures.end() && it->second.Texture.lock() == task->Texture)
+            {
+                StreamedTexture& entry = it->second;
+                entry.Pending = false;
+
+                if (!task->Succeeded)
+                    entry.Failed = true;
+                else if (task->BaseMip < task->Texture->GetBaseMip())
+                    task->Texture->SetBaseMip(task->BaseMip, task->Image);
+            }
+
+            delete task;
+
+            // Shares the upload budget with newly loaded textures
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= AssetManager::GetTextureUploadBudget())
+                break;
+        }
+    }
+
+    uint64_t TextureStreamer::GetResidentSize(const TextureImage& layout, uint32_t baseMip)
+    {
+        uint64_t size = 0;
+        for (uint32_t level = baseMip; level < layout.MipCount; level++)
+            size += layout.GetMipSize(level);
+
+        return size;
+    }
+
+    TextureStreamingStatistics TextureStreamer::GetStats()
+    {
+        TextureStreamingStatistics stats;
+        stats.PendingRequests = s_PendingRequests;
+        stats.BudgetBytes = s_Budget;
+
+        for (const auto& [key, entry] : s_Textures)
+        {
+            Ref<Texture2D> texture = entry.Texture.lock();
+            if (!texture)
+                continue;
+
+            stats.StreamedTextures++;
+            stats.ResidentBytes += GetResidentSize(entry.Layout, texture->GetBaseMip());
+        }
+
+        return stats;
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "RXNEngine/Renderer/GraphicsAPI/Texture.h"
+#include "RXNEngine/Asset/Material.h"
+
+#include <filesystem>
+#include <mutex>
+
+namespace RXNEngine {
+
+    struct TextureStreamingStatistics
+    {
+        uint32_t StreamedTextures = 0;
+        uint32_t PendingRequests = 0;
+        uint64_t ResidentBytes = 0;
+        uint64_t BudgetBytes = 0;
+    };
+
+    // Keeps only the mips of cooked textures that are actually seen resident. Textures start at their mip tail,
+    // the renderer reports how large each visible material is on screen and the missing levels are read from the
+    // texture cache on background jobs. When the budget is exceeded the sharpest textures give up a level first
+    class TextureStreamer
+    {
+    public:
+        static void Register(const Ref<Texture2D>& texture, const std::filesystem::path& cachePath, const TextureImage& image);
+
+        // screenSize is the on screen diameter of the draw in pixels
+        static void RequestMaterial(const Material& material, float screenSize);
+        static void Request(const Ref<Texture2D>& texture, float screenSize);
+
+        // Applies finished requests and issues new ones, call once per frame on the render thread
+        static void Update();
+
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+        static bool IsEnabled() { return s_Enabled; }
+
+        static void SetBudget(uint64_t bytes) { s_Budget = bytes; }
+        static uint64_t GetBudget() { return s_Budget; }
+
+        // Largest mip a texture is given before anything has requested it
+        static uint32_t GetInitialResidentSize() { return s_InitialResidentSize; }
+
+        static TextureStreamingStatistics GetStats();
+    private:
+        struct StreamedTexture
+        {
+            std::weak_ptr<Texture2D> Texture;
+            std::filesystem::path CachePath;
+            TextureImage Layout;
+
+            uint32_t TailMip = 0;
+            uint32_t RequestedMip = 0;
+            uint32_t WantedMip = 0;
+            uint64_t WantedFrame = 0;
+            bool Pending = false;
+            bool Failed = false;
+        };
+
+        struct StreamTask
+        {
+            Texture2D* Key = nullptr;
+            Ref<Texture2D> Texture;
+            uint32_t BaseMip = 0;
+            TextureImage Image;
+            bool Succeeded = false;
+        };
+
+        static void ApplyFinishedRequests();
+        static uint64_t GetResidentSize(const TextureImage& layout, uint32_t baseMip);
+    private:
+        static std::unordered_map<Texture2D*, StreamedTexture> s_Textures;
+
+        static std::mutex s_TaskMutex;
+        static std::vector<StreamTask*> s_FinishedTasks;
+        static uint32_t s_PendingRequests;
+
+        static uint64_t s_FrameIndex;
+        static bool s_Enabled;
+        static uint64_t s_Budget;
+        static uint32_t s_InitialResidentSize;
+    };
+
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "RXNEngine/Renderer/Renderer.h"
 #include "RXNEngine/Renderer/RenderCommand.h"
+#include "RXNEngine/Renderer/GPUProfiler.h"
 #include "RXNEngine/Core/Time.h"
 #include "RXNEngine/Core/JobSystem.h"
 #include "RXNEngine/Physics/PhysicsSystem.h"
@@ -70,6 +71,7 @@ namespace RXNEngine {
 			OPTICK_FRAME("MainThread");
 
 			Time::Get().OnFrameStart();
+			GPUProfiler::BeginFrame();
 
 			if (!m_Minimized)
 			{
@@ -0,0 +1,182 @@
+#include "rxnpch.h"
+#include "FileWatcher.h"
+
+#ifdef RXN_PLATFORM_LINUX
+    #include <sys/inotify.h>
+    #include <sys/eventfd.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+namespace RXNEngine {
+
+#ifdef RXN_PLATFORM_WINDOWS
+    FileWatcher::FileWatcher(const std::filesystem::path& directory, const Callback& callback)
+        : m_Directory(std::filesystem::absolute(directory)), m_Callback(callback)
+    {
+        m_DirectoryHandle = CreateFileW(m_Directory.c_str(), FILE_LIST_DIRECTORY,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+        {
+            m_DirectoryHandle = nullptr;
+            RXN_CORE_ERROR("FileWatcher: Could not open {0}", m_Directory.string());
+            return;
+        }
+
+        m_StopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        m_Running = true;
+        m_Thread = std::thread(&FileWatcher::Run, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        if (m_Thread.joinable())
+        {
+            m_Running = false;
+            SetEvent(m_StopEvent);
+            m_Thread.join();
+        }
+
+        if (m_StopEvent)
+            CloseHandle(m_StopEvent);
+        if (m_DirectoryHandle)
+            CloseHandle(m_DirectoryHandle);
+    }
+
+    void FileWatcher::Run()
+    {
+        OPTICK_THREAD("FileWatcher");
+
+        alignas(DWORD) uint8_t buffer[16 * 1024];
+
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        HANDLE handles[2] = { overlapped.hEvent, m_StopEvent };
+
+        while (m_Running)
+        {
+            ResetEvent(overlapped.hEvent);
+            if (!ReadDirectoryChangesW(m_DirectoryHandle, buffer, sizeof(buffer), FALSE,
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr))
+            {
+                RXN_CORE_ERROR("FileWatcher: Stopped watching {0}", m_Directory.string());
+                break;
+            }
+
+            DWORD bytes = 0;
+            if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+            {
+                CancelIoEx(m_DirectoryHandle, &overlapped);
+                GetOverlappedResult(m_DirectoryHandle, &overlapped, &bytes, TRUE);
+                break;
+            }
+
+            if (!GetOverlappedResult(m_DirectoryHandle, &overlapped, &bytes, FALSE))
+                continue;
+
+            // Nothing returned means the buffer overflowed and the changes were dropped, the directory stands in for them
+            if (bytes == 0)
+            {
+                m_Callback(m_Directory);
+                continue;
+            }
+
+            const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)buffer;
+            while (true)
+            {
+                if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                    m_Callback(m_Directory / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+
+                if (info->NextEntryOffset == 0)
+                    break;
+                info = (const FILE_NOTIFY_INFORMATION*)((const uint8_t*)info + info->NextEntryOffset);
+            }
+        }
+
+        CloseHandle(overlapped.hEvent);
+    }
+#elif defined(RXN_PLATFORM_LINUX)
+    FileWatcher::FileWatcher(const std::filesystem::path& directory, const Callback& callback)
+        : m_Directory(std::filesystem::absolute(directory)), m_Callback(callback)
+    {
+        m_NotifyFD = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (m_NotifyFD < 0 || inotify_add_watch(m_NotifyFD, m_Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        {
+            RXN_CORE_ERROR("FileWatcher: Could not watch {0}", m_Directory.string());
+            return;
+        }
+
+        m_StopFD = eventfd(0, EFD_CLOEXEC);
+        if (m_StopFD < 0)
+            return;
+
+        m_Running = true;
+        m_Thread = std::thread(&FileWatcher::Run, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        if (m_Thread.joinable())
+        {
+            m_Running = false;
+            uint64_t stop = 1;
+            (void)write(m_StopFD, &stop, sizeof(stop));
+            m_Thread.join();
+        }
+
+        if (m_StopFD >= 0)
+            close(m_StopFD);
+        if (m_NotifyFD >= 0)
+            close(m_NotifyFD);
+    }
+
+    void FileWatcher::Run()
+    {
+        OPTICK_THREAD("FileWatcher");
+
+        alignas(inotify_event) char buffer[16 * 1024];
+        pollfd fds[2] = { { m_NotifyFD, POLLIN, 0 }, { m_StopFD, POLLIN, 0 } };
+
+        while (m_Running)
+        {
+            if (poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+
+            if (fds[1].revents != 0)
+                break;
+
+            ssize_t length = read(m_NotifyFD, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < length; )
+            {
+                const inotify_event* event = (const inotify_event*)(buffer + offset);
+
+                // The kernel dropped events, the directory stands in for them
+                if (event->mask & IN_Q_OVERFLOW)
+                    m_Callback(m_Directory);
+                else if (event->len > 0 && !(event->mask & IN_ISDIR))
+                    m_Callback(m_Directory / event->name);
+
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+#else
+    FileWatcher::FileWatcher(const std::filesystem::path& directory, const Callback& callback)
+        : m_Directory(std::filesystem::absolute(directory)), m_Callback(callback)
+    {
+    }
+
+    FileWatcher::~FileWatcher() = default;
+
+    void FileWatcher::Run()
+    {
+    }
+#endif
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+namespace RXNEngine {
+
+    // Watches one directory (not its subdirectories) on a background thread that sleeps in the OS until something
+    // changes. The callback runs on that thread with the path of the file that was written, created or renamed into
+    // the directory, so it should only record the change. IsWatching() is false when the platform has no watcher or
+    // the directory couldn't be opened, callers then have to poll
+    class FileWatcher
+    {
+    public:
+        using Callback = std::function<void(const std::filesystem::path&)>;
+    public:
+        FileWatcher(const std::filesystem::path& directory, const Callback& callback);
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        bool IsWatching() const { return m_Thread.joinable(); }
+        const std::filesystem::path& GetDirectory() const { return m_Directory; }
+    private:
+        void Run();
+    private:
+        std::filesystem::path m_Directory;
+        Callback m_Callback;
+        std::thread m_Thread;
+        std::atomic<bool> m_Running = false;
+
+#ifdef RXN_PLATFORM_WINDOWS
+        void* m_DirectoryHandle = nullptr;
+        void* m_StopEvent = nullptr;
+#else
+        int m_NotifyFD = -1;
+        int m_StopFD = -1;
+#endif
+    };
+
+}
@@ -12,12 +12,18 @@ namespace RXNEngine {
         std::vector<std::thread> s_Workers;
 
         std::queue<std::function<void()>> s_JobQueue;
+        std::queue<std::function<void()>> s_BackgroundQueue;
+        uint32_t s_MaxBackgroundJobs = 1;
+        uint32_t s_ActiveBackgroundJobs = 0;
         std::mutex s_QueueMutex;
         std::condition_variable s_WakeCondition;
 
         std::atomic<uint64_t> s_CurrentLabel = 0;
         std::atomic<uint64_t> s_FinishedLabel = 0;
         bool s_IsRunning = false;
+
+        // Jobs running on this thread, Wait() runs queued jobs on the waiting thread so the main thread counts too
+        thread_local uint32_t t_JobDepth = 0;
     }
 
     void JobSystem::Init()
@@ -27,6 +33,7 @@ namespace RXNEngine {
 
         uint32_t coreCount = std::thread::hardware_concurrency();
         s_NumThreads = (coreCount > 1) ? coreCount - 1 : 1;
+        s_MaxBackgroundJobs = std::max(1u, s_NumThreads / 2);
 
         RXN_CORE_INFO("JobSystem: Initializing {0} Worker Threads...", s_NumThreads);
 
@@ -66,6 +73,16 @@ namespace RXNEngine {
         s_WakeCondition.notify_one();
     }
 
+    void JobSystem::ExecuteBackground(const std::function<void()>& job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_QueueMutex);
+            s_BackgroundQueue.push(job);
+        }
+
+        s_WakeCondition.notify_one();
+    }
+
     void JobSystem::Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
     {
         if (jobCount == 0 || groupSize == 0) return;
@@ -119,7 +136,9 @@ namespace RXNEngine {
 
             if (hasJob)
             {
+                t_JobDepth++;
                 job();
+                t_JobDepth--;
                 s_FinishedLabel.fetch_add(1);
             }
             else
@@ -134,6 +153,11 @@ namespace RXNEngine {
         return std::this_thread::get_id() == s_MainThreadID;
     }
 
+    bool JobSystem::IsInsideJob()
+    {
+        return t_JobDepth > 0;
+    }
+
     uint32_t JobSystem::GetThreadCount()
     {
         return s_NumThreads + 1;
@@ -147,21 +171,46 @@ namespace RXNEngine {
         while (s_IsRunning)
         {
             std::function<void()> job;
+            bool isBackground = false;
 
             {
                 std::unique_lock<std::mutex> lock(s_QueueMutex);
 
-                s_WakeCondition.wait(lock, [] { return !s_JobQueue.empty() || !s_IsRunning; });
+                auto canRunBackground = [] { return !s_BackgroundQueue.empty() && s_ActiveBackgroundJobs < s_MaxBackgroundJobs; };
+                s_WakeCondition.wait(lock, [&] { return !s_JobQueue.empty() || canRunBackground() || !s_IsRunning; });
 
                 if (!s_IsRunning) break;
 
-                job = s_JobQueue.front();
-                s_JobQueue.pop();
+                if (!s_JobQueue.empty())
+                {
+                    job = s_JobQueue.front();
+                    s_JobQueue.pop();
+                }
+                else
+                {
+                    job = s_BackgroundQueue.front();
+                    s_BackgroundQueue.pop();
+                    s_ActiveBackgroundJobs++;
+                    isBackground = true;
+                }
             }
 
+            t_JobDepth++;
             job();
+            t_JobDepth--;
 
-            s_FinishedLabel.fetch_add(1);
+            if (isBackground)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(s_QueueMutex);
+                    s_ActiveBackgroundJobs--;
+                }
+                s_WakeCondition.notify_one();
+            }
+            else
+            {
+                s_FinishedLabel.fetch_add(1);
+            }
         }
     }
 
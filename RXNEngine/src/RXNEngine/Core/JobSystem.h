@@ -23,12 +23,20 @@ namespace RXNEngine {
 
         static void Execute(const std::function<void()>& job);
 
+        // Long running work (asset loading, decoding) that Wait() neither waits for nor runs on the calling thread.
+        // Only part of the workers pick these up so per-frame jobs always keep some threads
+        static void ExecuteBackground(const std::function<void()>& job);
+
         static void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job);
 
         static void Wait();
 
         static bool IsMainThread();
 
+        // True while the calling thread runs a job. A job can't Dispatch and Wait, Wait() would count the job itself
+        // as unfinished work and never return
+        static bool IsInsideJob();
+
         static uint32_t GetThreadCount();
 
     private:
@@ -0,0 +1,110 @@
+#include "rxnpch.h"
+#include "BVH.h"
+
+#include <numeric>
+
+namespace RXNEngine {
+
+	static constexpr uint32_t s_MaxLeafSize = 4;
+
+	void BVH::Build(const std::vector<AABB>& primitiveBounds)
+	{
+		OPTICK_EVENT();
+
+		Clear();
+
+		if (primitiveBounds.empty())
+			return;
+
+		uint32_t count = (uint32_t)primitiveBounds.size();
+
+		m_PrimitiveIndices.resize(count);
+		std::iota(m_PrimitiveIndices.begin(), m_PrimitiveIndices.end(), 0);
+
+		std::vector<glm::vec3> centroids(count);
+		for (uint32_t i = 0; i < count; i++)
+			centroids[i] = (primitiveBounds[i].Min + primitiveBounds[i].Max) * 0.5f;
+
+		m_Nodes.reserve(count * 2 - 1);
+
+		Node& root = m_Nodes.emplace_back();
+		root.LeftFirst = 0;
+		root.Count = count;
+
+		UpdateNodeBounds(0, primitiveBounds);
+		Subdivide(0, primitiveBounds, centroids);
+	}
+
+	void BVH::Clear()
+	{
+		m_Nodes.clear();
+		m_PrimitiveIndices.clear();
+	}
+
+	void BVH::UpdateNodeBounds(uint32_t nodeIndex, const std::vector<AABB>& primitiveBounds)
+	{
+		Node& node = m_Nodes[nodeIndex];
+		node.Bounds.Min = glm::vec3(std::numeric_limits<float>::max());
+		node.Bounds.Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		for (uint32_t i = 0; i < node.Count; i++)
+		{
+			const AABB& bounds = primitiveBounds[m_PrimitiveIndices[node.LeftFirst + i]];
+			node.Bounds.Min = glm::min(node.Bounds.Min, bounds.Min);
+			node.Bounds.Max = glm::max(node.Bounds.Max, bounds.Max);
+		}
+	}
+
+	void BVH::Subdivide(uint32_t nodeIndex, const std::vector<AABB>& primitiveBounds, const std::vector<glm::vec3>& centroids)
+	{
+		uint32_t first = m_Nodes[nodeIndex].LeftFirst;
+		uint32_t count = m_Nodes[nodeIndex].Count;
+
+		if (count <= s_MaxLeafSize)
+			return;
+
+		glm::vec3 centroidMin(std::numeric_limits<float>::max());
+		glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::vec3& centroid = centroids[m_PrimitiveIndices[first + i]];
+			centroidMin = glm::min(centroidMin, centroid);
+			centroidMax = glm::max(centroidMax, centroid);
+		}
+
+		glm::vec3 extent = centroidMax - centroidMin;
+		int axis = 0;
+		if (extent.y > extent.x) axis = 1;
+		if (extent.z > extent[axis]) axis = 2;
+
+		// All centroids coincide, splitting further would not separate anything
+		if (extent[axis] <= 0.0f)
+			return;
+
+		uint32_t leftCount = count / 2;
+		auto begin = m_PrimitiveIndices.begin() + first;
+		std::nth_element(begin, begin + leftCount, begin + count, [&](uint32_t a, uint32_t b)
+			{
+				return centroids[a][axis] < centroids[b][axis];
+			});
+
+		uint32_t leftIndex = (uint32_t)m_Nodes.size();
+		m_Nodes.emplace_back();
+		m_Nodes.emplace_back();
+
+		m_Nodes[leftIndex].LeftFirst = first;
+		m_Nodes[leftIndex].Count = leftCount;
+		m_Nodes[leftIndex + 1].LeftFirst = first + leftCount;
+		m_Nodes[leftIndex + 1].Count = count - leftCount;
+
+		m_Nodes[nodeIndex].LeftFirst = leftIndex;
+		m_Nodes[nodeIndex].Count = 0;
+
+		UpdateNodeBounds(leftIndex, primitiveBounds);
+		UpdateNodeBounds(leftIndex + 1, primitiveBounds);
+
+		Subdivide(leftIndex, primitiveBounds, centroids);
+		Subdivide(leftIndex + 1, primitiveBounds, centroids);
+	}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "RXNEngine/Math/Math.h"
+
+#include <vector>
+
+namespace RXNEngine {
+
+	// Bounding volume hierarchy over arbitrary primitives, built from their bounds with median splits
+	class BVH
+	{
+	public:
+		struct Node
+		{
+			AABB Bounds;
+			uint32_t LeftFirst = 0; // Left child for inner nodes, first primitive for leaves (right child is LeftFirst + 1)
+			uint32_t Count = 0;     // Primitive count, 0 for inner nodes
+		};
+	public:
+		void Build(const std::vector<AABB>& primitiveBounds);
+		void Clear();
+
+		bool IsEmpty() const { return m_Nodes.empty(); }
+		const std::vector<Node>& GetNodes() const { return m_Nodes; }
+
+		// intersect(primitiveIndex, closestT) tests one primitive and returns true if it lowered closestT
+		template<typename IntersectFunc>
+		bool Raycast(const Ray& ray, float& closestT, IntersectFunc&& intersect) const;
+	private:
+		void UpdateNodeBounds(uint32_t nodeIndex, const std::vector<AABB>& primitiveBounds);
+		void Subdivide(uint32_t nodeIndex, const std::vector<AABB>& primitiveBounds, const std::vector<glm::vec3>& centroids);
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<uint32_t> m_PrimitiveIndices;
+	};
+
+	template<typename IntersectFunc>
+	bool BVH::Raycast(const Ray& ray, float& closestT, IntersectFunc&& intersect) const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		glm::vec3 invDirection = 1.0f / ray.Direction;
+		bool hit = false;
+
+		uint32_t stack[64];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+
+			float tEntry;
+			if (!Math::IntersectRayAABB(ray.Origin, invDirection, node.Bounds, closestT, tEntry))
+				continue;
+
+			if (node.Count > 0)
+			{
+				for (uint32_t i = 0; i < node.Count; i++)
+				{
+					if (intersect(m_PrimitiveIndices[node.LeftFirst + i], closestT))
+						hit = true;
+				}
+				continue;
+			}
+
+			uint32_t nearChild = node.LeftFirst;
+			uint32_t farChild = node.LeftFirst + 1;
+
+			float tNear, tFar;
+			bool hitNear = Math::IntersectRayAABB(ray.Origin, invDirection, m_Nodes[nearChild].Bounds, closestT, tNear);
+			bool hitFar = Math::IntersectRayAABB(ray.Origin, invDirection, m_Nodes[farChild].Bounds, closestT, tFar);
+
+			if (hitNear && hitFar && tFar < tNear)
+			{
+				std::swap(nearChild, farChild);
+				std::swap(hitNear, hitFar);
+			}
+
+			// Push the far child first so the near one is visited first and tightens closestT early
+			if (hitFar)
+				stack[stackSize++] = farChild;
+			if (hitNear)
+				stack[stackSize++] = nearChild;
+		}
+
+		return hit;
+	}
+
+}
@@ -119,5 +119,48 @@ namespace RXNEngine {
 			t = tmin;
 			return true;
 		}
+
+		// Slab test against a precomputed reciprocal direction, clipped to [0, maxT]
+		inline bool IntersectRayAABB(const glm::vec3& origin, const glm::vec3& invDirection, const AABB& box, float maxT, float& tEntry)
+		{
+			glm::vec3 t0 = (box.Min - origin) * invDirection;
+			glm::vec3 t1 = (box.Max - origin) * invDirection;
+
+			glm::vec3 tSmall = glm::min(t0, t1);
+			glm::vec3 tBig = glm::max(t0, t1);
+
+			float tmin = glm::max(glm::max(tSmall.x, tSmall.y), glm::max(tSmall.z, 0.0f));
+			float tmax = glm::min(glm::min(tBig.x, tBig.y), glm::min(tBig.z, maxT));
+
+			tEntry = tmin;
+			return tmin <= tmax;
+		}
+
+		// Moller-Trumbore, culls nothing so back faces are hit as well
+		inline bool IntersectRayTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& t)
+		{
+			glm::vec3 edge1 = v1 - v0;
+			glm::vec3 edge2 = v2 - v0;
+
+			glm::vec3 p = glm::cross(ray.Direction, edge2);
+			float det = glm::dot(edge1, p);
+			if (std::abs(det) < 1e-12f)
+				return false;
+
+			float invDet = 1.0f / det;
+			glm::vec3 s = ray.Origin - v0;
+
+			float u = glm::dot(s, p) * invDet;
+			if (u < 0.0f || u > 1.0f)
+				return false;
+
+			glm::vec3 q = glm::cross(s, edge1);
+			float v = glm::dot(ray.Direction, q) * invDet;
+			if (v < 0.0f || u + v > 1.0f)
+				return false;
+
+			t = glm::dot(edge2, q) * invDet;
+			return t > 0.0f;
+		}
     }
 }
\ No newline at end of file
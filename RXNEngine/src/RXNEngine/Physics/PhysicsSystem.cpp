@@ -1,6 +1,8 @@
 #include "rxnpch.h"
 #include "PhysicsSystem.h"
 
+#include "RXNEngine/Core/JobSystem.h"
+
 namespace RXNEngine {
 
     using namespace physx;
@@ -12,6 +14,7 @@ namespace RXNEngine {
     {
         pairFlags = physx::PxPairFlag::eCONTACT_DEFAULT;
         pairFlags |= physx::PxPairFlag::eNOTIFY_TOUCH_FOUND | physx::PxPairFlag::eNOTIFY_TOUCH_LOST;
+        pairFlags |= physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
         pairFlags |= physx::PxPairFlag::eDETECT_CCD_CONTACT;
         return physx::PxFilterFlag::eDEFAULT;
     }
@@ -28,6 +31,117 @@ namespace RXNEngine {
     PxDefaultAllocator PhysicsSystem::s_Allocator;
     PxDefaultErrorCallback PhysicsSystem::s_ErrorCallback;
 
+    std::vector<PhysicsContactEvent> PhysicsSystem::s_ContactEvents;
+
+    // Enough to place the contact, a pile-up's manifolds aren't worth copying whole
+    static constexpr PxU32 s_MaxContactPoints = 8;
+
+    // Below this many queries a batch isn't worth splitting across workers
+    static constexpr uint32_t s_MinQueryBatchSize = 64;
+
+    namespace {
+        // Skips the ignored entity and shapes outside the layer mask. Single hit queries want the closest block,
+        // multi hit ones take everything as a touch
+        class QueryFilter : public PxQueryFilterCallback
+        {
+        public:
+            QueryFilter(const PhysicsQuery& query, PxQueryHitType::Enum hitType)
+                : m_IgnoreID(query.IgnoreEntityID), m_LayerMask(query.LayerMask), m_HitType(hitType) {}
+
+            virtual PxQueryHitType::Enum preFilter(const PxFilterData& filterData, const PxShape* shape, const PxRigidActor* actor, PxHitFlags& queryFlags) override
+            {
+                if (actor && actor->userData && (uint64_t)actor->userData == m_IgnoreID)
+                    return PxQueryHitType::eNONE;
+
+                // Shapes created without a layer count as layer 0
+                uint32_t layerBits = shape ? shape->getQueryFilterData().word0 : 0;
+                if (layerBits == 0)
+                    layerBits = PhysicsSystem::GetLayerBit(0);
+
+                return (layerBits & m_LayerMask) ? m_HitType : PxQueryHitType::eNONE;
+            }
+
+            virtual PxQueryHitType::Enum postFilter(const PxFilterData& filterData, const PxQueryHit& hit, const PxShape* shape, const PxRigidActor* actor) override
+            {
+                return m_HitType;
+            }
+        private:
+            uint64_t m_IgnoreID;
+            uint32_t m_LayerMask;
+            PxQueryHitType::Enum m_HitType;
+        };
+
+        static PxTransform GetQueryPose(const PhysicsQuery& query)
+        {
+            PxQuat rotation(PxIdentity);
+            if (query.Rotation != glm::vec4(0.0f))
+                rotation = PxQuat(query.Rotation.x, query.Rotation.y, query.Rotation.z, query.Rotation.w).getNormalized();
+
+            // PhysX capsules lie along X, colliders rotate them to stand along Y
+            if (query.Shape == PhysicsQueryShape::Capsule)
+                rotation = rotation * PxQuat(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f));
+
+            return PxTransform(PxVec3(query.Origin.x, query.Origin.y, query.Origin.z), rotation);
+        }
+
+        static PxGeometryHolder GetQueryGeometry(const PhysicsQuery& query)
+        {
+            switch (query.Shape)
+            {
+                case PhysicsQueryShape::Box:     return PxBoxGeometry(query.Size.x, query.Size.y, query.Size.z);
+                case PhysicsQueryShape::Capsule: return PxCapsuleGeometry(query.Size.x, query.Size.y);
+                default:                         return PxSphereGeometry(query.Size.x);
+            }
+        }
+
+        template<typename HitType>
+        static bool WriteHit(const HitType& hit, PhysicsQueryHit& outHit)
+        {
+            if (!hit.actor || !hit.actor->userData)
+                return false;
+
+            outHit.EntityID = (uint64_t)hit.actor->userData;
+            if constexpr (std::is_same_v<HitType, PxOverlapHit>)
+            {
+                outHit.Position = glm::vec3(0.0f);
+                outHit.Normal = glm::vec3(0.0f);
+                outHit.Distance = 0.0f;
+            }
+            else
+            {
+                outHit.Position = glm::vec3(hit.position.x, hit.position.y, hit.position.z);
+                outHit.Normal = glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z);
+                outHit.Distance = hit.distance;
+            }
+            return true;
+        }
+
+        // Each thread keeps its own touch buffers, batches never allocate once they've warmed up
+        template<typename HitType, typename QueryFunc>
+        static uint32_t CollectHits(uint32_t maxHits, bool multiHit, QueryFunc&& runQuery, PhysicsQueryHit* hits)
+        {
+            thread_local std::vector<HitType> touches;
+            if (multiHit && touches.size() < maxHits)
+                touches.resize(maxHits);
+
+            PxHitBuffer<HitType> buffer(multiHit ? touches.data() : nullptr, multiHit ? maxHits : 0);
+            if (!runQuery(buffer))
+                return 0;
+
+            uint32_t found = 0;
+            if (buffer.hasBlock && WriteHit(buffer.block, hits[found]))
+                found++;
+
+            for (PxU32 i = 0; i < buffer.nbTouches && found < maxHits; i++)
+            {
+                if (WriteHit(buffer.touches[i], hits[found]))
+                    found++;
+            }
+
+            return found;
+        }
+    }
+
     void PhysicsSystem::Init()
     {
         s_Foundation = PxCreateFoundation(PX_PHYSICS_VERSION, s_Allocator, s_ErrorCallback);
@@ -106,12 +220,252 @@ namespace RXNEngine {
     {
         OPTICK_EVENT();
 
+        s_ContactEvents.clear();
+
         if (!s_Scene) return;
 
         s_Scene->simulate(dt);
         s_Scene->fetchResults(true);
     }
 
+    void PhysicsContactListener::onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 nbPairs)
+    {
+        // A removed actor's pointer dangles, only the survivor is told it lost the contact and the other side reads as 0
+        bool removedA = pairHeader.flags & PxContactPairHeaderFlag::eREMOVED_ACTOR_0;
+        bool removedB = pairHeader.flags & PxContactPairHeaderFlag::eREMOVED_ACTOR_1;
+
+        PxRigidActor* actorA = pairHeader.actors[0];
+        PxRigidActor* actorB = pairHeader.actors[1];
+
+        if ((!removedA && !actorA) || (!removedB && !actorB)) return;
+
+        uint64_t entityA = removedA ? 0 : (uint64_t)actorA->userData;
+        uint64_t entityB = removedB ? 0 : (uint64_t)actorB->userData;
+
+        PxContactPairPoint points[s_MaxContactPoints];
+
+        for (PxU32 i = 0; i < nbPairs; i++)
+        {
+            const PxContactPair& cp = pairs[i];
+
+            PhysicsContactType type;
+            if ((cp.events & PxPairFlag::eNOTIFY_TOUCH_FOUND) && !removedA && !removedB)
+                type = PhysicsContactType::CollisionEnter;
+            else if (cp.events & PxPairFlag::eNOTIFY_TOUCH_LOST)
+                type = PhysicsContactType::CollisionExit;
+            else
+                continue;
+
+            if (removedA || removedB)
+            {
+                if (!removedA)
+                    PhysicsSystem::s_ContactEvents.push_back({ entityA, entityB, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), type });
+                if (!removedB)
+                    PhysicsSystem::s_ContactEvents.push_back({ entityB, entityA, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), type });
+                continue;
+            }
+
+            // The normal points from B to A, so A's view of the contact is the reported one and B's is mirrored
+            glm::vec3 point(0.0f), normal(0.0f), impulse(0.0f);
+            PxU32 count = cp.contactCount > 0 ? cp.extractContacts(points, s_MaxContactPoints) : 0;
+            for (PxU32 p = 0; p < count; p++)
+            {
+                point += glm::vec3(points[p].position.x, points[p].position.y, points[p].position.z);
+                normal += glm::vec3(points[p].normal.x, points[p].normal.y, points[p].normal.z);
+                impulse += glm::vec3(points[p].impulse.x, points[p].impulse.y, points[p].impulse.z);
+            }
+
+            if (count > 0)
+                point /= (float)count;
+            if (glm::dot(normal, normal) > 0.0f)
+                normal = glm::normalize(normal);
+
+            PhysicsSystem::s_ContactEvents.push_back({ entityA, entityB, point, normal, impulse, type });
+            PhysicsSystem::s_ContactEvents.push_back({ entityB, entityA, point, -normal, -impulse, type });
+        }
+    }
+
+    void PhysicsContactListener::onTrigger(PxTriggerPair* pairs, PxU32 count)
+    {
+        for (PxU32 i = 0; i < count; i++)
+        {
+            PxTriggerPair& tp = pairs[i];
+
+            // Same as contacts, the side whose shape was removed is skipped but the survivor still gets its exit
+            bool removedTrigger = tp.flags & PxTriggerPairFlag::eREMOVED_SHAPE_TRIGGER;
+            bool removedOther = tp.flags & PxTriggerPairFlag::eREMOVED_SHAPE_OTHER;
+
+            PxRigidActor* triggerActor = tp.triggerActor;
+            PxRigidActor* otherActor = tp.otherActor;
+
+            if ((!removedTrigger && !triggerActor) || (!removedOther && !otherActor)) continue;
+
+            uint64_t triggerEntity = removedTrigger ? 0 : (uint64_t)triggerActor->userData;
+            uint64_t otherEntity = removedOther ? 0 : (uint64_t)otherActor->userData;
+
+            PhysicsContactType type;
+            if ((tp.status & PxPairFlag::eNOTIFY_TOUCH_FOUND) && !removedTrigger && !removedOther)
+                type = PhysicsContactType::TriggerEnter;
+            else if (tp.status & PxPairFlag::eNOTIFY_TOUCH_LOST)
+                type = PhysicsContactType::TriggerExit;
+            else
+                continue;
+
+            if (!removedTrigger)
+                PhysicsSystem::s_ContactEvents.push_back({ triggerEntity, otherEntity, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), type });
+            if (!removedOther)
+                PhysicsSystem::s_ContactEvents.push_back({ otherEntity, triggerEntity, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), type });
+        }
+    }
+
+    uint32_t PhysicsSystem::RaycastBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel)
+    {
+        return RunQueries(QueryType::Raycast, queries, count, hits, hitCapacity, hitCounts, parallel);
+    }
+
+    uint32_t PhysicsSystem::SweepBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel)
+    {
+        return RunQueries(QueryType::Sweep, queries, count, hits, hitCapacity, hitCounts, parallel);
+    }
+
+    uint32_t PhysicsSystem::OverlapBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel)
+    {
+        return RunQueries(QueryType::Overlap, queries, count, hits, hitCapacity, hitCounts, parallel);
+    }
+
+    uint32_t PhysicsSystem::RunQueries(QueryType type, const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel)
+    {
+        OPTICK_EVENT();
+
+        if (count == 0)
+            return 0;
+
+        std::fill(hitCounts, hitCounts + count, 0u);
+
+        uint64_t requiredHits = 0;
+        for (uint32_t i = 0; i < count; i++)
+            requiredHits += queries[i].MaxHits;
+
+        if (requiredHits > hitCapacity)
+        {
+            RXN_CORE_ERROR("Physics query batch needs room for {0} hits, the buffer holds {1}", requiredHits, hitCapacity);
+            return 0;
+        }
+
+        if (!s_Scene)
+            return 0;
+
+        // Hit ranges are laid out up front so chunks can write their results without coordinating
+        thread_local std::vector<uint32_t> firstHits;
+        firstHits.resize(count);
+        uint32_t firstHit = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            firstHits[i] = firstHit;
+            firstHit += queries[i].MaxHits;
+        }
+
+        const uint32_t* firstHitData = firstHits.data();
+        auto runRange = [=](uint32_t begin, uint32_t end)
+            {
+                // Readers share the lock, each chunk takes it once rather than once per query
+                s_Scene->lockRead();
+                for (uint32_t i = begin; i < end; i++)
+                    hitCounts[i] = RunQuery(type, queries[i], hits + firstHitData[i]);
+                s_Scene->unlockRead();
+            };
+
+        // Script updates run as jobs, on workers or on the main thread while it waits, a batch issued from one can't
+        // wait on the job system
+        uint32_t chunkCount = std::min(JobSystem::GetThreadCount(), (count + s_MinQueryBatchSize - 1) / s_MinQueryBatchSize);
+        if (!parallel || chunkCount <= 1 || !JobSystem::IsMainThread() || JobSystem::IsInsideJob())
+        {
+            runRange(0, count);
+        }
+        else
+        {
+            uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+            JobSystem::Dispatch(chunkCount, 1, [&runRange, count, chunkSize](JobDispatchArgs args)
+                {
+                    OPTICK_EVENT("Physics Query Batch");
+                    uint32_t begin = args.JobIndex * chunkSize;
+                    uint32_t end = std::min(begin + chunkSize, count);
+                    if (begin < end)
+                        runRange(begin, end);
+                });
+            JobSystem::Wait();
+        }
+
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < count; i++)
+            total += hitCounts[i];
+
+        return total;
+    }
+
+    uint32_t PhysicsSystem::RunQuery(QueryType type, const PhysicsQuery& query, PhysicsQueryHit* hits)
+    {
+        if (query.MaxHits == 0)
+            return 0;
+
+        if (type == QueryType::Sweep && query.Shape == PhysicsQueryShape::Ray)
+            type = QueryType::Raycast;
+        else if (type == QueryType::Overlap && query.Shape == PhysicsQueryShape::Ray)
+            return 0;
+
+        // Overlaps have no closest hit, they always collect touches
+        bool multiHit = query.MaxHits > 1 || type == QueryType::Overlap;
+        QueryFilter filter(query, multiHit ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK);
+        PxQueryFilterData filterData(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER);
+
+        PxVec3 direction(query.Direction.x, query.Direction.y, query.Direction.z);
+        if (type != QueryType::Overlap)
+        {
+            if (direction.magnitudeSquared() <= 0.0f)
+                return 0;
+            direction.normalize();
+        }
+
+        uint32_t found = 0;
+        switch (type)
+        {
+            case QueryType::Raycast:
+            {
+                PxVec3 origin(query.Origin.x, query.Origin.y, query.Origin.z);
+                found = CollectHits<PxRaycastHit>(query.MaxHits, multiHit, [&](PxRaycastCallback& buffer)
+                    {
+                        return s_Scene->raycast(origin, direction, query.MaxDistance, buffer, PxHitFlag::eDEFAULT, filterData, &filter);
+                    }, hits);
+                break;
+            }
+            case QueryType::Sweep:
+            {
+                PxGeometryHolder geometry = GetQueryGeometry(query);
+                PxTransform pose = GetQueryPose(query);
+                found = CollectHits<PxSweepHit>(query.MaxHits, multiHit, [&](PxSweepCallback& buffer)
+                    {
+                        return s_Scene->sweep(geometry.any(), pose, direction, query.MaxDistance, buffer, PxHitFlag::eDEFAULT, filterData, &filter);
+                    }, hits);
+                break;
+            }
+            case QueryType::Overlap:
+            {
+                PxGeometryHolder geometry = GetQueryGeometry(query);
+                PxTransform pose = GetQueryPose(query);
+                found = CollectHits<PxOverlapHit>(query.MaxHits, multiHit, [&](PxOverlapCallback& buffer)
+                    {
+                        return s_Scene->overlap(geometry.any(), pose, buffer, filterData, &filter);
+                    }, hits);
+                break;
+            }
+        }
+
+        if (found > 1 && type != QueryType::Overlap)
+            std::sort(hits, hits + found, [](const PhysicsQueryHit& a, const PhysicsQueryHit& b) { return a.Distance < b.Distance; });
+
+        return found;
+    }
+
     void PhysicsSystem::LockRead() { if (s_Scene) s_Scene->lockRead(); }
     void PhysicsSystem::UnlockRead() { if (s_Scene) s_Scene->unlockRead(); }
     void PhysicsSystem::LockWrite() { if (s_Scene) s_Scene->lockWrite(); }
@@ -1,11 +1,63 @@
 #pragma once
 
 #include "RXNEngine/Core/Base.h"
-#include "RXNEngine/Scripting/ScriptEngine.h"
 #include <PxPhysicsAPI.h>
+#include <glm/glm.hpp>
+
+#include <vector>
 
 namespace RXNEngine {
 
+    enum class PhysicsContactType : uint32_t
+    {
+        CollisionEnter = 0, CollisionExit,
+        TriggerEnter, TriggerExit
+    };
+
+    // One per entity and pair, both sides of a contact get their own event. Point and Normal are the average contact
+    // point and the normal pushing the entity away from the other, Impulse is what the entity received over the step
+    struct PhysicsContactEvent
+    {
+        uint64_t EntityID;
+        uint64_t OtherID;
+        glm::vec3 Point;
+        glm::vec3 Normal;
+        glm::vec3 Impulse;
+        PhysicsContactType Type;
+    };
+
+    enum class PhysicsQueryShape : uint32_t
+    {
+        Ray = 0, Sphere, Box, Capsule
+    };
+
+    // Mirrored by PhysicsQuery in RXNScriptCore/Physics/Physics.cs. Size is the radius for spheres, the half extents
+    // for boxes and radius and half height for capsules, which stand along Y like capsule colliders. Rotation is a
+    // quaternion (x, y, z, w), all zero means identity. Direction and MaxDistance are ignored by overlaps
+    struct PhysicsQuery
+    {
+        glm::vec3 Origin;
+        float MaxDistance;
+        glm::vec3 Direction;
+        uint32_t LayerMask;
+        glm::vec4 Rotation;
+        glm::vec3 Size;
+        PhysicsQueryShape Shape;
+        uint64_t IgnoreEntityID;
+        // 1 returns the closest blocking hit, more returns every hit up to this many sorted by distance
+        uint32_t MaxHits;
+        uint32_t Padding;
+    };
+
+    // Overlaps only fill EntityID
+    struct PhysicsQueryHit
+    {
+        uint64_t EntityID;
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        float Distance;
+    };
+
     class PhysicsSystem
     {
     public:
@@ -20,11 +72,29 @@ namespace RXNEngine {
         static void DestroyScene();
         static void Update(float dt);
 
+        // Everything the last Update() reported, valid until the next one
+        static const std::vector<PhysicsContactEvent>& GetContactEvents() { return s_ContactEvents; }
+
+        // Run a whole array of queries under one read lock. Query i owns MaxHits consecutive entries of hits, starting
+        // after the entries of the queries before it, and writes how many it used to hitCounts[i]. Returns the total
+        // number of hits. Large batches issued from the main thread can be split across the job system
+        static uint32_t RaycastBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel = false);
+        static uint32_t SweepBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel = false);
+        static uint32_t OverlapBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel = false);
+
+        // Bit set in a shape's query filter data, what LayerMask is tested against
+        static uint32_t GetLayerBit(uint32_t layer) { return 1u << (layer & 31u); }
+
         static void LockRead();
         static void UnlockRead();
         static void LockWrite();
         static void UnlockWrite();
 
+    private:
+        enum class QueryType { Raycast, Sweep, Overlap };
+
+        static uint32_t RunQueries(QueryType type, const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, bool parallel);
+        static uint32_t RunQuery(QueryType type, const PhysicsQuery& query, PhysicsQueryHit* hits);
     private:
         static physx::PxFoundation* s_Foundation;
         static physx::PxPhysics* s_Physics;
@@ -35,6 +105,10 @@ namespace RXNEngine {
 
         static physx::PxDefaultAllocator s_Allocator;
         static physx::PxDefaultErrorCallback s_ErrorCallback;
+
+        static std::vector<PhysicsContactEvent> s_ContactEvents;
+
+        friend class PhysicsContactListener;
     };
 
     class PhysicsContactListener : public physx::PxSimulationEventCallback
@@ -45,61 +119,8 @@ namespace RXNEngine {
         virtual void onSleep(physx::PxActor** actors, physx::PxU32 count) override {}
         virtual void onAdvance(const physx::PxRigidBody* const* bodyBuffer, const physx::PxTransform* poseBuffer, const physx::PxU32 count) override {}
 
-        virtual void onContact(const physx::PxContactPairHeader& pairHeader, const physx::PxContactPair* pairs, physx::PxU32 nbPairs) override
-        {
-            physx::PxRigidActor* actorA = (physx::PxRigidActor*)pairHeader.actors[0];
-            physx::PxRigidActor* actorB = (physx::PxRigidActor*)pairHeader.actors[1];
-
-            if (!actorA || !actorB) return;
-
-            uint64_t entityA = (uint64_t)actorA->userData;
-            uint64_t entityB = (uint64_t)actorB->userData;
-
-            for (physx::PxU32 i = 0; i < nbPairs; i++)
-            {
-                const physx::PxContactPair& cp = pairs[i];
-
-                if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND)
-                {
-                    ScriptEngine::OnCollisionEnter(entityA, entityB);
-                    ScriptEngine::OnCollisionEnter(entityB, entityA);
-                }
-                else if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_LOST)
-                {
-                    ScriptEngine::OnCollisionExit(entityA, entityB);
-                    ScriptEngine::OnCollisionExit(entityB, entityA);
-                }
-            }
-        }
-
-        virtual void onTrigger(physx::PxTriggerPair* pairs, physx::PxU32 count) override
-        {
-            for (physx::PxU32 i = 0; i < count; i++)
-            {
-                physx::PxTriggerPair& tp = pairs[i];
-
-                if (tp.flags & (physx::PxTriggerPairFlag::eREMOVED_SHAPE_TRIGGER | physx::PxTriggerPairFlag::eREMOVED_SHAPE_OTHER))
-                    continue;
-
-                physx::PxRigidActor* triggerActor = (physx::PxRigidActor*)tp.triggerActor;
-                physx::PxRigidActor* otherActor = (physx::PxRigidActor*)tp.otherActor;
-
-                if (!triggerActor || !otherActor) continue;
-
-                uint64_t triggerEntity = (uint64_t)triggerActor->userData;
-                uint64_t otherEntity = (uint64_t)otherActor->userData;
-
-                if (tp.status & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND)
-                {
-                    ScriptEngine::OnTriggerEnter(triggerEntity, otherEntity);
-                    ScriptEngine::OnTriggerEnter(otherEntity, triggerEntity);
-                }
-                else if (tp.status & physx::PxPairFlag::eNOTIFY_TOUCH_LOST)
-                {
-                    ScriptEngine::OnTriggerExit(triggerEntity, otherEntity);
-                    ScriptEngine::OnTriggerExit(otherEntity, triggerEntity);
-                }
-            }
-        }
+        // Run inside fetchResults(), they only record the events. Scripts get them once the step is done
+        virtual void onContact(const physx::PxContactPairHeader& pairHeader, const physx::PxContactPair* pairs, physx::PxU32 nbPairs) override;
+        virtual void onTrigger(physx::PxTriggerPair* pairs, physx::PxU32 count) override;
     };
 }
\ No newline at end of file
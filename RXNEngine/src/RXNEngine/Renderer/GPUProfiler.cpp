@@ -0,0 +1,203 @@
+#include "rxnpch.h"
+#include "GPUProfiler.h"
+#include "RXNEngine/Renderer/GraphicsAPI/TimerQuery.h"
+
+#include <chrono>
+#include <fstream>
+
+namespace RXNEngine {
+
+    // Query sets in flight per pass, results are read back this many frames after they were issued
+    static constexpr uint32_t s_QueryFrameCount = 3;
+    static constexpr uint32_t s_SampleCount = 120;
+    static constexpr uint32_t s_InvalidPass = ~0u;
+
+    struct TimingSamples
+    {
+        std::array<float, s_SampleCount> Samples = {};
+        uint32_t Count = 0;
+        uint32_t Next = 0;
+        float Last = 0.0f;
+
+        void Add(float ms)
+        {
+            Samples[Next] = ms;
+            Next = (Next + 1) % s_SampleCount;
+            Count = std::min(Count + 1, s_SampleCount);
+            Last = ms;
+        }
+
+        TimingStatistics Resolve() const
+        {
+            TimingStatistics stats;
+            if (Count == 0)
+                return stats;
+
+            stats.LastMs = Last;
+            stats.MinMs = std::numeric_limits<float>::max();
+            stats.MaxMs = 0.0f;
+
+            float total = 0.0f;
+            for (uint32_t i = 0; i < Count; i++)
+            {
+                stats.MinMs = std::min(stats.MinMs, Samples[i]);
+                stats.MaxMs = std::max(stats.MaxMs, Samples[i]);
+                total += Samples[i];
+            }
+            stats.AvgMs = total / Count;
+
+            return stats;
+        }
+    };
+
+    struct PassTimer
+    {
+        std::string Name;
+
+        std::array<Ref<TimerQuery>, s_QueryFrameCount> Queries;
+        std::array<bool, s_QueryFrameCount> Pending = {};
+
+        std::chrono::steady_clock::time_point CPUStart;
+
+        TimingSamples GPU;
+        TimingSamples CPU;
+    };
+
+    struct GPUProfilerData
+    {
+        std::vector<PassTimer> Passes;
+        std::unordered_map<std::string, uint32_t> PassIndices;
+
+        uint64_t FrameIndex = 0;
+        bool Enabled = true;
+    };
+
+    static GPUProfilerData* s_Data = nullptr;
+
+    void GPUProfiler::Init()
+    {
+        s_Data = new GPUProfilerData();
+    }
+
+    void GPUProfiler::Shutdown()
+    {
+        delete s_Data;
+        s_Data = nullptr;
+    }
+
+    void GPUProfiler::BeginFrame()
+    {
+        OPTICK_EVENT();
+
+        if (!s_Data || !s_Data->Enabled)
+            return;
+
+        s_Data->FrameIndex++;
+        uint32_t currentSet = s_Data->FrameIndex % s_QueryFrameCount;
+
+        for (auto& pass : s_Data->Passes)
+        {
+            for (uint32_t i = 0; i < s_QueryFrameCount; i++)
+            {
+                if (!pass.Pending[i] || !pass.Queries[i]->IsResultAvailable())
+                    continue;
+
+                pass.GPU.Add(pass.Queries[i]->GetElapsedTime() / 1000000.0f);
+                pass.Pending[i] = false;
+            }
+
+            // Still not resolved after a full round trip, drop it instead of stalling on it
+            pass.Pending[currentSet] = false;
+        }
+    }
+
+    uint32_t GPUProfiler::BeginPass(const std::string& name)
+    {
+        if (!s_Data || !s_Data->Enabled)
+            return s_InvalidPass;
+
+        uint32_t passIndex;
+        auto it = s_Data->PassIndices.find(name);
+        if (it == s_Data->PassIndices.end())
+        {
+            passIndex = (uint32_t)s_Data->Passes.size();
+            s_Data->PassIndices[name] = passIndex;
+
+            PassTimer& pass = s_Data->Passes.emplace_back();
+            pass.Name = name;
+            for (auto& query : pass.Queries)
+                query = TimerQuery::Create();
+        }
+        else
+        {
+            passIndex = it->second;
+        }
+
+        PassTimer& pass = s_Data->Passes[passIndex];
+        pass.Queries[s_Data->FrameIndex % s_QueryFrameCount]->Begin();
+        pass.CPUStart = std::chrono::steady_clock::now();
+
+        return passIndex;
+    }
+
+    void GPUProfiler::EndPass(uint32_t passIndex)
+    {
+        if (!s_Data || passIndex == s_InvalidPass || passIndex >= s_Data->Passes.size())
+            return;
+
+        PassTimer& pass = s_Data->Passes[passIndex];
+
+        uint32_t currentSet = s_Data->FrameIndex % s_QueryFrameCount;
+        pass.Queries[currentSet]->End();
+        pass.Pending[currentSet] = true;
+
+        std::chrono::duration<float, std::milli> cpuTime = std::chrono::steady_clock::now() - pass.CPUStart;
+        pass.CPU.Add(cpuTime.count());
+    }
+
+    void GPUProfiler::SetEnabled(bool enabled)
+    {
+        if (s_Data)
+            s_Data->Enabled = enabled;
+    }
+
+    bool GPUProfiler::IsEnabled()
+    {
+        return s_Data && s_Data->Enabled;
+    }
+
+    std::vector<PassTimingStatistics> GPUProfiler::GetPassStatistics()
+    {
+        std::vector<PassTimingStatistics> result;
+        if (!s_Data)
+            return result;
+
+        result.reserve(s_Data->Passes.size());
+        for (const auto& pass : s_Data->Passes)
+            result.push_back({ pass.Name, pass.GPU.Resolve(), pass.CPU.Resolve() });
+
+        return result;
+    }
+
+    bool GPUProfiler::ExportCSV(const std::string& filepath)
+    {
+        std::ofstream out(filepath);
+        if (!out.is_open())
+        {
+            RXN_CORE_ERROR("Failed to export pass timings: {0}", filepath);
+            return false;
+        }
+
+        out << "Pass,GPU Last (ms),GPU Min (ms),GPU Avg (ms),GPU Max (ms),CPU Last (ms),CPU Min (ms),CPU Avg (ms),CPU Max (ms)\n";
+        for (const auto& pass : GetPassStatistics())
+        {
+            out << pass.Name << ','
+                << pass.GPU.LastMs << ',' << pass.GPU.MinMs << ',' << pass.GPU.AvgMs << ',' << pass.GPU.MaxMs << ','
+                << pass.CPU.LastMs << ',' << pass.CPU.MinMs << ',' << pass.CPU.AvgMs << ',' << pass.CPU.MaxMs << '\n';
+        }
+
+        RXN_CORE_INFO("Exported pass timings to {0}", filepath);
+        return true;
+    }
+
+}
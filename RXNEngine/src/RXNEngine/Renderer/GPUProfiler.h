@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RXNEngine/Core/Base.h"
+
+#include <string>
+#include <vector>
+
+namespace RXNEngine {
+
+    struct TimingStatistics
+    {
+        float LastMs = 0.0f;
+        float MinMs = 0.0f;
+        float AvgMs = 0.0f;
+        float MaxMs = 0.0f;
+    };
+
+    struct PassTimingStatistics
+    {
+        std::string Name;
+        TimingStatistics GPU;
+        TimingStatistics CPU;
+    };
+
+    // Times render passes on both the GPU (timer queries, read back a few frames later) and the CPU,
+    // keeping a rolling window of samples per pass
+    class GPUProfiler
+    {
+    public:
+        static void Init();
+        static void Shutdown();
+
+        static void BeginFrame();
+
+        static uint32_t BeginPass(const std::string& name);
+        static void EndPass(uint32_t passIndex);
+
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+
+        static std::vector<PassTimingStatistics> GetPassStatistics();
+        static bool ExportCSV(const std::string& filepath);
+    };
+
+    class GPUProfileScope
+    {
+    public:
+        GPUProfileScope(const std::string& name) : m_PassIndex(GPUProfiler::BeginPass(name)) {}
+        ~GPUProfileScope() { GPUProfiler::EndPass(m_PassIndex); }
+    private:
+        uint32_t m_PassIndex;
+    };
+
+}
@@ -3,6 +3,7 @@
 
 #include "RXNEngine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Null/NullBuffer.h"
 
 namespace RXNEngine {
 
@@ -12,6 +13,7 @@ namespace RXNEngine {
         {
             case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
             case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(size);
+            case RendererAPI::API::Null:    return CreateRef<NullVertexBuffer>(size);
         }
 
         RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -24,6 +26,7 @@ namespace RXNEngine {
         {
             case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
             case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(vertices, size);
+            case RendererAPI::API::Null:    return CreateRef<NullVertexBuffer>(vertices, size);
         }
 
         RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -36,6 +39,7 @@ namespace RXNEngine {
         {
             case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
             case RendererAPI::API::OpenGL:  return CreateRef<OpenGLIndexBuffer>(indices, count);
+            case RendererAPI::API::Null:    return CreateRef<NullIndexBuffer>(indices, count);
         }
 
         RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -3,6 +3,7 @@
 
 #include "RXNEngine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLContext.h"
+#include "Platform/Null/NullContext.h"
 
 namespace RXNEngine {
 
@@ -16,6 +17,9 @@ namespace RXNEngine {
 
 			case RendererAPI::API::OpenGL:
 				return CreateScope<OpenGLContext>(static_cast<SDL_Window*>(window));
+
+			case RendererAPI::API::Null:
+				return CreateScope<NullContext>();
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -0,0 +1,23 @@
+#include "rxnpch.h"
+#include "OcclusionQuery.h"
+
+#include "RXNEngine/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLOcclusionQuery.h"
+#include "Platform/Null/NullOcclusionQuery.h"
+
+namespace RXNEngine {
+
+	Ref<OcclusionQuery> OcclusionQuery::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLOcclusionQuery>();
+			case RendererAPI::API::Null:    return CreateRef<NullOcclusionQuery>();
+		}
+
+		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
\ No newline at end of file
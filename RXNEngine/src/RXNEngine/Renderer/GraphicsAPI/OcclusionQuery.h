@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RXNEngine/Core/Base.h"
+
+namespace RXNEngine {
+
+	// Counts the samples that pass the depth test between Begin and End. Queries of this kind can't be nested
+	class OcclusionQuery
+	{
+	public:
+		virtual ~OcclusionQuery() {}
+
+		virtual void Begin() = 0;
+		virtual void End() = 0;
+
+		virtual bool IsResultAvailable() const = 0;
+		// Only valid once IsResultAvailable() returns true
+		virtual uint64_t GetSampleCount() const = 0;
+
+		static Ref<OcclusionQuery> Create();
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "rxnpch.h"
+#include "PixelReadback.h"
+
+#include "RXNEngine/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLPixelReadback.h"
+#include "Platform/Null/NullPixelReadback.h"
+
+namespace RXNEngine {
+
+	Ref<PixelReadback> PixelReadback::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLPixelReadback>();
+			case RendererAPI::API::Null:    return CreateRef<NullPixelReadback>();
+		}
+
+		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RXNEngine/Core/Base.h"
+
+namespace RXNEngine {
+
+	// Reads single integer pixels back from the GPU without stalling, results arrive a frame or two later
+	class PixelReadback
+	{
+	public:
+		virtual ~PixelReadback() {}
+
+		// Reads from the currently bound render target
+		virtual void Request(uint32_t attachmentIndex, int x, int y) = 0;
+
+		// Returns the newest finished request that hasn't been returned yet
+		virtual bool Poll(int& outValue) = 0;
+		virtual bool IsPending() const = 0;
+
+		static Ref<PixelReadback> Create();
+	};
+
+}
@@ -3,6 +3,7 @@
 
 #include "RXNEngine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Null/NullShader.h"
 
 namespace RXNEngine {
 
@@ -12,6 +13,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filepath);
+			case RendererAPI::API::Null:    return CreateRef<NullShader>(filepath);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -24,6 +26,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+			case RendererAPI::API::Null:    return CreateRef<NullShader>(name, vertexSrc, fragmentSrc);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
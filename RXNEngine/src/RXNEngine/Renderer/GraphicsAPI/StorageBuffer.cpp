@@ -0,0 +1,23 @@
+#include "rxnpch.h"
+#include "StorageBuffer.h"
+
+#include "RXNEngine/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLStorageBuffer.h"
+#include "Platform/Null/NullStorageBuffer.h"
+
+namespace RXNEngine {
+
+	Ref<StorageBuffer> StorageBuffer::Create(uint32_t size, uint32_t binding)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLStorageBuffer>(size, binding);
+			case RendererAPI::API::Null:    return CreateRef<NullStorageBuffer>(size, binding);
+		}
+
+		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
\ No newline at end of file
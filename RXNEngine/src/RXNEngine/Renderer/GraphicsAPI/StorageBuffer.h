@@ -0,0 +1,17 @@
+#pragma once
+
+#include "RXNEngine/Core/Base.h"
+
+namespace RXNEngine {
+
+	class StorageBuffer
+	{
+	public:
+		virtual ~StorageBuffer() {}
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		// Zero initialized
+		static Ref<StorageBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
\ No newline at end of file
@@ -4,15 +4,149 @@
 #include "RXNEngine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 #include "Platform/OpenGL/OpenGLCubemap.h"
+#include "Platform/Null/NullTexture.h"
+
+#include <stb_image.h>
 
 namespace RXNEngine {
 
+	TextureImage::~TextureImage()
+	{
+		if (Pixels)
+			stbi_image_free(Pixels);
+	}
+
+	TextureImage::TextureImage(TextureImage&& other) noexcept
+		: Width(other.Width), Height(other.Height), Channels(other.Channels), HDR(other.HDR), Pixels(other.Pixels),
+		Compression(other.Compression), MipCount(other.MipCount), FirstMip(other.FirstMip), CompressedData(std::move(other.CompressedData))
+	{
+		other.Pixels = nullptr;
+	}
+
+	TextureImage& TextureImage::operator=(TextureImage&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (Pixels)
+				stbi_image_free(Pixels);
+
+			Width = other.Width;
+			Height = other.Height;
+			Channels = other.Channels;
+			HDR = other.HDR;
+			Pixels = other.Pixels;
+			other.Pixels = nullptr;
+
+			Compression = other.Compression;
+			MipCount = other.MipCount;
+			FirstMip = other.FirstMip;
+			CompressedData = std::move(other.CompressedData);
+		}
+		return *this;
+	}
+
+	uint32_t TextureImage::GetRowSize() const
+	{
+		if (IsCompressed())
+			return (GetMipWidth(FirstMip) + 3) / 4 * GetBlockSize(Compression) / 4;
+
+		return GetMipWidth(FirstMip) * Channels * (HDR ? sizeof(float) : sizeof(uint8_t));
+	}
+
+	uint64_t TextureImage::GetSize() const
+	{
+		if (IsCompressed())
+			return CompressedData.size();
+
+		return (uint64_t)GetRowSize() * GetMipHeight(FirstMip);
+	}
+
+	uint64_t TextureImage::GetMipOffset(uint32_t level) const
+	{
+		uint64_t offset = 0;
+		for (uint32_t i = FirstMip; i < level; i++)
+			offset += GetMipSize(i);
+		return offset;
+	}
+
+	uint32_t TextureImage::GetMipSize(uint32_t level) const
+	{
+		uint32_t width = GetMipWidth(level);
+		uint32_t height = GetMipHeight(level);
+
+		if (IsCompressed())
+			return ((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(Compression);
+
+		return width * height * Channels * (HDR ? sizeof(float) : sizeof(uint8_t));
+	}
+
+	uint32_t TextureImage::GetBlockSize(TextureCompression compression)
+	{
+		switch (compression)
+		{
+			case TextureCompression::None: return 0;
+			case TextureCompression::BC1:  return 8;
+			case TextureCompression::BC3:  return 16;
+			case TextureCompression::BC5:  return 16;
+		}
+
+		RXN_CORE_ASSERT(false);
+		return 0;
+	}
+
+	bool TextureImage::Decode(const std::string& path, TextureImage& outImage)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(1);
+
+		outImage = TextureImage();
+		if (stbi_is_hdr(path.c_str()))
+		{
+			outImage.Pixels = stbi_loadf(path.c_str(), &width, &height, &channels, 3);
+			outImage.Channels = 3;
+			outImage.HDR = true;
+		}
+		else
+		{
+			outImage.Pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+			outImage.Channels = 4;
+		}
+
+		if (!outImage.Pixels)
+			return false;
+
+		outImage.Width = width;
+		outImage.Height = height;
+		return true;
+	}
+
+	bool TextureImage::Decode(const void* data, size_t size, TextureImage& outImage)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(1);
+
+		outImage = TextureImage();
+		if (!stbi_info_from_memory((const stbi_uc*)data, (int)size, &width, &height, &channels))
+			return false;
+
+		int desiredChannels = channels == 3 ? 3 : 4;
+		outImage.Pixels = stbi_load_from_memory((const stbi_uc*)data, (int)size, &width, &height, &channels, desiredChannels);
+		if (!outImage.Pixels)
+			return false;
+
+		outImage.Width = width;
+		outImage.Height = height;
+		outImage.Channels = desiredChannels;
+		return true;
+	}
+
 	Ref<Texture2D> Texture2D::Create(const TextureSpecification& specification)
 	{
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(specification);
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(specification);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -26,6 +160,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(path);
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(path);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -38,6 +173,20 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(data, size);
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(data, size);
+		}
+
+		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<Texture2D> Texture2D::CreatePending(const std::string& path)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(path, false);
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(path, false);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -64,6 +213,11 @@ namespace RXNEngine {
 				}
 				return s_WhiteTexture;
 			}
+			case RendererAPI::API::Null:
+			{
+				static Ref<Texture2D> s_WhiteTexture = CreateRef<NullTexture2D>(TextureSpecification());
+				return s_WhiteTexture;
+			}
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -89,6 +243,11 @@ namespace RXNEngine {
 				}
 				return s_BlackTexture;
 			}
+			case RendererAPI::API::Null:
+			{
+				static Ref<Texture2D> s_BlackTexture = CreateRef<NullTexture2D>(TextureSpecification());
+				return s_BlackTexture;
+			}
 		}
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
@@ -114,6 +273,11 @@ namespace RXNEngine {
 				}
 				return s_BlueTexture;
 			}
+			case RendererAPI::API::Null:
+			{
+				static Ref<Texture2D> s_BlueTexture = CreateRef<NullTexture2D>(TextureSpecification());
+				return s_BlueTexture;
+			}
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -126,6 +290,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLCubemap>(paths);
+			case RendererAPI::API::Null:    return CreateRef<NullCubemap>(paths);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -138,6 +303,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLCubemap>(path);
+			case RendererAPI::API::Null:    return CreateRef<NullCubemap>(path);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
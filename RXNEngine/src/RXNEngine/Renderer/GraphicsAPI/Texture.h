@@ -3,6 +3,8 @@
 #include "RXNEngine/Core/Base.h"
 
 #include <string>
+#include <vector>
+#include <algorithm>
 
 
 namespace RXNEngine {
@@ -13,6 +15,7 @@ namespace RXNEngine {
 		R8,
 		RGB8,
 		RGBA8,
+		RGBA16F,
 		RGBA32F
 	};
 
@@ -22,6 +25,70 @@ namespace RXNEngine {
 		uint32_t Height = 1;
 		ImageFormat Format = ImageFormat::RGBA8;
 		bool GenerateMips = true;
+		// Levels of storage for textures created from a specification, 0 allocates the full chain
+		uint32_t MipLevels = 1;
+		bool ClampToEdge = false;
+	};
+
+	enum class ImageAccess
+	{
+		ReadOnly = 0,
+		WriteOnly,
+		ReadWrite
+	};
+
+	// 4x4 block formats produced by the texture cooker
+	enum class TextureCompression
+	{
+		None = 0,
+		BC1,	// RGB
+		BC3,	// RGBA
+		BC5		// Two channel, normal maps
+	};
+
+	// Pixels decoded on the CPU. Safe to produce on any thread, uploading them is left to Texture2D::UploadImage
+	struct TextureImage
+	{
+		TextureImage() = default;
+		~TextureImage();
+
+		TextureImage(const TextureImage&) = delete;
+		TextureImage& operator=(const TextureImage&) = delete;
+		TextureImage(TextureImage&& other) noexcept;
+		TextureImage& operator=(TextureImage&& other) noexcept;
+
+		uint32_t Width = 0, Height = 0;
+		uint32_t Channels = 0;
+		// HDR images hold 32-bit floats per channel, everything else 8-bit
+		bool HDR = false;
+		void* Pixels = nullptr;
+
+		// Compressed images carry their mip chain back to back in CompressedData, Pixels stays null.
+		// Streamed images may start at a lower level, Width/Height always describe level 0
+		TextureCompression Compression = TextureCompression::None;
+		uint32_t MipCount = 1;
+		uint32_t FirstMip = 0;
+		std::vector<uint8_t> CompressedData;
+
+		bool IsCompressed() const { return Compression != TextureCompression::None; }
+		// Uploads of block compressed images have to start and end on block rows
+		uint32_t GetRowAlignment() const { return IsCompressed() ? 4 : 1; }
+		// Bytes per row of FirstMip. For block compressed images a block row is spread over its 4 pixel rows
+		uint32_t GetRowSize() const;
+		uint64_t GetSize() const;
+		bool IsValid() const { return Pixels != nullptr || !CompressedData.empty(); }
+
+		uint32_t GetMipWidth(uint32_t level) const { return std::max(Width >> level, 1u); }
+		uint32_t GetMipHeight(uint32_t level) const { return std::max(Height >> level, 1u); }
+		// Relative to FirstMip
+		uint64_t GetMipOffset(uint32_t level) const;
+		uint32_t GetMipSize(uint32_t level) const;
+
+		// Flipped vertically, same as every texture the renderer samples
+		static bool Decode(const std::string& path, TextureImage& outImage);
+		static bool Decode(const void* data, size_t size, TextureImage& outImage);
+
+		static uint32_t GetBlockSize(TextureCompression compression);
 	};
 
 	class Texture
@@ -52,9 +119,25 @@ namespace RXNEngine {
 		static Ref<Texture2D> Create(const TextureSpecification& specification);
 		static Ref<Texture2D> Create(const std::string& path);
 		static Ref<Texture2D> Create(const void* data, size_t size);
+		// Texture without storage that reports IsLoaded() == false until UploadImage has written every row
+		static Ref<Texture2D> CreatePending(const std::string& path);
 		static Ref<Texture2D> WhiteTexture();
 		static Ref<Texture2D> BlackTexture();
 		static Ref<Texture2D> BlueTexture();
+
+		// Uploads rows [firstRow, firstRow + rowCount) of the image's FirstMip, storage is (re)allocated when firstRow is 0.
+		// Large images can be spread over several calls, the remaining mips are written once the last row is
+		virtual void UploadImage(const TextureImage& image, uint32_t firstRow, uint32_t rowCount) = 0;
+
+		// Streaming, only levels [GetBaseMip(), GetMipCount()) have GPU storage
+		virtual uint32_t GetMipCount() const = 0;
+		virtual uint32_t GetBaseMip() const = 0;
+		// Reallocates storage starting at baseMip. Levels that stay resident are copied on the GPU,
+		// levels that become resident are taken from image, which has to cover [baseMip, GetBaseMip())
+		virtual void SetBaseMip(uint32_t baseMip, const TextureImage& image) = 0;
+
+		// Binds one level for image load/store from compute shaders
+		virtual void BindImage(uint32_t unit, uint32_t mip, ImageAccess access) const = 0;
 	};
 
 	class Cubemap : public Texture
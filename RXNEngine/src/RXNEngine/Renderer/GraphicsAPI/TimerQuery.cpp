@@ -0,0 +1,23 @@
+#include "rxnpch.h"
+#include "TimerQuery.h"
+
+#include "RXNEngine/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLTimerQuery.h"
+#include "Platform/Null/NullTimerQuery.h"
+
+namespace RXNEngine {
+
+	Ref<TimerQuery> TimerQuery::Create()
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTimerQuery>();
+			case RendererAPI::API::Null:    return CreateRef<NullTimerQuery>();
+		}
+
+		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
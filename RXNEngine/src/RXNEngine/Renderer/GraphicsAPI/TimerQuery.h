@@ -0,0 +1,22 @@
+#pragma once
+
+#include "RXNEngine/Core/Base.h"
+
+namespace RXNEngine {
+
+	class TimerQuery
+	{
+	public:
+		virtual ~TimerQuery() {}
+
+		virtual void Begin() = 0;
+		virtual void End() = 0;
+
+		virtual bool IsResultAvailable() const = 0;
+		// In nanoseconds, only valid once IsResultAvailable() returns true
+		virtual uint64_t GetElapsedTime() const = 0;
+
+		static Ref<TimerQuery> Create();
+	};
+
+}
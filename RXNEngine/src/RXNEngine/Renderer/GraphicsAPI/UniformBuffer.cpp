@@ -3,6 +3,7 @@
 
 #include "RXNEngine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLUniformBuffer.h"
+#include "Platform/Null/NullUniformBuffer.h"
 
 namespace RXNEngine {
 
@@ -12,6 +13,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLUniformBuffer>(size, binding);
+			case RendererAPI::API::Null:    return CreateRef<NullUniformBuffer>(size, binding);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -3,6 +3,7 @@
 
 #include "RXNEngine/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 
 namespace RXNEngine {
 
@@ -12,6 +13,7 @@ namespace RXNEngine {
         {
             case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is not supported!"); return nullptr;
             case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexArray>();
+            case RendererAPI::API::Null:    return CreateRef<NullVertexArray>();
         }
 
         RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
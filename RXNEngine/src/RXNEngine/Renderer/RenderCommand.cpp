@@ -1,10 +1,14 @@
 #include "rxnpch.h"
 #include "RenderCommand.h"
 
-#include "Platform/OpenGL/OpenGLRendererAPI.h"
-
 namespace RXNEngine {
 
-	Scope<RendererAPI> RenderCommand::s_RendererAPI = CreateScope<OpenGLRendererAPI>();
+	Scope<RendererAPI> RenderCommand::s_RendererAPI;
+
+	void RenderCommand::Init()
+	{
+		s_RendererAPI = RendererAPI::Create();
+		s_RendererAPI->Init();
+	}
 
 }
\ No newline at end of file
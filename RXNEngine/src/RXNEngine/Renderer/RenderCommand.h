@@ -8,10 +8,7 @@ namespace RXNEngine {
 	{
 	public:
 
-		inline static void Init()
-		{
-			s_RendererAPI->Init();
-		}
+		static void Init();
 
 		inline static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 		{
@@ -48,6 +45,16 @@ namespace RXNEngine {
 			s_RendererAPI->SetLineWidth(width);
 		}
 
+		inline static void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ = 1)
+		{
+			s_RendererAPI->DispatchCompute(groupsX, groupsY, groupsZ);
+		}
+
+		inline static void ComputeBarrier()
+		{
+			s_RendererAPI->ComputeBarrier();
+		}
+
 		inline static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, const Ref<VertexBuffer>& instanceData, uint32_t instanceCount, uint32_t indexCount, uint32_t baseIndex)
 		{
 			s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceData, instanceCount, indexCount, baseIndex);
@@ -0,0 +1,284 @@
+#include "rxnpch.h"
+#include "RenderGraph.h"
+
+#include "GPUProfiler.h"
+
+#include <sstream>
+
+namespace RXNEngine {
+
+    RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource)
+    {
+        RXN_CORE_ASSERT(resource < m_Graph.m_Resources.size(), "Invalid render graph resource!");
+
+        auto& node = m_Graph.m_Resources[resource];
+        RXN_CORE_ASSERT(node.Imported || node.LastWriter >= 0, "Render graph resource is read before any pass writes it!");
+
+        auto& reads = m_Graph.m_Passes[m_PassIndex].Reads;
+        if (std::find(reads.begin(), reads.end(), resource) == reads.end())
+            reads.push_back(resource);
+
+        return resource;
+    }
+
+    RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource)
+    {
+        RXN_CORE_ASSERT(resource < m_Graph.m_Resources.size(), "Invalid render graph resource!");
+
+        auto& node = m_Graph.m_Resources[resource];
+        if (node.LastWriter >= 0 && node.LastWriter != (int32_t)m_PassIndex)
+            Read(resource);
+
+        node.LastWriter = m_PassIndex;
+
+        auto& writes = m_Graph.m_Passes[m_PassIndex].Writes;
+        if (std::find(writes.begin(), writes.end(), resource) == writes.end())
+            writes.push_back(resource);
+
+        return resource;
+    }
+
+    void RenderGraphBuilder::SetSideEffect()
+    {
+        m_Graph.m_Passes[m_PassIndex].SideEffect = true;
+    }
+
+    RenderGraph::RenderGraph(RenderTargetPool& pool)
+        : m_Pool(pool)
+    {
+    }
+
+    RenderGraph::~RenderGraph()
+    {
+        // Transient outputs outlive Execute(), they go back to the pool with the graph
+        for (auto& resource : m_Resources)
+        {
+            if (!resource.Imported && resource.Target)
+                m_Pool.Release(resource.Target);
+        }
+    }
+
+    RenderGraphResource RenderGraph::CreateTarget(const std::string& name, const RenderTargetSpecification& spec)
+    {
+        ResourceNode& node = m_Resources.emplace_back();
+        node.Name = name;
+        node.Specification = spec;
+        return (RenderGraphResource)(m_Resources.size() - 1);
+    }
+
+    RenderGraphResource RenderGraph::ImportTarget(const std::string& name, const Ref<RenderTarget>& target)
+    {
+        RXN_CORE_ASSERT(target, "Importing an empty render target!");
+
+        ResourceNode& node = m_Resources.emplace_back();
+        node.Name = name;
+        node.Specification = target->GetSpecification();
+        node.Target = target;
+        node.Imported = true;
+        return (RenderGraphResource)(m_Resources.size() - 1);
+    }
+
+    RenderGraphResource RenderGraph::ImportTexture(const std::string& name, const Ref<Texture2D>& texture)
+    {
+        RXN_CORE_ASSERT(texture, "Importing an empty texture!");
+
+        ResourceNode& node = m_Resources.emplace_back();
+        node.Name = name;
+        node.Specification.Width = (float)texture->GetWidth();
+        node.Specification.Height = (float)texture->GetHeight();
+        node.Texture = texture;
+        node.Imported = true;
+        return (RenderGraphResource)(m_Resources.size() - 1);
+    }
+
+    void RenderGraph::AddPass(const std::string& name, const SetupFunction& setup, const ExecuteFunction& execute)
+    {
+        RXN_CORE_ASSERT(!m_Compiled, "Passes can't be added after the graph is compiled!");
+
+        PassNode& pass = m_Passes.emplace_back();
+        pass.Name = name;
+        pass.Execute = execute;
+
+        RenderGraphBuilder builder(*this, (uint32_t)(m_Passes.size() - 1));
+        setup(builder);
+    }
+
+    void RenderGraph::MarkOutput(RenderGraphResource resource)
+    {
+        RXN_CORE_ASSERT(resource < m_Resources.size(), "Invalid render graph resource!");
+        m_Resources[resource].Output = true;
+    }
+
+    void RenderGraph::Compile()
+    {
+        OPTICK_EVENT();
+
+        // Passes can only read what earlier passes wrote, so declaration order is already a valid order and a single
+        // backwards sweep finds everything the outputs depend on
+        std::vector<bool> needed(m_Resources.size(), false);
+        for (size_t i = 0; i < m_Resources.size(); i++)
+            needed[i] = m_Resources[i].Output;
+
+        for (int32_t i = (int32_t)m_Passes.size() - 1; i >= 0; i--)
+        {
+            PassNode& pass = m_Passes[i];
+
+            bool used = pass.SideEffect;
+            for (RenderGraphResource resource : pass.Writes)
+                used |= needed[resource];
+
+            pass.Culled = !used;
+            if (pass.Culled)
+                continue;
+
+            for (RenderGraphResource resource : pass.Reads)
+                needed[resource] = true;
+        }
+
+        for (int32_t i = 0; i < (int32_t)m_Passes.size(); i++)
+        {
+            const PassNode& pass = m_Passes[i];
+            if (pass.Culled)
+                continue;
+
+            auto touch = [i, this](RenderGraphResource resource)
+                {
+                    ResourceNode& node = m_Resources[resource];
+                    if (node.FirstPass < 0)
+                        node.FirstPass = i;
+                    node.LastPass = i;
+                };
+
+            for (RenderGraphResource resource : pass.Reads)
+                touch(resource);
+            for (RenderGraphResource resource : pass.Writes)
+                touch(resource);
+        }
+
+        m_Compiled = true;
+    }
+
+    void RenderGraph::Execute()
+    {
+        OPTICK_EVENT();
+
+        if (!m_Compiled)
+            Compile();
+
+        for (int32_t i = 0; i < (int32_t)m_Passes.size(); i++)
+        {
+            PassNode& pass = m_Passes[i];
+            if (pass.Culled)
+                continue;
+
+            for (auto& resource : m_Resources)
+            {
+                if (!resource.Imported && resource.FirstPass == i)
+                    resource.Target = m_Pool.Acquire(resource.Specification);
+            }
+
+            {
+                OPTICK_EVENT_DYNAMIC(pass.Name.c_str());
+                GPUProfileScope timer(pass.Name);
+                pass.Execute(*this);
+            }
+
+            for (auto& resource : m_Resources)
+            {
+                if (!resource.Imported && !resource.Output && resource.LastPass == i)
+                {
+                    m_Pool.Release(resource.Target);
+                    resource.Target = nullptr;
+                }
+            }
+        }
+    }
+
+    Ref<RenderTarget> RenderGraph::GetTarget(RenderGraphResource resource) const
+    {
+        RXN_CORE_ASSERT(resource < m_Resources.size(), "Invalid render graph resource!");
+        RXN_CORE_ASSERT(m_Resources[resource].Target, "Render graph resource isn't allocated, was it declared by the pass?");
+        return m_Resources[resource].Target;
+    }
+
+    Ref<Texture2D> RenderGraph::GetTexture(RenderGraphResource resource) const
+    {
+        RXN_CORE_ASSERT(resource < m_Resources.size(), "Invalid render graph resource!");
+        RXN_CORE_ASSERT(m_Resources[resource].Texture, "Render graph resource isn't a texture!");
+        return m_Resources[resource].Texture;
+    }
+
+    uint32_t RenderGraph::GetColorTextureID(RenderGraphResource resource) const
+    {
+        RXN_CORE_ASSERT(resource < m_Resources.size(), "Invalid render graph resource!");
+
+        const ResourceNode& node = m_Resources[resource];
+        if (node.Texture)
+            return node.Texture->GetRendererID();
+
+        return GetTarget(resource)->GetColorAttachmentRendererID();
+    }
+
+    const RenderTargetSpecification& RenderGraph::GetSpecification(RenderGraphResource resource) const
+    {
+        RXN_CORE_ASSERT(resource < m_Resources.size(), "Invalid render graph resource!");
+        return m_Resources[resource].Specification;
+    }
+
+    RenderGraphInfo RenderGraph::GetInfo() const
+    {
+        RenderGraphInfo info;
+
+        for (const auto& pass : m_Passes)
+        {
+            RenderGraphPassInfo& passInfo = info.Passes.emplace_back();
+            passInfo.Name = pass.Name;
+            passInfo.Culled = pass.Culled;
+            for (RenderGraphResource resource : pass.Reads)
+                passInfo.Reads.push_back(m_Resources[resource].Name);
+            for (RenderGraphResource resource : pass.Writes)
+                passInfo.Writes.push_back(m_Resources[resource].Name);
+        }
+
+        for (const auto& resource : m_Resources)
+        {
+            RenderGraphResourceInfo& resourceInfo = info.Resources.emplace_back();
+            resourceInfo.Name = resource.Name;
+            resourceInfo.Imported = resource.Imported;
+            resourceInfo.Width = resource.Specification.Width;
+            resourceInfo.Height = resource.Specification.Height;
+            resourceInfo.FirstPass = resource.FirstPass;
+            resourceInfo.LastPass = resource.LastPass;
+        }
+
+        return info;
+    }
+
+    std::string RenderGraphInfo::ToGraphviz() const
+    {
+        std::stringstream ss;
+        ss << "digraph RenderGraph {\n";
+        ss << "    rankdir=LR;\n";
+
+        for (const auto& resource : Resources)
+        {
+            ss << "    \"" << resource.Name << "\" [shape=box, style=rounded, label=\"" << resource.Name << "\\n"
+                << resource.Width << "x" << resource.Height << (resource.Imported ? " (imported)" : "") << "\"];\n";
+        }
+
+        for (const auto& pass : Passes)
+        {
+            ss << "    \"pass:" << pass.Name << "\" [shape=ellipse, label=\"" << pass.Name << "\""
+                << (pass.Culled ? ", style=dashed, fontcolor=gray" : "") << "];\n";
+
+            for (const auto& read : pass.Reads)
+                ss << "    \"" << read << "\" -> \"pass:" << pass.Name << "\";\n";
+            for (const auto& write : pass.Writes)
+                ss << "    \"pass:" << pass.Name << "\" -> \"" << write << "\";\n";
+        }
+
+        ss << "}\n";
+        return ss.str();
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "RenderTarget.h"
+#include "RenderTargetPool.h"
+#include "RXNEngine/Renderer/GraphicsAPI/Texture.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace RXNEngine {
+
+    using RenderGraphResource = uint32_t;
+    inline constexpr RenderGraphResource InvalidRenderGraphResource = UINT32_MAX;
+
+    class RenderGraph;
+
+    // Handed to a pass's setup function to declare what it reads and writes
+    class RenderGraphBuilder
+    {
+    public:
+        RenderGraphResource Read(RenderGraphResource resource);
+        // Writing a resource an earlier pass wrote also depends on that pass, like drawing on top of it
+        RenderGraphResource Write(RenderGraphResource resource);
+
+        // Keeps the pass even when nothing reads its outputs
+        void SetSideEffect();
+    private:
+        RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+    private:
+        RenderGraph& m_Graph;
+        uint32_t m_PassIndex;
+
+        friend class RenderGraph;
+    };
+
+    struct RenderGraphPassInfo
+    {
+        std::string Name;
+        bool Culled = false;
+        std::vector<std::string> Reads;
+        std::vector<std::string> Writes;
+    };
+
+    struct RenderGraphResourceInfo
+    {
+        std::string Name;
+        bool Imported = false;
+        uint32_t Width = 0, Height = 0;
+        // Indices into the pass list, -1 when no surviving pass touches the resource
+        int32_t FirstPass = -1;
+        int32_t LastPass = -1;
+    };
+
+    struct RenderGraphInfo
+    {
+        std::vector<RenderGraphPassInfo> Passes;
+        std::vector<RenderGraphResourceInfo> Resources;
+
+        std::string ToGraphviz() const;
+    };
+
+    // Built every frame: passes declare their reads and writes, Compile() culls the passes nothing depends on and
+    // works out when each transient target is first and last used, Execute() runs the survivors in declaration order
+    // and acquires transient targets from the pool just before their first use and releases them after their last
+    class RenderGraph
+    {
+    public:
+        using SetupFunction = std::function<void(RenderGraphBuilder&)>;
+        using ExecuteFunction = std::function<void(const RenderGraph&)>;
+    public:
+        RenderGraph(RenderTargetPool& pool);
+        ~RenderGraph();
+
+        RenderGraphResource CreateTarget(const std::string& name, const RenderTargetSpecification& spec);
+        RenderGraphResource ImportTarget(const std::string& name, const Ref<RenderTarget>& target);
+        // For storage images written by compute passes, which aren't render targets
+        RenderGraphResource ImportTexture(const std::string& name, const Ref<Texture2D>& texture);
+
+        void AddPass(const std::string& name, const SetupFunction& setup, const ExecuteFunction& execute);
+
+        // Consumed outside the graph, every pass contributing to it is kept
+        void MarkOutput(RenderGraphResource resource);
+
+        void Compile();
+        void Execute();
+
+        // Only valid while a pass that declared the resource is executing
+        Ref<RenderTarget> GetTarget(RenderGraphResource resource) const;
+        Ref<Texture2D> GetTexture(RenderGraphResource resource) const;
+        // What a later pass samples, the texture itself or a target's first colour attachment
+        uint32_t GetColorTextureID(RenderGraphResource resource) const;
+        const RenderTargetSpecification& GetSpecification(RenderGraphResource resource) const;
+
+        RenderGraphInfo GetInfo() const;
+    private:
+        struct ResourceNode
+        {
+            std::string Name;
+            RenderTargetSpecification Specification;
+            Ref<RenderTarget> Target;
+            Ref<Texture2D> Texture;
+            bool Imported = false;
+            bool Output = false;
+            int32_t LastWriter = -1;
+
+            int32_t FirstPass = -1;
+            int32_t LastPass = -1;
+        };
+
+        struct PassNode
+        {
+            std::string Name;
+            ExecuteFunction Execute;
+            std::vector<RenderGraphResource> Reads;
+            std::vector<RenderGraphResource> Writes;
+            bool SideEffect = false;
+            bool Culled = false;
+        };
+    private:
+        RenderTargetPool& m_Pool;
+
+        std::vector<ResourceNode> m_Resources;
+        std::vector<PassNode> m_Passes;
+        bool m_Compiled = false;
+
+        friend class RenderGraphBuilder;
+    };
+
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "RXNEngine/Renderer/Renderer.h"
 #include "RXNEngine/Renderer/RenderTarget.h"
 #include "Platform/OpenGL/OpenGLRenderTarget.h"
+#include "Platform/Null/NullRenderTarget.h"
 
 namespace RXNEngine {
 
@@ -11,6 +12,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLRenderTarget>(spec);
+			case RendererAPI::API::Null:    return CreateRef<NullRenderTarget>(spec);
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -12,6 +12,7 @@ namespace RXNEngine {
 		RGBA8,
 		RGBA16F,
 		RGBA32F,
+		R16F,
 		RED_INTEGER,
 
 		// Depth/stencil
@@ -64,6 +65,9 @@ namespace RXNEngine {
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
 
+		// Both targets need the same size and depth format
+		virtual void CopyDepthTo(const Ref<RenderTarget>& destination) = 0;
+
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
 
 		virtual const RenderTargetSpecification& GetSpecification() const = 0;
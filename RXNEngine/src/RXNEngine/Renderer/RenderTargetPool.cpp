@@ -0,0 +1,129 @@
+#include "rxnpch.h"
+#include "RenderTargetPool.h"
+
+namespace RXNEngine {
+
+    static constexpr uint64_t s_MaxIdleFrames = 120;
+
+    static uint32_t GetBytesPerPixel(RenderTargetTextureFormat format)
+    {
+        switch (format)
+        {
+            case RenderTargetTextureFormat::RGBA8:           return 4;
+            case RenderTargetTextureFormat::RGBA16F:         return 8;
+            case RenderTargetTextureFormat::RGBA32F:         return 16;
+            case RenderTargetTextureFormat::R16F:            return 2;
+            case RenderTargetTextureFormat::RED_INTEGER:     return 4;
+            case RenderTargetTextureFormat::DEPTH24STENCIL8: return 4;
+        }
+        return 0;
+    }
+
+    Ref<RenderTarget> RenderTargetPool::Acquire(const RenderTargetSpecification& spec)
+    {
+        OPTICK_EVENT();
+
+        for (auto& entry : m_Entries)
+        {
+            if (!entry.InUse && IsCompatible(entry.Target->GetSpecification(), spec))
+            {
+                entry.InUse = true;
+                entry.LastUsedFrame = m_FrameIndex;
+                return entry.Target;
+            }
+        }
+
+        PoolEntry& entry = m_Entries.emplace_back();
+        entry.Target = RenderTarget::Create(spec);
+        entry.InUse = true;
+        entry.LastUsedFrame = m_FrameIndex;
+        return entry.Target;
+    }
+
+    void RenderTargetPool::Release(const Ref<RenderTarget>& target)
+    {
+        if (!target)
+            return;
+
+        for (auto& entry : m_Entries)
+        {
+            if (entry.Target == target)
+            {
+                entry.InUse = false;
+                return;
+            }
+        }
+
+        RXN_CORE_WARN("RenderTargetPool: Released a render target that is not owned by the pool!");
+    }
+
+    void RenderTargetPool::BeginFrame()
+    {
+        m_FrameIndex++;
+    }
+
+    void RenderTargetPool::EndFrame()
+    {
+        std::erase_if(m_Entries, [this](const PoolEntry& entry)
+            {
+                return !entry.InUse && m_FrameIndex - entry.LastUsedFrame > s_MaxIdleFrames;
+            });
+    }
+
+    void RenderTargetPool::ReleaseUnused()
+    {
+        std::erase_if(m_Entries, [](const PoolEntry& entry) { return !entry.InUse; });
+    }
+
+    void RenderTargetPool::Clear()
+    {
+        m_Entries.clear();
+    }
+
+    RenderTargetPoolStatistics RenderTargetPool::GetStats() const
+    {
+        RenderTargetPoolStatistics stats;
+        for (const auto& entry : m_Entries)
+        {
+            stats.TargetCount++;
+            if (entry.InUse)
+                stats.TargetsInUse++;
+            stats.MemoryBytes += CalculateMemorySize(entry.Target->GetSpecification());
+        }
+        return stats;
+    }
+
+    uint64_t RenderTargetPool::CalculateMemorySize(const RenderTargetSpecification& spec)
+    {
+        uint64_t pixelCount = (uint64_t)spec.Width * (uint64_t)spec.Height * spec.Samples;
+
+        uint64_t size = 0;
+        for (const auto& attachment : spec.Attachments.Attachments)
+            size += pixelCount * GetBytesPerPixel(attachment.TextureFormat);
+
+        return size;
+    }
+
+    bool RenderTargetPool::IsCompatible(const RenderTargetSpecification& a, const RenderTargetSpecification& b)
+    {
+        if ((uint32_t)a.Width != (uint32_t)b.Width || (uint32_t)a.Height != (uint32_t)b.Height)
+            return false;
+
+        if (a.Samples != b.Samples || a.SwapChainTarget != b.SwapChainTarget)
+            return false;
+
+        const auto& attachmentsA = a.Attachments.Attachments;
+        const auto& attachmentsB = b.Attachments.Attachments;
+        if (attachmentsA.size() != attachmentsB.size())
+            return false;
+
+        for (size_t i = 0; i < attachmentsA.size(); i++)
+        {
+            if (attachmentsA[i].TextureFormat != attachmentsB[i].TextureFormat)
+                return false;
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "RenderTarget.h"
+
+#include <vector>
+
+namespace RXNEngine {
+
+    struct RenderTargetPoolStatistics
+    {
+        uint32_t TargetCount = 0;
+        uint32_t TargetsInUse = 0;
+        uint64_t MemoryBytes = 0;
+    };
+
+    // Hands out render targets keyed by attachment formats and size. Passes acquire a target for as long as
+    // they need it within a frame and release it afterwards, so later passes with the same key alias its memory.
+    class RenderTargetPool
+    {
+    public:
+        RenderTargetPool() = default;
+        ~RenderTargetPool() = default;
+
+        Ref<RenderTarget> Acquire(const RenderTargetSpecification& spec);
+        void Release(const Ref<RenderTarget>& target);
+
+        void BeginFrame();
+        void EndFrame();
+
+        void ReleaseUnused();
+        void Clear();
+
+        RenderTargetPoolStatistics GetStats() const;
+
+        static uint64_t CalculateMemorySize(const RenderTargetSpecification& spec);
+    private:
+        struct PoolEntry
+        {
+            Ref<RenderTarget> Target;
+            bool InUse = false;
+            uint64_t LastUsedFrame = 0;
+        };
+
+        static bool IsCompatible(const RenderTargetSpecification& a, const RenderTargetSpecification& b);
+    private:
+        std::vector<PoolEntry> m_Entries;
+        uint64_t m_FrameIndex = 0;
+    };
+
+}
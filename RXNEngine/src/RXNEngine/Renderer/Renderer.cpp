@@ -2,9 +2,12 @@
 #include "Renderer.h"
 #include "RXNEngine/Math/Math.h"
 #include "RXNEngine/Math/Frustum.h"
+#include "RXNEngine/Asset/TextureStreamer.h"
 #include "RXNEngine/Renderer/GraphicsAPI/UniformBuffer.h"
+#include "RXNEngine/Renderer/GraphicsAPI/OcclusionQuery.h"
 #include "RenderCommand.h"
 #include "ShadowMap.h"
+#include "GPUProfiler.h"
 
 #include <algorithm>
 #include <array>
@@ -50,6 +53,11 @@ namespace RXNEngine {
 
     static constexpr uint32_t MaxInstances = 10000;
 
+    // Auto pre-pass thresholds, apart so a scene hovering around one of them doesn't toggle every frame
+    static constexpr float s_PrePassEnableComplexity = 2.5f;
+    static constexpr float s_PrePassDisableComplexity = 1.5f;
+    static constexpr uint32_t s_OverdrawQueryCount = 3;
+
     struct RendererData
     {
         Ref<RenderTarget> CurrentRenderTarget = nullptr;
@@ -62,6 +70,9 @@ namespace RXNEngine {
         glm::vec3 CameraForward;
         Frustum CameraFrustum;
         float CameraFOV = 45.0f;
+        float ProjectionScale = 1.0f;
+        uint32_t ViewportWidth = 1280;
+        uint32_t ViewportHeight = 720;
 
         uint32_t CurrentShaderID = 0;
         uint32_t CurrentVertexArrayID = 0;
@@ -88,6 +99,23 @@ namespace RXNEngine {
         std::vector<LineVertex> LineVertices;
         const uint32_t MaxLineVertices = 100000;
 
+        Ref<Shader> DepthPrePassShader;
+        DepthPrePassMode PrePassMode = DepthPrePassMode::Auto;
+        bool AutoPrePassActive = false;
+        float OpaqueCoverage = 0.0f;
+
+        std::array<Ref<OcclusionQuery>, s_OverdrawQueryCount> OverdrawQueries;
+        std::array<uint64_t, s_OverdrawQueryCount> OverdrawPixelCounts{};
+        std::array<bool, s_OverdrawQueryCount> OverdrawPending{};
+        uint32_t OverdrawFrameIndex = 0;
+
+        TransparencyMode Transparency = TransparencyMode::Sorted;
+        bool WeightedOIT = false;
+        // Accumulation, revealage and a copy of the opaque depth, sized to the current render target
+        Ref<RenderTarget> OITTarget;
+        Ref<Shader> OITCompositeShader;
+        Ref<VertexArray> ScreenQuadVAO;
+
         RendererStatistics Stats;
     };
 
@@ -103,6 +131,26 @@ namespace RXNEngine {
         s_Data.Stats.Reset();
     }
 
+    void Renderer::SetDepthPrePassMode(DepthPrePassMode mode)
+    {
+        s_Data.PrePassMode = mode;
+    }
+
+    DepthPrePassMode Renderer::GetDepthPrePassMode()
+    {
+        return s_Data.PrePassMode;
+    }
+
+    void Renderer::SetTransparencyMode(TransparencyMode mode)
+    {
+        s_Data.Transparency = mode;
+    }
+
+    TransparencyMode Renderer::GetTransparencyMode()
+    {
+        return s_Data.Transparency;
+    }
+
     std::vector<glm::vec4> GetFrustumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view)
     {
         OPTICK_EVENT();
@@ -174,6 +222,7 @@ namespace RXNEngine {
     void Renderer::Init()
     {
         RenderCommand::Init();
+        GPUProfiler::Init();
         s_Data.OpaqueQueue.reserve(1000);
         s_Data.InstanceVertexBuffer = VertexBuffer::Create(MaxInstances * sizeof(InstanceData));
         s_Data.InstanceVertexBuffer->SetLayout({
@@ -253,16 +302,34 @@ namespace RXNEngine {
             });
         s_Data.LineVAO->AddVertexBuffer(s_Data.LineVBO);
         s_Data.LineShader = Shader::Create("res/shaders/line.glsl");
+
+        s_Data.DepthPrePassShader = Shader::Create("res/shaders/depth_prepass.glsl");
+        for (auto& query : s_Data.OverdrawQueries)
+            query = OcclusionQuery::Create();
+
+        s_Data.OITCompositeShader = Shader::Create("res/shaders/oit_composite.glsl");
+
+        float quadVertices[] = { -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f };
+        uint32_t quadIndices[] = { 0, 1, 2, 2, 3, 0 };
+
+        Ref<VertexBuffer> quadVB = VertexBuffer::Create(quadVertices, sizeof(quadVertices));
+        quadVB->SetLayout({ { ShaderDataType::Float2, "a_Position" } });
+        s_Data.ScreenQuadVAO = VertexArray::Create();
+        s_Data.ScreenQuadVAO->AddVertexBuffer(quadVB);
+        s_Data.ScreenQuadVAO->SetIndexBuffer(IndexBuffer::Create(quadIndices, 6));
     }
 
     void Renderer::Shutdown()
     {
         s_Data.OpaqueQueue.clear();
+        GPUProfiler::Shutdown();
     }
 
     void Renderer::OnWindowResize(uint32_t width, uint32_t height)
     {
         RenderCommand::SetViewport(0, 0, width, height);
+        s_Data.ViewportWidth = width;
+        s_Data.ViewportHeight = height;
     }
 
     void Renderer::BeginScene(const EditorCamera& camera, const LightEnvironment& lights,
@@ -320,6 +387,9 @@ namespace RXNEngine {
                 s_Data.CurrentRenderTarget->GetSpecification().Height);
             RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
             RenderCommand::Clear();
+
+            s_Data.ViewportWidth = s_Data.CurrentRenderTarget->GetSpecification().Width;
+            s_Data.ViewportHeight = s_Data.CurrentRenderTarget->GetSpecification().Height;
         }
         else
         {
@@ -336,6 +406,8 @@ namespace RXNEngine {
         s_Data.CameraPosition = cameraPosition;
         s_Data.CameraForward = -glm::normalize(glm::vec3(glm::inverse(viewMatrix)[2]));
         s_Data.CameraFrustum.Define(viewProjection);
+        // cot(fov / 2), read back from the projection so editor and runtime cameras agree on units
+        s_Data.ProjectionScale = (viewProjection * glm::inverse(viewMatrix))[1][1];
 
         s_Data.LightBufferLocal.DirLightDirection = glm::vec4(lights.DirLight.Direction, lights.DirLight.Intensity);
         s_Data.LightBufferLocal.DirLightColor = glm::vec4(lights.DirLight.Color, 0.0f);
@@ -354,6 +426,7 @@ namespace RXNEngine {
         s_Data.OpaqueQueue.clear();
         s_Data.TransparentQueue.clear();
         s_Data.ShadowQueue.clear();
+        s_Data.OpaqueCoverage = 0.0f;
 
         // reset state at start of frame? 
         s_Data.CurrentShaderID = 0;
@@ -382,15 +455,29 @@ namespace RXNEngine {
         glm::vec3 directionToPosition = position - s_Data.CameraPosition;
         packet.DistanceToCamera = glm::dot(s_Data.CameraForward, directionToPosition);
 
+        // Only visible submeshes reach Submit, their size on screen decides which texture mips stay resident
+        AABB bounds = Math::CalculateWorldAABB(submeshes[submeshIndex].BoundingBox, transform);
+        float radius = glm::length(bounds.Max - bounds.Min) * 0.5f;
+        float distance = std::max(glm::length((bounds.Min + bounds.Max) * 0.5f - s_Data.CameraPosition), radius);
+        float screenSize = distance > 0.0f ? radius * s_Data.ProjectionScale * s_Data.ViewportHeight / distance : 0.0f;
+
+        TextureStreamer::RequestMaterial(*material, screenSize);
+
         uint64_t shaderID = material->GetShader()->GetRendererID();
         uint64_t vaoID = mesh->GetVertexArray()->GetRendererID();
 
         packet.SortKey = (shaderID << 32) | ((vaoID & 0xFFFF) << 16) | (submeshIndex & 0xFFFF);
 
         if (material->IsTransparent())
+        {
             s_Data.TransparentQueue.push_back(packet);
+        }
         else
+        {
+            float screenArea = (float)s_Data.ViewportWidth * s_Data.ViewportHeight;
+            s_Data.OpaqueCoverage += std::min(glm::quarter_pi<float>() * screenSize * screenSize, screenArea);
             s_Data.OpaqueQueue.push_back(packet);
+        }
     }
 
     void Renderer::EndScene()
@@ -577,14 +664,17 @@ namespace RXNEngine {
     {
         OPTICK_EVENT();
 
-        FlushShadows();
+        {
+            GPUProfileScope scope("Shadows");
+            FlushShadows();
+        }
 
         if (s_Data.CurrentRenderTarget) s_Data.CurrentRenderTarget->Bind();
         else RenderCommand::BindDefaultRenderTarget();
 
-        RenderCommand::SetViewport(0, 0, 
-            s_Data.CurrentRenderTarget ? s_Data.CurrentRenderTarget->GetSpecification().Width : 1280,
-            s_Data.CurrentRenderTarget ? s_Data.CurrentRenderTarget->GetSpecification().Height : 720);
+        uint32_t targetWidth = s_Data.CurrentRenderTarget ? s_Data.CurrentRenderTarget->GetSpecification().Width : 1280;
+        uint32_t targetHeight = s_Data.CurrentRenderTarget ? s_Data.CurrentRenderTarget->GetSpecification().Height : 720;
+        RenderCommand::SetViewport(0, 0, targetWidth, targetHeight);
 
         s_Data.ShadowData.ShadowTarget->BindRead(8);
 
@@ -600,29 +690,87 @@ namespace RXNEngine {
                 return a.DistanceToCamera < b.DistanceToCamera;
             });
 
-        ExecuteQueue(s_Data.OpaqueQueue);
+        uint64_t pixelCount = (uint64_t)targetWidth * targetHeight;
+        s_Data.Stats.EstimatedDepthComplexity = s_Data.OpaqueCoverage / (float)pixelCount;
+        s_Data.Stats.DepthPrePass = ShouldUseDepthPrePass(s_Data.Stats.EstimatedDepthComplexity);
+
+        if (s_Data.Stats.DepthPrePass)
+        {
+            GPUProfileScope scope("Depth Pre-Pass");
+
+            RenderCommand::SetColorMask(false, false, false, false);
+            ExecuteDepthPrePass(s_Data.OpaqueQueue);
+            RenderCommand::SetColorMask(true, true, true, true);
+
+            // Depth is final, only the front-most fragment of each pixel gets shaded
+            RenderCommand::SetDepthFunc(RendererAPI::DepthFunc::LessEqual);
+            RenderCommand::SetDepthMask(false);
+        }
+
+        for (uint32_t i = 0; i < s_OverdrawQueryCount; i++)
+        {
+            if (!s_Data.OverdrawPending[i] || !s_Data.OverdrawQueries[i]->IsResultAvailable())
+                continue;
+
+            s_Data.Stats.OpaqueOverdraw = s_Data.OverdrawQueries[i]->GetSampleCount() / (float)s_Data.OverdrawPixelCounts[i];
+            s_Data.OverdrawPending[i] = false;
+        }
+
+        uint32_t overdrawQuery = s_Data.OverdrawFrameIndex++ % s_OverdrawQueryCount;
 
+        {
+            GPUProfileScope scope("Opaque");
+
+            // Still not resolved after a full round trip, the slot is reused rather than waited on
+            s_Data.OverdrawQueries[overdrawQuery]->Begin();
+            ExecuteQueue(s_Data.OpaqueQueue);
+            s_Data.OverdrawQueries[overdrawQuery]->End();
+
+            s_Data.OverdrawPixelCounts[overdrawQuery] = pixelCount;
+            s_Data.OverdrawPending[overdrawQuery] = true;
+        }
+
+        RenderCommand::SetDepthFunc(RendererAPI::DepthFunc::Less);
         RenderCommand::SetDepthMask(false);
-        RenderCommand::SetBlend(true);
 
-        RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::SrcAlpha, RendererAPI::BlendFactor::OneMinusSrcAlpha);
+        uint32_t opaqueDrawCalls = s_Data.Stats.DrawCalls;
 
-        std::sort(s_Data.TransparentQueue.begin(), s_Data.TransparentQueue.end(),
-            [](const RenderCommandPacket& a, const RenderCommandPacket& b)
-            {
-                if (glm::abs(a.DistanceToCamera - b.DistanceToCamera) < 0.001f)
-                    return a.EntityID < b.EntityID;
+        // The transparent pass needs the opaque depth copied over, which only works from an offscreen target
+        bool weightedBlended = s_Data.Transparency == TransparencyMode::WeightedBlended && !s_Data.TransparentQueue.empty()
+            && s_Data.CurrentRenderTarget && s_Data.CurrentRenderTarget->GetSpecification().Samples == 1;
 
-                return a.DistanceToCamera > b.DistanceToCamera;
-            });
+        if (weightedBlended)
+        {
+            GPUProfileScope scope("Transparent");
+            ExecuteWeightedBlendedTransparency(targetWidth, targetHeight);
+        }
+        else
+        {
+            RenderCommand::SetBlend(true);
+            RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::SrcAlpha, RendererAPI::BlendFactor::OneMinusSrcAlpha);
 
-        ExecuteQueue(s_Data.TransparentQueue);
+            std::sort(s_Data.TransparentQueue.begin(), s_Data.TransparentQueue.end(),
+                [](const RenderCommandPacket& a, const RenderCommandPacket& b)
+                {
+                    if (glm::abs(a.DistanceToCamera - b.DistanceToCamera) < 0.001f)
+                        return a.EntityID < b.EntityID;
+
+                    return a.DistanceToCamera > b.DistanceToCamera;
+                });
+
+            GPUProfileScope scope("Transparent");
+            ExecuteQueue(s_Data.TransparentQueue);
+        }
+
+        s_Data.Stats.TransparentDrawCalls = s_Data.Stats.DrawCalls - opaqueDrawCalls;
 
         RenderCommand::SetDepthMask(true); 
         RenderCommand::SetBlend(false);
 
         if (!s_Data.LineVertices.empty())
         {
+            GPUProfileScope scope("Lines");
+
             s_Data.LineVBO->SetData(s_Data.LineVertices.data(), s_Data.LineVertices.size() * sizeof(LineVertex));
 
             s_Data.LineShader->Bind();
@@ -675,6 +823,135 @@ namespace RXNEngine {
             FlushBatch(batchStart->Mesh, batchStart->SubmeshIndex, batchStart->Material, currentBatchData, transformCount);
     }
 
+    void Renderer::ExecuteDepthPrePass(const std::vector<RenderCommandPacket>& queue)
+    {
+        OPTICK_EVENT();
+
+        if (queue.empty()) return;
+
+        s_Data.DepthPrePassShader->Bind();
+        s_Data.DepthPrePassShader->SetMat4("u_ViewProjection", s_Data.ViewProjectionMatrix);
+        s_Data.CurrentShaderID = s_Data.DepthPrePassShader->GetRendererID();
+
+        static InstanceData batchData[MaxInstances];
+        uint32_t transformCount = 0;
+
+        // Material doesn't matter for depth, consecutive instances of a submesh go in one draw
+        auto drawBatch = [&](const RenderCommandPacket& packet)
+            {
+                s_Data.InstanceVertexBuffer->SetData(batchData, transformCount * sizeof(InstanceData));
+
+                const auto& vertexArray = packet.Mesh->GetPositionVertexArray();
+                const auto& submesh = packet.Mesh->GetSubmeshes()[packet.SubmeshIndex];
+                RenderCommand::DrawIndexedInstanced(vertexArray, s_Data.InstanceVertexBuffer, transformCount, submesh.IndexCount, submesh.BaseIndex);
+
+                s_Data.Stats.DrawCalls++;
+                s_Data.Stats.PrePassDrawCalls++;
+                s_Data.Stats.Instances += transformCount;
+                s_Data.Stats.TotalIndices += submesh.IndexCount * transformCount;
+            };
+
+        auto batchStart = queue.begin();
+        for (auto it = queue.begin(); it != queue.end(); ++it)
+        {
+            bool isSameMesh = (it->Mesh == batchStart->Mesh && it->SubmeshIndex == batchStart->SubmeshIndex);
+
+            if (!isSameMesh || transformCount == MaxInstances)
+            {
+                drawBatch(*batchStart);
+
+                batchStart = it;
+                transformCount = 0;
+            }
+
+            batchData[transformCount].Transform = it->Transform;
+            batchData[transformCount].EntityID = it->EntityID;
+            transformCount++;
+        }
+
+        drawBatch(*batchStart);
+    }
+
+    bool Renderer::ShouldUseDepthPrePass(float depthComplexity)
+    {
+        switch (s_Data.PrePassMode)
+        {
+            case DepthPrePassMode::Off: return false;
+            case DepthPrePassMode::On:  return true;
+            case DepthPrePassMode::Auto:
+            {
+                if (depthComplexity > s_PrePassEnableComplexity)
+                    s_Data.AutoPrePassActive = true;
+                else if (depthComplexity < s_PrePassDisableComplexity)
+                    s_Data.AutoPrePassActive = false;
+
+                return s_Data.AutoPrePassActive;
+            }
+        }
+
+        return false;
+    }
+
+    void Renderer::ExecuteWeightedBlendedTransparency(uint32_t width, uint32_t height)
+    {
+        OPTICK_EVENT();
+
+        if (!s_Data.OITTarget)
+        {
+            RenderTargetSpecification spec;
+            spec.Width = width;
+            spec.Height = height;
+            spec.Attachments = { RenderTargetTextureFormat::RGBA16F, RenderTargetTextureFormat::R16F, RenderTargetTextureFormat::Depth };
+            s_Data.OITTarget = RenderTarget::Create(spec);
+        }
+        else if (s_Data.OITTarget->GetSpecification().Width != width || s_Data.OITTarget->GetSpecification().Height != height)
+        {
+            s_Data.OITTarget->Resize(width, height);
+        }
+
+        // Both colour targets accumulate from zero, the opaque depth goes in after the clear
+        s_Data.OITTarget->Bind();
+        RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
+        RenderCommand::SetDepthMask(true);
+        RenderCommand::Clear();
+        s_Data.CurrentRenderTarget->CopyDepthTo(s_Data.OITTarget);
+        RenderCommand::SetDepthMask(false);
+
+        RenderCommand::SetBlend(true);
+        RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::One, RendererAPI::BlendFactor::One);
+
+        // Additive blending doesn't care about order, grouping by state lets the queue batch like the opaque one
+        std::sort(s_Data.TransparentQueue.begin(), s_Data.TransparentQueue.end(),
+            [](const RenderCommandPacket& a, const RenderCommandPacket& b)
+            {
+                if (a.SortKey != b.SortKey)
+                    return a.SortKey < b.SortKey;
+
+                return a.Material.get() < b.Material.get();
+            });
+
+        // u_WeightedOIT is set when a batch binds its shader, forget the bound one so the opaque state doesn't carry over
+        s_Data.CurrentShaderID = 0;
+        s_Data.WeightedOIT = true;
+        ExecuteQueue(s_Data.TransparentQueue);
+        s_Data.WeightedOIT = false;
+
+        s_Data.CurrentRenderTarget->Bind();
+        RenderCommand::SetDepthTest(false);
+        RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::SrcAlpha, RendererAPI::BlendFactor::OneMinusSrcAlpha);
+
+        s_Data.OITCompositeShader->Bind();
+        s_Data.CurrentShaderID = s_Data.OITCompositeShader->GetRendererID();
+
+        RenderCommand::BindTextureID(0, s_Data.OITTarget->GetColorAttachmentRendererID(0));
+        RenderCommand::BindTextureID(1, s_Data.OITTarget->GetColorAttachmentRendererID(1));
+
+        s_Data.ScreenQuadVAO->Bind();
+        RenderCommand::DrawIndexed(s_Data.ScreenQuadVAO);
+
+        RenderCommand::SetDepthTest(true);
+    }
+
     void Renderer::FlushBatch(const Ref<StaticMesh>& mesh, uint32_t submeshIndex, const Ref<Material>& material, const InstanceData* instanceData, uint32_t count)
     {
         OPTICK_EVENT();
@@ -691,6 +968,7 @@ namespace RXNEngine {
             shader->SetMat4("u_ViewProjection", s_Data.ViewProjectionMatrix);
             shader->SetFloat3("u_CameraPosition", s_Data.CameraPosition);
             shader->SetMat4("u_View", s_Data.ViewMatrix);
+            shader->SetInt("u_WeightedOIT", s_Data.WeightedOIT ? 1 : 0);
         }
 
         mesh->GetVertexArray()->Bind();
@@ -35,8 +35,29 @@ namespace RXNEngine {
         uint32_t DrawCalls = 0;
         uint32_t Instances = 0;
         uint32_t TotalIndices = 0;
+        uint32_t PrePassDrawCalls = 0;
+        uint32_t TransparentDrawCalls = 0;
 
-        void Reset() { DrawCalls = 0; Instances = 0; TotalIndices = 0; }
+        // Opaque fragments shaded per pixel of the target, measured with an occlusion query a few frames late
+        float OpaqueOverdraw = 0.0f;
+        // Summed screen coverage of the opaque queue estimated on the CPU, what DepthPrePassMode::Auto decides on
+        float EstimatedDepthComplexity = 0.0f;
+        bool DepthPrePass = false;
+
+        void Reset() { DrawCalls = 0; Instances = 0; TotalIndices = 0; PrePassDrawCalls = 0; TransparentDrawCalls = 0; }
+    };
+
+    enum class DepthPrePassMode
+    {
+        Off = 0,
+        On,
+        Auto // Only when the opaque queue overlaps itself enough to pay for the extra geometry pass
+    };
+
+    enum class TransparencyMode
+    {
+        Sorted = 0,     // Back to front with regular alpha blending, exact for separate surfaces but barely batches
+        WeightedBlended // Order independent approximation, drawn unsorted and instanced like the opaque queue
     };
 
     class Renderer
@@ -76,11 +97,20 @@ namespace RXNEngine {
         static RendererStatistics GetStats();
         static void ResetStats();
 
+        static void SetDepthPrePassMode(DepthPrePassMode mode);
+        static DepthPrePassMode GetDepthPrePassMode();
+
+        static void SetTransparencyMode(TransparencyMode mode);
+        static TransparencyMode GetTransparencyMode();
+
         static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
     private:
         static void PrepareScene(const glm::mat4& viewProjection, const glm::mat4& viewMatrix, const glm::vec3& cameraPosition, float cameraFOV,
             const LightEnvironment& lights, const Ref<Cubemap>& environment, const Ref<RenderTarget>& renderTarget);
         static void ExecuteQueue(const std::vector<RenderCommandPacket>& queue);
+        static void ExecuteDepthPrePass(const std::vector<RenderCommandPacket>& queue);
+        static bool ShouldUseDepthPrePass(float depthComplexity);
+        static void ExecuteWeightedBlendedTransparency(uint32_t width, uint32_t height);
         static void FlushBatch(const Ref<StaticMesh>& mesh, uint32_t submeshIndex, const Ref<Material>& material, const InstanceData* instanceData, uint32_t count);
         static void Flush();
         static void FlushShadows();
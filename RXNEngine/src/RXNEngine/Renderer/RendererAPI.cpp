@@ -1,9 +1,29 @@
 #include "rxnpch.h"
 #include "RendererAPI.h"
 
+#include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 
 namespace RXNEngine {
 
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
 
+	void RendererAPI::SetAPI(API api)
+	{
+		s_API = api;
+	}
+
+	Scope<RendererAPI> RendererAPI::Create()
+	{
+		switch (s_API)
+		{
+			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateScope<OpenGLRendererAPI>();
+			case RendererAPI::API::Null:    return CreateScope<NullRendererAPI>();
+		}
+
+		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
 }
\ No newline at end of file
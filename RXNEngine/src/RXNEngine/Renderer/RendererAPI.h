@@ -11,7 +11,9 @@ namespace RXNEngine {
 	public:
 		enum class API
 		{
-			None = 0, OpenGL
+			None = 0, OpenGL,
+			// Headless, every call is a no-op. Used by dedicated servers and CPU benchmarks
+			Null
 		};
 
 		enum class DepthFunc
@@ -113,7 +115,15 @@ namespace RXNEngine {
 
 		virtual void SetLineWidth(float width) = 0;
 
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
+		// Makes image and storage buffer writes of earlier dispatches visible to later dispatches, texture fetches and draws
+		virtual void ComputeBarrier() = 0;
+
 		inline static API GetAPI() { return s_API; }
+		// Must be called before Renderer::Init, resources created afterwards belong to the selected API
+		static void SetAPI(API api);
+
+		static Scope<RendererAPI> Create();
 	private:
 		static API s_API;
 	};
@@ -2,10 +2,18 @@
 #include "SceneRenderer.h"
 #include "RXNEngine/Renderer/Renderer.h"
 #include "RXNEngine/Renderer/RenderCommand.h"
+#include "RXNEngine/Renderer/GPUProfiler.h"
 #include "RXNEngine/Scene/Entity.h"
 
 namespace RXNEngine {
 
+    // Render scale moves in steps so pooled targets aren't reallocated for every small correction
+    static constexpr float s_RenderScaleStep = 0.05f;
+    // Frames to wait after a change before judging it, the frame timers lag a few frames behind
+    static constexpr uint32_t s_RenderScaleSettleFrames = 15;
+    // Image units the compute downsample binds at once
+    static constexpr uint32_t s_MaxBloomMips = 8;
+
     SceneRenderer::SceneRenderer(Ref<Scene> scene, const SceneRendererSpecification& spec)
         : m_Scene(scene), m_Specification(spec)
     {
@@ -18,35 +26,24 @@ namespace RXNEngine {
 
     void SceneRenderer::Init()
     {
-        RenderTargetSpecification geoSpec;
-        geoSpec.Attachments = { RenderTargetTextureFormat::RGBA16F, RenderTargetTextureFormat::Depth };
-        geoSpec.Width = 1280;
-        geoSpec.Height = 720;
-        m_GeoPass = RenderTarget::Create(geoSpec);
-
-        RenderTargetSpecification finalSpec;
-        finalSpec.Attachments = { RenderTargetTextureFormat::RGBA8 };
-        finalSpec.Width = 1280;
-        finalSpec.Height = 720;
-        m_FinalPass = RenderTarget::Create(finalSpec);
-
-        RenderTargetSpecification pickSpec;
-        pickSpec.Attachments = { RenderTargetTextureFormat::RED_INTEGER, RenderTargetTextureFormat::Depth };
-        pickSpec.Width = 1280;
-        pickSpec.Height = 720;
-        m_PickingPass = RenderTarget::Create(pickSpec);
-
-        RenderTargetSpecification maskSpec;
-        maskSpec.Attachments = { RenderTargetTextureFormat::RGBA8 };
-        maskSpec.Width = 1280;
-        maskSpec.Height = 720;
-        m_OutlineMaskPass = RenderTarget::Create(maskSpec);
+        m_ViewportWidth = 1280;
+        m_ViewportHeight = 720;
+        m_RenderWidth = m_ViewportWidth;
+        m_RenderHeight = m_ViewportHeight;
+
+        for (auto& timer : m_FrameTimers)
+            timer = TimerQuery::Create();
 
+        m_FinalPass = RenderTarget::Create(CreateTargetSpec({ RenderTargetTextureFormat::RGBA8 }, m_ViewportWidth, m_ViewportHeight));
 
         m_PostProcessShader = Shader::Create("res/shaders/postprocess/screen.glsl");
         m_BloomDownsampleShader = Shader::Create("res/shaders/postprocess/bloom_downsample.glsl");
         m_BloomUpsampleShader = Shader::Create("res/shaders/postprocess/bloom_upsample.glsl");
+        m_BloomComputeDownsampleShader = Shader::Create("res/shaders/postprocess/bloom_downsample_compute.glsl");
+        m_BloomComputeUpsampleShader = Shader::Create("res/shaders/postprocess/bloom_upsample_compute.glsl");
+        m_BloomGroupCounter = StorageBuffer::Create(sizeof(uint32_t), 0);
         m_PickingShader = Shader::Create("res/shaders/editor_picking.glsl");
+        m_PickingReadback = PixelReadback::Create();
         m_GridShader = Shader::Create("res/shaders/grid.glsl");
         m_OutlineMaskShader = Shader::Create("res/shaders/outline_mask.glsl");
 
@@ -84,108 +81,214 @@ namespace RXNEngine {
             m_ViewportWidth = width;
             m_ViewportHeight = height;
 
-            m_GeoPass->Resize(width, height);
             m_FinalPass->Resize(width, height);
-            m_PickingPass->Resize(width, height);
-            m_OutlineMaskPass->Resize(width, height);
 
-            m_BloomMips.clear();
+            // Pooled targets are sized lazily when the next frame acquires them, idle ones of the old size can go now
+            m_TargetPool.ReleaseUnused();
+        }
+    }
 
-            glm::vec2 mipSize = { (float)width, (float)height };
-            glm::ivec2 mipIntSize = { width, height };
+    RenderTargetSpecification SceneRenderer::CreateTargetSpec(std::initializer_list<RenderTargetTextureSpecification> attachments, uint32_t width, uint32_t height) const
+    {
+        RenderTargetSpecification spec;
+        spec.Attachments = attachments;
+        spec.Width = width;
+        spec.Height = height;
+        return spec;
+    }
 
-            const uint32_t bloomMipCount = 6;
-            for (uint32_t i = 0; i < bloomMipCount; i++)
-            {
-                mipSize *= 0.5f;
-                mipIntSize /= 2;
+    void SceneRenderer::BeginFrame()
+    {
+        m_TargetPool.BeginFrame();
+
+        Renderer::SetDepthPrePassMode(m_Settings.DepthPrePass);
+        Renderer::SetTransparencyMode(m_Settings.Transparency);
+        UpdateRenderScale();
 
-                if (mipIntSize.x == 0 || mipIntSize.y == 0)
-                    break;
+        m_RenderWidth = std::max(1u, (uint32_t)std::round(m_ViewportWidth * m_RenderScale));
+        m_RenderHeight = std::max(1u, (uint32_t)std::round(m_ViewportHeight * m_RenderScale));
 
-                RenderTargetSpecification spec;
-                spec.Attachments = { RenderTargetTextureFormat::RGBA16F };
-                spec.Width = mipIntSize.x;
-                spec.Height = mipIntSize.y;
+        uint32_t currentTimer = m_FrameIndex % s_FrameTimerCount;
+        m_FrameTimers[currentTimer]->Begin();
+    }
 
-                m_BloomMips.push_back({ mipSize, RenderTarget::Create(spec) });
-            }
+    void SceneRenderer::UpdateRenderScale()
+    {
+        OPTICK_EVENT();
+
+        for (uint32_t i = 0; i < s_FrameTimerCount; i++)
+        {
+            if (!m_FrameTimerPending[i] || !m_FrameTimers[i]->IsResultAvailable())
+                continue;
+
+            // Smoothed so single spikes don't bounce the resolution around
+            float frameTime = m_FrameTimers[i]->GetElapsedTime() / 1000000.0f;
+            m_GPUFrameTime = m_GPUFrameTime > 0.0f ? glm::mix(m_GPUFrameTime, frameTime, 0.1f) : frameTime;
+            m_FrameTimerPending[i] = false;
         }
+
+        m_FrameTimerPending[m_FrameIndex % s_FrameTimerCount] = false;
+        m_FramesSinceScaleChange++;
+
+        float minScale = std::clamp(m_Settings.MinRenderScale, 0.1f, 1.0f);
+        float maxScale = std::clamp(m_Settings.MaxRenderScale, minScale, 1.0f);
+
+        if (!m_Settings.DynamicResolution)
+        {
+            m_RenderScale = 1.0f;
+            return;
+        }
+
+        if (m_GPUFrameTime <= 0.0f || m_FramesSinceScaleChange < s_RenderScaleSettleFrames)
+        {
+            m_RenderScale = std::clamp(m_RenderScale, minScale, maxScale);
+            return;
+        }
+
+        // GPU cost follows the pixel count, so the scale goes with the square root of the time ratio
+        float desiredScale = m_RenderScale * std::sqrt(m_Settings.TargetFrameTime / m_GPUFrameTime);
+        desiredScale = std::clamp(desiredScale, minScale, maxScale);
+
+        if (std::abs(desiredScale - m_RenderScale) < s_RenderScaleStep)
+            return;
+
+        float renderScale = std::clamp(std::round(desiredScale / s_RenderScaleStep) * s_RenderScaleStep, minScale, maxScale);
+        if (renderScale != m_RenderScale)
+        {
+            m_RenderScale = renderScale;
+            m_FramesSinceScaleChange = 0;
+        }
+    }
+
+    void SceneRenderer::EndFrame()
+    {
+        m_TargetPool.EndFrame();
+
+        uint32_t currentTimer = m_FrameIndex % s_FrameTimerCount;
+        m_FrameTimers[currentTimer]->End();
+        m_FrameTimerPending[currentTimer] = true;
+        m_FrameIndex++;
+    }
+
+    void SceneRenderer::ExecuteGraph(RenderGraph& graph)
+    {
+        OPTICK_EVENT();
+
+        graph.Compile();
+        graph.Execute();
+
+        m_GraphInfo = graph.GetInfo();
     }
 
     void SceneRenderer::RenderEditor(EditorCamera& camera, Entity selectedEntity)
     {
         OPTICK_EVENT();
 
-        m_OutlineMaskPass->Bind();
-        RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
-        RenderCommand::Clear();
+        BeginFrame();
 
-        if (selectedEntity)
         {
-            RenderCommand::SetDepthTest(false);
+            RenderGraph graph(m_TargetPool);
 
-            m_OutlineMaskShader->Bind();
-            m_OutlineMaskShader->SetMat4("u_ViewProjection", camera.GetViewProjection());
+            RenderGraphResource finalColor = graph.ImportTarget("Final Color", m_FinalPass);
+            RenderGraphResource sceneColor = graph.CreateTarget("Scene Color", CreateTargetSpec({ RenderTargetTextureFormat::RGBA16F, RenderTargetTextureFormat::Depth }, m_RenderWidth, m_RenderHeight));
+            RenderGraphResource outlineMask = graph.CreateTarget("Outline Mask", CreateTargetSpec({ RenderTargetTextureFormat::RGBA8 }, m_ViewportWidth, m_ViewportHeight));
 
-            auto drawOutline = [&](Entity entity, auto& drawOutlineRef) -> void
+            graph.AddPass("Outline Mask",
+                [&](RenderGraphBuilder& builder)
+                {
+                    builder.Write(outlineMask);
+                },
+                [&](const RenderGraph& resources)
                 {
-                    if (entity.HasComponent<StaticMeshComponent>())
-                    {
-                        auto& mc = entity.GetComponent<StaticMeshComponent>();
-                        if (mc.Mesh)
-                            Renderer::DrawEntityOutline(mc.Mesh, mc.SubmeshIndex, m_Scene->GetWorldTransform(entity), m_OutlineMaskShader);
-                    }
-
-                    if (entity.HasComponent<RelationshipComponent>())
-                    {
-                        for (UUID childID : entity.GetComponent<RelationshipComponent>().Children)
+                    resources.GetTarget(outlineMask)->Bind();
+                    RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
+                    RenderCommand::Clear();
+
+                    RenderCommand::SetDepthTest(false);
+
+                    m_OutlineMaskShader->Bind();
+                    m_OutlineMaskShader->SetMat4("u_ViewProjection", camera.GetViewProjection());
+
+                    auto drawOutline = [&](Entity entity, auto& drawOutlineRef) -> void
                         {
-                            Entity child = m_Scene->GetEntityByUUID(childID);
-                            if (child) drawOutlineRef(child, drawOutlineRef);
-                        }
-                    }
-                };
+                            if (entity.HasComponent<StaticMeshComponent>())
+                            {
+                                auto& mc = entity.GetComponent<StaticMeshComponent>();
+                                if (mc.Mesh)
+                                    Renderer::DrawEntityOutline(mc.Mesh, mc.SubmeshIndex, m_Scene->GetWorldTransform(entity), m_OutlineMaskShader);
+                            }
+
+                            if (entity.HasComponent<RelationshipComponent>())
+                            {
+                                for (UUID childID : entity.GetComponent<RelationshipComponent>().Children)
+                                {
+                                    Entity child = m_Scene->GetEntityByUUID(childID);
+                                    if (child) drawOutlineRef(child, drawOutlineRef);
+                                }
+                            }
+                        };
+
+                    drawOutline(selectedEntity, drawOutline);
+                    RenderCommand::SetDepthTest(true);
+
+                    resources.GetTarget(outlineMask)->Unbind();
+                });
+
+            graph.AddPass("Geometry",
+                [&](RenderGraphBuilder& builder)
+                {
+                    builder.Write(sceneColor);
+                },
+                [&](const RenderGraph& resources)
+                {
+                    Ref<RenderTarget> target = resources.GetTarget(sceneColor);
+                    target->Bind();
+                    RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+                    RenderCommand::Clear();
 
-            drawOutline(selectedEntity, drawOutline);
-            RenderCommand::SetDepthTest(true);
-        }
-        m_OutlineMaskPass->Unbind();
+                    m_Scene->OnRenderEditor(0.0f, camera, target, m_Settings.ShowColliders);
+                });
 
-        m_GeoPass->Bind();
-        RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
-        RenderCommand::Clear();
+            graph.AddPass("Grid",
+                [&](RenderGraphBuilder& builder)
+                {
+                    builder.Write(sceneColor);
+                },
+                [&](const RenderGraph& resources)
+                {
+                    Ref<RenderTarget> target = resources.GetTarget(sceneColor);
+                    target->Bind();
+
+                    RenderCommand::SetBlend(true);
+                    RenderCommand::SetDepthTest(true);
+                    RenderCommand::SetCullFace(RendererAPI::CullFace::None);
 
-        m_Scene->OnRenderEditor(0.0f, camera, m_GeoPass, m_Settings.ShowColliders);
+                    m_GridShader->Bind();
+                    m_GridShader->SetMat4("u_ViewProjection", camera.GetViewProjection());
+                    m_GridShader->SetFloat3("u_CameraPos", camera.GetPosition());
+                    m_GridQuadVAO->Bind();
+                    RenderCommand::DrawIndexed(m_GridQuadVAO);
 
-        m_GeoPass->Bind();
+                    RenderCommand::SetCullFace(RendererAPI::CullFace::Back);
+                    target->Unbind();
+                });
 
-        RenderCommand::SetBlend(true);
-        RenderCommand::SetDepthTest(true);
-        RenderCommand::SetCullFace(RendererAPI::CullFace::None);
+            RenderGraphResource bloom = AddBloomPass(graph, sceneColor);
 
-        m_GridShader->Bind();
-        m_GridShader->SetMat4("u_ViewProjection", camera.GetViewProjection());
-        m_GridShader->SetFloat3("u_CameraPos", camera.GetPosition());
-        m_GridQuadVAO->Bind();
-        RenderCommand::DrawIndexed(m_GridQuadVAO);
+            // Nothing reads the mask without a selection, so the outline pass is culled
+            AddPostProcessPass(graph, sceneColor, bloom, selectedEntity ? outlineMask : InvalidRenderGraphResource, finalColor);
 
-        RenderCommand::SetCullFace(RendererAPI::CullFace::Back);
-        m_GeoPass->Unbind();
+            graph.MarkOutput(finalColor);
+            ExecuteGraph(graph);
+        }
 
-        RenderBloom();
-        RenderPostProcess();
+        EndFrame();
     }
 
     void SceneRenderer::RenderRuntime()
     {
         OPTICK_EVENT();
 
-        m_OutlineMaskPass->Bind();
-        RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
-        RenderCommand::Clear();
-        m_OutlineMaskPass->Unbind();
-
         Entity cameraEntity = m_Scene->GetPrimaryCameraEntity();
 
         if (!cameraEntity)
@@ -194,137 +297,341 @@ namespace RXNEngine {
         Camera& camera = cameraEntity.GetComponent<CameraComponent>().Camera;
         glm::mat4 transform = m_Scene->GetWorldTransform(cameraEntity);
 
-        m_GeoPass->Bind();
-        RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
-        RenderCommand::SetDepthTest(true);
-        RenderCommand::Clear();
+        BeginFrame();
 
-        m_Scene->OnRender(camera, transform, m_GeoPass, m_Settings.ShowColliders);
+        {
+            RenderGraph graph(m_TargetPool);
 
-        m_GeoPass->Unbind();
+            RenderGraphResource finalColor = graph.ImportTarget("Final Color", m_FinalPass);
+            RenderGraphResource sceneColor = graph.CreateTarget("Scene Color", CreateTargetSpec({ RenderTargetTextureFormat::RGBA16F, RenderTargetTextureFormat::Depth }, m_RenderWidth, m_RenderHeight));
 
-        RenderBloom();
-        RenderPostProcess();
+            graph.AddPass("Geometry",
+                [&](RenderGraphBuilder& builder)
+                {
+                    builder.Write(sceneColor);
+                },
+                [&](const RenderGraph& resources)
+                {
+                    Ref<RenderTarget> target = resources.GetTarget(sceneColor);
+                    target->Bind();
+                    RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+                    RenderCommand::SetDepthTest(true);
+                    RenderCommand::Clear();
+
+                    m_Scene->OnRender(camera, transform, target, m_Settings.ShowColliders);
+
+                    target->Unbind();
+                });
+
+            RenderGraphResource bloom = AddBloomPass(graph, sceneColor);
+            AddPostProcessPass(graph, sceneColor, bloom, InvalidRenderGraphResource, finalColor);
+
+            graph.MarkOutput(finalColor);
+            ExecuteGraph(graph);
+        }
+
+        EndFrame();
     }
 
     int SceneRenderer::GetEntityIDAtMouse(int x, int y, const EditorCamera& camera)
     {
-        m_PickingPass->Bind();
-        RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
-        RenderCommand::Clear();
-        m_PickingPass->ClearAttachment(0, -1);
+        Ref<RenderTarget> pickingPass = m_TargetPool.Acquire(CreateTargetSpec({ RenderTargetTextureFormat::RED_INTEGER, RenderTargetTextureFormat::Depth }, m_ViewportWidth, m_ViewportHeight));
 
-        m_PickingShader->Bind();
-        m_PickingShader->SetMat4("u_ViewProjection", camera.GetViewProjection());
+        RenderPickingPass(pickingPass, camera);
 
-        Renderer::ExecutePickingPass(m_PickingShader);
+        int pixelData = pickingPass->ReadPixel(0, x, y);
+        pickingPass->Unbind();
 
-        int pixelData = m_PickingPass->ReadPixel(0, x, y);
-        m_PickingPass->Unbind();
+        m_TargetPool.Release(pickingPass);
 
         return pixelData;
     }
 
-    void SceneRenderer::RenderPostProcess()
+    int SceneRenderer::GetEntityIDAtRay(const Ray& ray)
+    {
+        Entity entity = m_Scene->PickEntity(ray);
+        return entity ? (int)(uint32_t)entity : -1;
+    }
+
+    void SceneRenderer::RequestEntityIDAtMouse(int x, int y, const EditorCamera& camera)
     {
         OPTICK_EVENT();
 
-        m_FinalPass->Bind();
+        Ref<RenderTarget> pickingPass = m_TargetPool.Acquire(CreateTargetSpec({ RenderTargetTextureFormat::RED_INTEGER, RenderTargetTextureFormat::Depth }, m_ViewportWidth, m_ViewportHeight));
+
+        RenderPickingPass(pickingPass, camera);
+
+        m_PickingReadback->Request(0, x, y);
+        pickingPass->Unbind();
 
-        RenderCommand::SetDepthTest(false);
+        // The readback copies into its own buffer, so the target can be reused straight away
+        m_TargetPool.Release(pickingPass);
+    }
+
+    bool SceneRenderer::PollEntityIDAtMouse(int& outEntityID)
+    {
+        return m_PickingReadback->Poll(outEntityID);
+    }
+
+    void SceneRenderer::RenderPickingPass(const Ref<RenderTarget>& pickingPass, const EditorCamera& camera)
+    {
+        OPTICK_EVENT();
+        GPUProfileScope timer("Picking");
+
+        pickingPass->Bind();
+        RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
         RenderCommand::Clear();
+        pickingPass->ClearAttachment(0, -1);
 
-        m_PostProcessShader->Bind();
-        m_PostProcessShader->SetInt("u_ScreenTexture", 0);
-        m_PostProcessShader->SetInt("u_BloomTexture", 1);
-        m_PostProcessShader->SetInt("u_OutlineTexture", 2);
+        m_PickingShader->Bind();
+        m_PickingShader->SetMat4("u_ViewProjection", camera.GetViewProjection());
+
+        Renderer::ExecutePickingPass(m_PickingShader);
+    }
 
-        const auto& spec = m_FinalPass->GetSpecification();
-        m_PostProcessShader->SetFloat2("u_TexelSize", glm::vec2(1.0f / spec.Width, 1.0f / spec.Height));
+    void SceneRenderer::AddPostProcessPass(RenderGraph& graph, RenderGraphResource sceneColor, RenderGraphResource bloom, RenderGraphResource outlineMask, RenderGraphResource output)
+    {
+        // Bloom that contributes nothing isn't read, which lets the graph cull the whole bloom chain
+        if (m_Settings.BloomIntensity <= 0.0f)
+            bloom = InvalidRenderGraphResource;
+
+        graph.AddPass("Post Process",
+            [=](RenderGraphBuilder& builder)
+            {
+                builder.Read(sceneColor);
+                if (bloom != InvalidRenderGraphResource)
+                    builder.Read(bloom);
+                if (outlineMask != InvalidRenderGraphResource)
+                    builder.Read(outlineMask);
+                builder.Write(output);
+            },
+            [=, this](const RenderGraph& resources)
+            {
+                Ref<RenderTarget> target = resources.GetTarget(output);
+                target->Bind();
 
-        m_PostProcessShader->SetFloat("u_Exposure", m_Settings.Exposure);
-        m_PostProcessShader->SetFloat("u_Gamma", m_Settings.Gamma);
-        m_PostProcessShader->SetFloat("u_BloomIntensity", m_Settings.BloomIntensity);
+                RenderCommand::SetDepthTest(false);
+                RenderCommand::Clear();
 
-        RenderCommand::BindTextureID(0, m_GeoPass->GetColorAttachmentRendererID());
+                m_PostProcessShader->Bind();
+                m_PostProcessShader->SetInt("u_ScreenTexture", 0);
+                m_PostProcessShader->SetInt("u_BloomTexture", 1);
+                m_PostProcessShader->SetInt("u_OutlineTexture", 2);
 
-        if (!m_BloomMips.empty())
-            RenderCommand::BindTextureID(1, m_BloomMips[0].Target->GetColorAttachmentRendererID());
+                const auto& spec = target->GetSpecification();
+                m_PostProcessShader->SetFloat2("u_TexelSize", glm::vec2(1.0f / spec.Width, 1.0f / spec.Height));
 
-        RenderCommand::BindTextureID(2, m_OutlineMaskPass->GetColorAttachmentRendererID());
+                m_PostProcessShader->SetFloat("u_Exposure", m_Settings.Exposure);
+                m_PostProcessShader->SetFloat("u_Gamma", m_Settings.Gamma);
+                m_PostProcessShader->SetFloat("u_BloomIntensity", m_Settings.BloomIntensity);
 
-        m_ScreenQuadVAO->Bind();
-        RenderCommand::DrawIndexed(m_ScreenQuadVAO);
+                // Bilinear is exact when nothing was scaled
+                const auto& sourceSpec = resources.GetSpecification(sceneColor);
+                bool upscaled = sourceSpec.Width != spec.Width || sourceSpec.Height != spec.Height;
+                m_PostProcessShader->SetInt("u_UpscaleFilter", upscaled ? (int)m_Settings.Upscale : (int)UpscaleFilter::Bilinear);
+                m_PostProcessShader->SetFloat2("u_ScreenSize", glm::vec2((float)sourceSpec.Width, (float)sourceSpec.Height));
 
-        RenderCommand::SetDepthTest(true);
+                RenderCommand::BindTextureID(0, resources.GetTarget(sceneColor)->GetColorAttachmentRendererID());
 
-        m_FinalPass->Unbind();
+                if (bloom != InvalidRenderGraphResource)
+                    RenderCommand::BindTextureID(1, resources.GetColorTextureID(bloom));
+                else
+                    Texture2D::BlackTexture()->Bind(1);
+
+                if (outlineMask != InvalidRenderGraphResource)
+                    RenderCommand::BindTextureID(2, resources.GetTarget(outlineMask)->GetColorAttachmentRendererID());
+                else
+                    Texture2D::BlackTexture()->Bind(2);
+
+                m_ScreenQuadVAO->Bind();
+                RenderCommand::DrawIndexed(m_ScreenQuadVAO);
+
+                RenderCommand::SetDepthTest(true);
+
+                target->Unbind();
+            });
     }
 
-    void SceneRenderer::RenderBloom()
+    RenderGraphResource SceneRenderer::AddBloomPass(RenderGraph& graph, RenderGraphResource sceneColor)
     {
-        OPTICK_EVENT();
+        if (m_Settings.ComputeBloom)
+            return AddComputeBloomPass(graph, sceneColor);
 
-        if (m_BloomMips.empty()) return;
+        const auto& sourceSpec = graph.GetSpecification(sceneColor);
 
-        RenderCommand::SetDepthTest(false);
-        m_ScreenQuadVAO->Bind();
+        glm::vec2 mipSize = { (float)sourceSpec.Width, (float)sourceSpec.Height };
+        glm::ivec2 mipIntSize = { sourceSpec.Width, sourceSpec.Height };
 
-        m_BloomDownsampleShader->Bind();
-        m_BloomDownsampleShader->SetInt("u_Texture", 0);
+        std::vector<BloomMip> mips;
 
-        float knee = m_Settings.BloomThreshold * m_Settings.BloomKnee;
-        glm::vec4 filter = {
-            m_Settings.BloomThreshold,
-            m_Settings.BloomThreshold - knee,
-            2.0f * knee,
-            0.25f / (knee + 0.00001f)
-        };
-        m_BloomDownsampleShader->SetFloat3("u_Threshold", filter);
+        const uint32_t bloomMipCount = std::min(m_Settings.BloomMipCount, s_MaxBloomMips);
+        for (uint32_t i = 0; i < bloomMipCount; i++)
+        {
+            mipSize *= 0.5f;
+            mipIntSize /= 2;
 
-        uint32_t currentTexture = m_GeoPass->GetColorAttachmentRendererID();
+            if (mipIntSize.x == 0 || mipIntSize.y == 0)
+                break;
 
-        for (uint32_t i = 0; i < m_BloomMips.size(); i++)
-        {
-            auto& mip = m_BloomMips[i];
+            mips.push_back({ mipSize, graph.CreateTarget("Bloom Mip " + std::to_string(i), CreateTargetSpec({ RenderTargetTextureFormat::RGBA16F }, mipIntSize.x, mipIntSize.y)) });
+        }
 
-            mip.Target->Bind();
-            RenderCommand::SetViewport(0, 0, mip.Size.x, mip.Size.y);
+        if (mips.empty())
+            return InvalidRenderGraphResource;
 
-            m_BloomDownsampleShader->SetInt("u_MipLevel", i);
-            m_BloomDownsampleShader->SetFloat2("u_TexelSize", glm::vec2(1.0f / mip.Size.x, 1.0f / mip.Size.y));
-            RenderCommand::BindTextureID(0, currentTexture);
+        graph.AddPass("Bloom",
+            [=](RenderGraphBuilder& builder)
+            {
+                builder.Read(sceneColor);
+                for (const auto& mip : mips)
+                    builder.Write(mip.Target);
+            },
+            [=, this](const RenderGraph& resources)
+            {
+                RenderCommand::SetDepthTest(false);
+                m_ScreenQuadVAO->Bind();
+
+                m_BloomDownsampleShader->Bind();
+                m_BloomDownsampleShader->SetInt("u_Texture", 0);
+
+                float knee = m_Settings.BloomThreshold * m_Settings.BloomKnee;
+                glm::vec4 filter = {
+                    m_Settings.BloomThreshold,
+                    m_Settings.BloomThreshold - knee,
+                    2.0f * knee,
+                    0.25f / (knee + 0.00001f)
+                };
+                m_BloomDownsampleShader->SetFloat4("u_Threshold", filter);
 
-            RenderCommand::DrawIndexed(m_ScreenQuadVAO);
+                uint32_t currentTexture = resources.GetTarget(sceneColor)->GetColorAttachmentRendererID();
 
-            currentTexture = mip.Target->GetColorAttachmentRendererID();
-            mip.Target->Unbind();
-        }
+                for (uint32_t i = 0; i < mips.size(); i++)
+                {
+                    const auto& mip = mips[i];
+                    Ref<RenderTarget> target = resources.GetTarget(mip.Target);
 
-        m_BloomUpsampleShader->Bind();
-        m_BloomUpsampleShader->SetInt("u_Texture", 0);
-        m_BloomUpsampleShader->SetFloat("u_FilterRadius", m_Settings.BloomFilterRadius);
+                    target->Bind();
+                    RenderCommand::SetViewport(0, 0, mip.Size.x, mip.Size.y);
 
-        RenderCommand::SetBlend(true);
-        RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::One, RendererAPI::BlendFactor::One);
-        RenderCommand::SetBlendEquation(RendererAPI::BlendEquation::Add);
+                    m_BloomDownsampleShader->SetInt("u_MipLevel", i);
+                    m_BloomDownsampleShader->SetFloat2("u_TexelSize", glm::vec2(1.0f / mip.Size.x, 1.0f / mip.Size.y));
+                    RenderCommand::BindTextureID(0, currentTexture);
 
-        for (int i = m_BloomMips.size() - 1; i > 0; i--)
-        {
-            auto& currentMip = m_BloomMips[i];
-            auto& nextMip = m_BloomMips[i - 1];
+                    RenderCommand::DrawIndexed(m_ScreenQuadVAO);
+
+                    currentTexture = target->GetColorAttachmentRendererID();
+                    target->Unbind();
+                }
+
+                m_BloomUpsampleShader->Bind();
+                m_BloomUpsampleShader->SetInt("u_Texture", 0);
+                m_BloomUpsampleShader->SetFloat("u_FilterRadius", m_Settings.BloomFilterRadius);
+
+                RenderCommand::SetBlend(true);
+                RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::One, RendererAPI::BlendFactor::One);
+                RenderCommand::SetBlendEquation(RendererAPI::BlendEquation::Add);
+
+                for (int i = mips.size() - 1; i > 0; i--)
+                {
+                    const auto& currentMip = mips[i];
+                    const auto& nextMip = mips[i - 1];
+                    Ref<RenderTarget> target = resources.GetTarget(nextMip.Target);
+
+                    target->Bind();
+                    RenderCommand::SetViewport(0, 0, nextMip.Size.x, nextMip.Size.y);
+
+                    RenderCommand::BindTextureID(0, resources.GetTarget(currentMip.Target)->GetColorAttachmentRendererID());
+
+                    RenderCommand::DrawIndexed(m_ScreenQuadVAO);
+
+                    target->Unbind();
+                }
+
+                RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::SrcAlpha, RendererAPI::BlendFactor::OneMinusSrcAlpha);
+                RenderCommand::SetDepthTest(true);
+            });
 
-            nextMip.Target->Bind();
-            RenderCommand::SetViewport(0, 0, nextMip.Size.x, nextMip.Size.y);
+        // Only the top mip is read later, the graph hands the rest back to the pool right after the bloom pass
+        return mips[0].Target;
+    }
+
+    RenderGraphResource SceneRenderer::AddComputeBloomPass(RenderGraph& graph, RenderGraphResource sceneColor)
+    {
+        const auto& sourceSpec = graph.GetSpecification(sceneColor);
 
-            RenderCommand::BindTextureID(0, currentMip.Target->GetColorAttachmentRendererID());
+        uint32_t width = (uint32_t)sourceSpec.Width / 2;
+        uint32_t height = (uint32_t)sourceSpec.Height / 2;
+        if (width == 0 || height == 0 || m_Settings.BloomMipCount == 0)
+            return InvalidRenderGraphResource;
 
-            RenderCommand::DrawIndexed(m_ScreenQuadVAO);
+        uint32_t mipCount = std::min({ m_Settings.BloomMipCount, s_MaxBloomMips, (uint32_t)std::floor(std::log2(std::min(width, height))) + 1 });
 
-            nextMip.Target->Unbind();
+        // Kept across frames, only rebuilt when the render resolution or mip count changes
+        if (!m_BloomTexture || m_BloomTexture->GetWidth() != width || m_BloomTexture->GetHeight() != height || m_BloomTexture->GetMipCount() != mipCount)
+        {
+            TextureSpecification spec;
+            spec.Width = width;
+            spec.Height = height;
+            spec.Format = ImageFormat::RGBA16F;
+            spec.GenerateMips = false;
+            spec.MipLevels = mipCount;
+            spec.ClampToEdge = true;
+            m_BloomTexture = Texture2D::Create(spec);
         }
 
-        RenderCommand::SetBlendFunc(RendererAPI::BlendFactor::SrcAlpha, RendererAPI::BlendFactor::OneMinusSrcAlpha);
-        RenderCommand::SetDepthTest(true);
+        RenderGraphResource bloom = graph.ImportTexture("Bloom", m_BloomTexture);
+
+        graph.AddPass("Bloom",
+            [=](RenderGraphBuilder& builder)
+            {
+                builder.Read(sceneColor);
+                builder.Write(bloom);
+            },
+            [=, this](const RenderGraph& resources)
+            {
+                Ref<Texture2D> texture = resources.GetTexture(bloom);
+
+                // Each group reduces a 32x32 tile of the first mip
+                uint32_t groupsX = (width + 31) / 32;
+                uint32_t groupsY = (height + 31) / 32;
+
+                float knee = m_Settings.BloomThreshold * m_Settings.BloomKnee;
+                glm::vec4 filter = {
+                    m_Settings.BloomThreshold,
+                    m_Settings.BloomThreshold - knee,
+                    2.0f * knee,
+                    0.25f / (knee + 0.00001f)
+                };
+
+                m_BloomComputeDownsampleShader->Bind();
+                m_BloomComputeDownsampleShader->SetInt("u_MipCount", (int)mipCount);
+                m_BloomComputeDownsampleShader->SetInt("u_GroupCount", (int)(groupsX * groupsY));
+                m_BloomComputeDownsampleShader->SetFloat4("u_Threshold", filter);
+
+                RenderCommand::BindTextureID(0, resources.GetTarget(sceneColor)->GetColorAttachmentRendererID());
+                for (uint32_t level = 0; level < mipCount; level++)
+                    texture->BindImage(level, level, ImageAccess::ReadWrite);
+
+                RenderCommand::DispatchCompute(groupsX, groupsY);
+                RenderCommand::ComputeBarrier();
+
+                m_BloomComputeUpsampleShader->Bind();
+                m_BloomComputeUpsampleShader->SetFloat("u_FilterRadius", m_Settings.BloomFilterRadius);
+                texture->Bind(0);
+
+                for (uint32_t level = mipCount - 1; level > 0; level--)
+                {
+                    uint32_t targetWidth = std::max(width >> (level - 1), 1u);
+                    uint32_t targetHeight = std::max(height >> (level - 1), 1u);
+
+                    m_BloomComputeUpsampleShader->SetInt("u_SourceLevel", (int)level);
+                    texture->BindImage(0, level - 1, ImageAccess::ReadWrite);
+
+                    RenderCommand::DispatchCompute((targetWidth + 7) / 8, (targetHeight + 7) / 8);
+                    RenderCommand::ComputeBarrier();
+                }
+            });
+
+        return bloom;
     }
 }
\ No newline at end of file
@@ -1,11 +1,19 @@
 #pragma once
 
 #include "RenderTarget.h"
+#include "RenderTargetPool.h"
+#include "RenderGraph.h"
+#include "Renderer.h"
 #include "RXNEngine/Scene/Scene.h"
 #include "RXNEngine/Scene/Entity.h"
 #include "RXNEngine/Scene/EditorCamera.h"
 #include "RXNEngine/Renderer/GraphicsAPI/VertexArray.h"
 #include "RXNEngine/Renderer/GraphicsAPI/Shader.h"
+#include "RXNEngine/Renderer/GraphicsAPI/PixelReadback.h"
+#include "RXNEngine/Renderer/GraphicsAPI/TimerQuery.h"
+#include "RXNEngine/Renderer/GraphicsAPI/StorageBuffer.h"
+
+#include <array>
 
 namespace RXNEngine {
 
@@ -17,12 +25,25 @@ namespace RXNEngine {
     struct BloomMip
     {
         glm::vec2 Size;
-        Ref<RenderTarget> Target;
+        RenderGraphResource Target;
     };
 
     class SceneRenderer
     {
     public:
+        enum class PickingMode
+        {
+            GPU = 0,   // Picking pass with a blocking readback
+            GPUAsync,  // Picking pass with a PBO readback, resolved a frame or two later
+            CPU        // Ray query against mesh triangles, no GPU involved
+        };
+
+        enum class UpscaleFilter
+        {
+            Bilinear = 0,
+            CatmullRom
+        };
+
         struct Settings
         {
             float Exposure = 1.0f;
@@ -35,6 +56,22 @@ namespace RXNEngine {
             float BloomKnee = 0.1f;
             float BloomIntensity = 0.04f;
             float BloomFilterRadius = 0.005f;
+            // Levels below the scene colour, more spreads the glow wider. At most 8
+            uint32_t BloomMipCount = 6;
+            // Builds the chain with a few compute dispatches instead of a target switch and draw per mip
+            bool ComputeBloom = true;
+
+            PickingMode Picking = PickingMode::CPU;
+            DepthPrePassMode DepthPrePass = DepthPrePassMode::Auto;
+            TransparencyMode Transparency = TransparencyMode::Sorted;
+
+            // Scales the geometry and bloom resolution between the bounds to hold the GPU frame time at the target,
+            // post-process upsamples back to the viewport
+            bool DynamicResolution = false;
+            float TargetFrameTime = 16.6f;
+            float MinRenderScale = 0.5f;
+            float MaxRenderScale = 1.0f;
+            UpscaleFilter Upscale = UpscaleFilter::CatmullRom;
         };
     public:
         SceneRenderer(Ref<Scene> scene, const SceneRendererSpecification& spec = SceneRendererSpecification());
@@ -53,34 +90,75 @@ namespace RXNEngine {
 
         Settings& GetSettings() { return m_Settings; }
         int GetEntityIDAtMouse(int x, int y, const EditorCamera& camera);
+        int GetEntityIDAtRay(const Ray& ray);
+
+        void RequestEntityIDAtMouse(int x, int y, const EditorCamera& camera);
+        bool PollEntityIDAtMouse(int& outEntityID);
+
+        RenderTargetPoolStatistics GetRenderTargetPoolStats() const { return m_TargetPool.GetStats(); }
+
+        float GetRenderScale() const { return m_RenderScale; }
+        // Smoothed, in milliseconds, lags a few frames behind
+        float GetGPUFrameTime() const { return m_GPUFrameTime; }
+        glm::uvec2 GetRenderResolution() const { return { m_RenderWidth, m_RenderHeight }; }
+
+        // Passes and targets of the last rendered frame, culled passes included
+        const RenderGraphInfo& GetRenderGraphInfo() const { return m_GraphInfo; }
 
      private:
-        void RenderPostProcess();
-        void RenderBloom();
+        void BeginFrame();
+        void EndFrame();
+        void UpdateRenderScale();
+
+        void ExecuteGraph(RenderGraph& graph);
+
+        RenderGraphResource AddBloomPass(RenderGraph& graph, RenderGraphResource sceneColor);
+        RenderGraphResource AddComputeBloomPass(RenderGraph& graph, RenderGraphResource sceneColor);
+        void AddPostProcessPass(RenderGraph& graph, RenderGraphResource sceneColor, RenderGraphResource bloom, RenderGraphResource outlineMask, RenderGraphResource output);
+        void RenderPickingPass(const Ref<RenderTarget>& pickingPass, const EditorCamera& camera);
+
+        RenderTargetSpecification CreateTargetSpec(std::initializer_list<RenderTargetTextureSpecification> attachments, uint32_t width, uint32_t height) const;
     private:
         Ref<Scene> m_Scene;
         SceneRendererSpecification m_Specification;
         Settings m_Settings;
 
-        Ref<RenderTarget> m_GeoPass;
+        RenderTargetPool m_TargetPool;
+
+        RenderGraphInfo m_GraphInfo;
+
         Ref<RenderTarget> m_FinalPass;
 
-        Ref<RenderTarget> m_PickingPass;
         Ref<Shader> m_PickingShader;
+        Ref<PixelReadback> m_PickingReadback;
 
         Ref<Shader> m_PostProcessShader;
         Ref<VertexArray> m_ScreenQuadVAO;
 
-        std::vector<BloomMip> m_BloomMips;
         Ref<Shader> m_BloomDownsampleShader;
         Ref<Shader> m_BloomUpsampleShader;
 
+        Ref<Shader> m_BloomComputeDownsampleShader;
+        Ref<Shader> m_BloomComputeUpsampleShader;
+        // Every bloom mip in one texture, level 0 is half the render resolution
+        Ref<Texture2D> m_BloomTexture;
+        Ref<StorageBuffer> m_BloomGroupCounter;
+
         Ref<Shader> m_GridShader;
         Ref<VertexArray> m_GridQuadVAO;
 
-        Ref<RenderTarget> m_OutlineMaskPass;
         Ref<Shader> m_OutlineMaskShader;
 
         uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
+        uint32_t m_RenderWidth = 0, m_RenderHeight = 0;
+
+        static constexpr uint32_t s_FrameTimerCount = 4;
+        std::array<Ref<TimerQuery>, s_FrameTimerCount> m_FrameTimers;
+        std::array<bool, s_FrameTimerCount> m_FrameTimerPending{};
+        uint32_t m_FrameIndex = 0;
+
+        float m_RenderScale = 1.0f;
+        float m_GPUFrameTime = 0.0f;
+        uint32_t m_FramesSinceScaleChange = 0;
     };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "RXNEngine/Renderer/Renderer.h"
 #include "ShadowMap.h"
 #include "Platform/OpenGL/OpenGLShadowMap.h"
+#include "Platform/Null/NullShadowMap.h"
 
 
 namespace RXNEngine {
@@ -12,6 +13,7 @@ namespace RXNEngine {
 		{
 			case RendererAPI::API::None:    RXN_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShadowMap>();
+			case RendererAPI::API::Null:    return CreateRef<NullShadowMap>();
 		}
 
 		RXN_CORE_ASSERT(false, "Unknown RendererAPI!");
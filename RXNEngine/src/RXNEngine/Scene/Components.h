@@ -124,6 +124,8 @@ namespace RXNEngine {
 	struct ScriptComponent
 	{
 		std::string ClassName;
+		// Runtime only, the entity's instance in the script engine, -1 while it has none
+		int32_t InstanceSlot = -1;
 
 		ScriptComponent() = default;
 		ScriptComponent(const ScriptComponent&) = default;
@@ -144,6 +146,9 @@ namespace RXNEngine {
 		bool UseCCD = false;
 		float CCDVelocityThreshold = 50.0f;
 
+		// 0-31, scene queries filter on it through their layer mask
+		uint32_t Layer = 0;
+
 		void* RuntimeActor = nullptr;
 
 		RigidbodyComponent() = default;
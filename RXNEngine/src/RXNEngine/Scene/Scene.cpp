@@ -342,24 +342,7 @@ namespace RXNEngine {
 
         if (m_IsRunning)
         {
-            auto scriptView = m_Registry.view<ScriptComponent>();
-            std::vector<entt::entity> entities(scriptView.begin(), scriptView.end());
-
-            if (!entities.empty())
-            {
-                uint32_t threadCount = JobSystem::GetThreadCount();
-                uint32_t groupSize = (uint32_t)entities.size() / threadCount;
-                if (groupSize == 0) groupSize = 1;
-
-                JobSystem::Dispatch(entities.size(), groupSize, [this, &entities, deltaTime](JobDispatchArgs args)
-                    {
-                        OPTICK_EVENT("Run C# Fixed Update");
-                        Entity entity = { entities[args.JobIndex], this };
-                        ScriptEngine::OnFixedUpdateEntity(entity, deltaTime);
-                    });
-
-                JobSystem::Wait();
-            }
+            ScriptEngine::OnFixedUpdateEntities(deltaTime);
 
             UpdateWorldTransforms();
 
@@ -446,6 +429,10 @@ namespace RXNEngine {
                 }
             }
         }
+
+        // After the poses are read back, so handlers see where the bodies ended up
+        if (m_IsRunning)
+            ScriptEngine::OnContactEvents(PhysicsSystem::GetContactEvents());
     }
 
     void Scene::OnRender(const Camera& camera, const glm::mat4& cameraTransform, Ref<RenderTarget>& renderTarget, bool showColliders)
@@ -783,24 +770,7 @@ namespace RXNEngine {
             });
 
 
-        auto scriptView = m_Registry.view<ScriptComponent>();
-        std::vector<entt::entity> entities(scriptView.begin(), scriptView.end());
-
-        if (!entities.empty())
-        {
-            uint32_t threadCount = JobSystem::GetThreadCount();
-            uint32_t groupSize = (uint32_t)entities.size() / threadCount;
-            if (groupSize == 0) groupSize = 1;
-
-            JobSystem::Dispatch(entities.size(), groupSize, [this, &entities, deltaTime](JobDispatchArgs args)
-                {
-                    OPTICK_EVENT("Run C# Update");
-                    Entity entity = { entities[args.JobIndex], this };
-                    ScriptEngine::OnUpdateEntity(entity, deltaTime);
-                });
-
-            JobSystem::Wait();
-        }
+        ScriptEngine::OnUpdateEntities(deltaTime);
 
         for (auto& entity : m_EntitiesToDestroy)
         {
@@ -910,6 +880,66 @@ namespace RXNEngine {
         return {};
     }
 
+    Entity Scene::PickEntity(const Ray& ray, float* outDistance)
+    {
+        OPTICK_EVENT();
+
+        struct PickCandidate
+        {
+            entt::entity Handle;
+            float Distance;
+        };
+
+        std::vector<PickCandidate> candidates;
+        glm::vec3 invDirection = 1.0f / ray.Direction;
+
+        auto view = m_Registry.view<StaticMeshComponent, TransformComponent>();
+        for (auto entity : view)
+        {
+            auto [mc, tc] = view.get<StaticMeshComponent, TransformComponent>(entity);
+            if (!mc.Mesh || mc.SubmeshIndex >= mc.Mesh->GetSubmeshes().size())
+                continue;
+
+            AABB worldAABB = Math::CalculateWorldAABB(mc.Mesh->GetSubmeshes()[mc.SubmeshIndex].BoundingBox, tc.WorldTransform);
+
+            float tEntry;
+            if (Math::IntersectRayAABB(ray.Origin, invDirection, worldAABB, std::numeric_limits<float>::max(), tEntry))
+                candidates.push_back({ entity, tEntry });
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const PickCandidate& a, const PickCandidate& b) { return a.Distance < b.Distance; });
+
+        float closest = std::numeric_limits<float>::max();
+        entt::entity closestEntity = entt::null;
+
+        for (const auto& candidate : candidates)
+        {
+            // Candidates are sorted by box entry, nothing further along can beat the current hit
+            if (candidate.Distance > closest)
+                break;
+
+            auto [mc, tc] = view.get<StaticMeshComponent, TransformComponent>(candidate.Handle);
+
+            // The direction is left unnormalized so t stays a world space distance
+            glm::mat4 inverseTransform = glm::inverse(tc.WorldTransform);
+            Ray localRay = {
+                glm::vec3(inverseTransform * glm::vec4(ray.Origin, 1.0f)),
+                glm::vec3(inverseTransform * glm::vec4(ray.Direction, 0.0f))
+            };
+
+            if (mc.Mesh->Raycast(localRay, mc.SubmeshIndex, closest))
+                closestEntity = candidate.Handle;
+        }
+
+        if (closestEntity == entt::null)
+            return {};
+
+        if (outDistance)
+            *outDistance = closest;
+
+        return Entity{ closestEntity, this };
+    }
+
     Entity Scene::GetPrimaryCameraEntity()
     {
         Entity entity = GetEntityByUUID(m_PrimaryCameraID);
@@ -1005,6 +1035,9 @@ namespace RXNEngine {
             actor = dynamicActor;
         }
 
+        // Scene queries test their layer mask against word0
+        physx::PxFilterData layerFilter(PhysicsSystem::GetLayerBit(rb.Layer), 0, 0, 0);
+
         if (entity.HasComponent<BoxColliderComponent>())
         {
             auto& bc = entity.GetComponent<BoxColliderComponent>();
@@ -1015,6 +1048,7 @@ namespace RXNEngine {
             physx::PxBoxGeometry boxGeom(PhysicsUtils::GLMToPhysX(colliderSize));
 
             physx::PxShape* shape = physx::PxRigidActorExt::createExclusiveShape(*actor, boxGeom, *material);
+            shape->setQueryFilterData(layerFilter);
             shape->setLocalPose(physx::PxTransform(PhysicsUtils::GLMToPhysX(bc.Offset)));
 
             if (bc.IsTrigger)
@@ -1036,6 +1070,7 @@ namespace RXNEngine {
             physx::PxSphereGeometry sphereGeom(sc.Radius * maxScale);
 
             physx::PxShape* shape = physx::PxRigidActorExt::createExclusiveShape(*actor, sphereGeom, *material);
+            shape->setQueryFilterData(layerFilter);
             shape->setLocalPose(physx::PxTransform(PhysicsUtils::GLMToPhysX(sc.Offset)));
 
             if (sc.IsTrigger)
@@ -1057,6 +1092,7 @@ namespace RXNEngine {
             physx::PxCapsuleGeometry capsuleGeom(cc.Radius * radiusScale, (cc.Height / 2.0f) * worldScale.y);
 
             physx::PxShape* shape = physx::PxRigidActorExt::createExclusiveShape(*actor, capsuleGeom, *material);
+            shape->setQueryFilterData(layerFilter);
 
             physx::PxQuat relativeRot(physx::PxHalfPi, physx::PxVec3(0.0f, 0.0f, 1.0f));
 
@@ -45,6 +45,9 @@ namespace RXNEngine {
 		Entity DuplicateEntity(Entity entity);
 		Entity FindEntityByName(std::string_view name);
 
+		// CPU ray query against mesh triangles, ray and distance are in world space
+		Entity PickEntity(const Ray& ray, float* outDistance = nullptr);
+
 		Entity GetPrimaryCameraEntity();
 		void SetPrimaryCameraEntity(Entity entity);
 
@@ -81,6 +84,7 @@ namespace RXNEngine {
 
 		friend class Entity;
 		friend class SceneSerializer;
+		friend class ScriptComponentViews;
 	};
 
 }
\ No newline at end of file
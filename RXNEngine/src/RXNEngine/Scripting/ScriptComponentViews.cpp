@@ -0,0 +1,163 @@
+#include "rxnpch.h"
+#include "ScriptComponentViews.h"
+
+#include "RXNEngine/Scene/Components.h"
+#include "RXNEngine/Physics/PhysicsSystem.h"
+
+#include <PxPhysicsAPI.h>
+
+namespace RXNEngine {
+
+    ScriptComponentViewBuffers ScriptComponentViews::s_Buffers;
+
+    std::vector<glm::vec3> ScriptComponentViews::s_Translation;
+    std::vector<glm::vec3> ScriptComponentViews::s_Rotation;
+    std::vector<glm::vec3> ScriptComponentViews::s_Scale;
+    std::vector<glm::mat4> ScriptComponentViews::s_WorldTransform;
+    std::vector<glm::vec3> ScriptComponentViews::s_LinearVelocity;
+    std::vector<uint8_t> ScriptComponentViews::s_Dirty;
+
+    std::vector<int32_t> ScriptComponentViews::s_Slots;
+    std::vector<entt::entity> ScriptComponentViews::s_Entities;
+
+    static physx::PxRigidDynamic* GetDynamicActor(entt::registry& registry, entt::entity entity)
+    {
+        auto* rb = registry.try_get<RigidbodyComponent>(entity);
+        if (!rb || !rb->RuntimeActor || rb->Type == RigidbodyComponent::BodyType::Static)
+            return nullptr;
+
+        return static_cast<physx::PxRigidActor*>(rb->RuntimeActor)->is<physx::PxRigidDynamic>();
+    }
+
+    void ScriptComponentViews::Reset()
+    {
+        s_Translation = {};
+        s_Rotation = {};
+        s_Scale = {};
+        s_WorldTransform = {};
+        s_LinearVelocity = {};
+        s_Dirty = {};
+        s_Slots = {};
+        s_Entities = {};
+
+        s_Buffers = ScriptComponentViewBuffers();
+    }
+
+    void ScriptComponentViews::Reserve(int32_t capacity)
+    {
+        if (capacity <= s_Buffers.Capacity)
+            return;
+
+        capacity = std::max(capacity, s_Buffers.Capacity * 2);
+
+        s_Translation.resize(capacity);
+        s_Rotation.resize(capacity);
+        s_Scale.resize(capacity, glm::vec3(1.0f));
+        s_WorldTransform.resize(capacity, glm::mat4(1.0f));
+        s_LinearVelocity.resize(capacity);
+        s_Dirty.resize(capacity, ScriptViewDirty_None);
+
+        s_Buffers.Translation = s_Translation.data();
+        s_Buffers.Rotation = s_Rotation.data();
+        s_Buffers.Scale = s_Scale.data();
+        s_Buffers.WorldTransform = s_WorldTransform.data();
+        s_Buffers.LinearVelocity = s_LinearVelocity.data();
+        s_Buffers.Dirty = s_Dirty.data();
+        s_Buffers.Capacity = capacity;
+    }
+
+    void ScriptComponentViews::Gather(Scene* scene, const std::vector<int32_t>& slots, const std::vector<entt::entity>& entities)
+    {
+        OPTICK_EVENT();
+
+        RXN_CORE_ASSERT(slots.size() == entities.size(), "Every script slot needs its entity!");
+
+        Writeback(scene);
+
+        s_Slots = slots;
+        s_Entities = entities;
+
+        int32_t capacity = 0;
+        for (int32_t slot : slots)
+            capacity = std::max(capacity, slot + 1);
+        Reserve(capacity);
+
+        if (!scene)
+            return;
+
+        entt::registry& registry = scene->m_Registry;
+
+        PhysicsSystem::LockRead();
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            int32_t slot = slots[i];
+            entt::entity entity = entities[i];
+            if (!registry.valid(entity))
+                continue;
+
+            s_Dirty[slot] = ScriptViewDirty_None;
+
+            const auto& tc = registry.get<TransformComponent>(entity);
+            s_Translation[slot] = tc.Translation;
+            s_Rotation[slot] = tc.Rotation;
+            s_Scale[slot] = tc.Scale;
+            s_WorldTransform[slot] = tc.WorldTransform;
+
+            physx::PxRigidDynamic* actor = GetDynamicActor(registry, entity);
+            if (actor)
+            {
+                physx::PxVec3 velocity = actor->getLinearVelocity();
+                s_LinearVelocity[slot] = { velocity.x, velocity.y, velocity.z };
+            }
+            else
+            {
+                s_LinearVelocity[slot] = glm::vec3(0.0f);
+            }
+        }
+        PhysicsSystem::UnlockRead();
+    }
+
+    void ScriptComponentViews::Writeback(Scene* scene)
+    {
+        OPTICK_EVENT();
+
+        if (!scene)
+            return;
+
+        entt::registry& registry = scene->m_Registry;
+
+        for (size_t i = 0; i < s_Slots.size(); i++)
+        {
+            int32_t slot = s_Slots[i];
+            uint8_t dirty = s_Dirty[slot];
+            if (dirty == ScriptViewDirty_None)
+                continue;
+
+            s_Dirty[slot] = ScriptViewDirty_None;
+
+            entt::entity entity = s_Entities[i];
+            if (!registry.valid(entity))
+                continue;
+
+            auto& tc = registry.get<TransformComponent>(entity);
+            if (dirty & ScriptViewDirty_Translation) tc.Translation = s_Translation[slot];
+            if (dirty & ScriptViewDirty_Rotation) tc.Rotation = s_Rotation[slot];
+            if (dirty & ScriptViewDirty_Scale) tc.Scale = s_Scale[slot];
+            if (dirty & (ScriptViewDirty_Translation | ScriptViewDirty_Rotation | ScriptViewDirty_Scale))
+                tc.IsDirty = true;
+
+            if (dirty & ScriptViewDirty_LinearVelocity)
+            {
+                physx::PxRigidDynamic* actor = GetDynamicActor(registry, entity);
+                if (actor && !(actor->getRigidBodyFlags() & physx::PxRigidBodyFlag::eKINEMATIC))
+                {
+                    const glm::vec3& velocity = s_LinearVelocity[slot];
+                    PhysicsSystem::LockWrite();
+                    actor->setLinearVelocity(physx::PxVec3(velocity.x, velocity.y, velocity.z));
+                    PhysicsSystem::UnlockWrite();
+                }
+            }
+        }
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "RXNEngine/Scene/Scene.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace RXNEngine {
+
+    // Layout mirrored by ComponentViews in RXNScriptCore/ComponentViews.cs
+    struct ScriptComponentViewBuffers
+    {
+        glm::vec3* Translation = nullptr;
+        glm::vec3* Rotation = nullptr;
+        glm::vec3* Scale = nullptr;
+        glm::mat4* WorldTransform = nullptr;
+        glm::vec3* LinearVelocity = nullptr;
+        uint8_t* Dirty = nullptr;
+        int32_t Capacity = 0;
+    };
+
+    // One byte per slot so scripts updating on different workers never share a word
+    enum ScriptViewDirtyFlags : uint8_t
+    {
+        ScriptViewDirty_None = 0,
+        ScriptViewDirty_Translation = 1 << 0,
+        ScriptViewDirty_Rotation = 1 << 1,
+        ScriptViewDirty_Scale = 1 << 2,
+        ScriptViewDirty_LinearVelocity = 1 << 3
+    };
+
+    // Packed SoA copies of the components of every scripted entity, indexed by the script's slot. Managed code reads
+    // and writes them as spans without crossing into native code, the fields it marks dirty are applied to the scene in
+    // one pass once the update is done. The buffers are native memory the GC never moves, they are only reallocated
+    // inside Gather()
+    class ScriptComponentViews
+    {
+    public:
+        // Forgets the tracked entities, called when the runtime scene goes away
+        static void Reset();
+
+        // Applies writes still pending from callbacks outside an update, then refreshes every slot from the scene
+        static void Gather(Scene* scene, const std::vector<int32_t>& slots, const std::vector<entt::entity>& entities);
+        static void Writeback(Scene* scene);
+
+        static ScriptComponentViewBuffers* GetBuffers() { return &s_Buffers; }
+    private:
+        static void Reserve(int32_t capacity);
+    private:
+        static ScriptComponentViewBuffers s_Buffers;
+
+        static std::vector<glm::vec3> s_Translation;
+        static std::vector<glm::vec3> s_Rotation;
+        static std::vector<glm::vec3> s_Scale;
+        static std::vector<glm::mat4> s_WorldTransform;
+        static std::vector<glm::vec3> s_LinearVelocity;
+        static std::vector<uint8_t> s_Dirty;
+
+        // Slots filled by the last Gather() and the entities they belong to
+        static std::vector<int32_t> s_Slots;
+        static std::vector<entt::entity> s_Entities;
+    };
+
+}
\ No newline at end of file
@@ -2,10 +2,17 @@
 #include "ScriptEngine.h"
 
 #include "ScriptInterop.h"
+#include "ScriptComponentViews.h"
 #include "RXNEngine/Scene/Entity.h"
 #include "RXNEngine/Scene/Components.h"
+#include "RXNEngine/Core/JobSystem.h"
+#include "RXNEngine/Core/FileWatcher.h"
+#include "RXNEngine/Physics/PhysicsSystem.h"
 
 #include <glm/glm.hpp>
+#include <fstream>
+#include <atomic>
+#include <chrono>
 
 #ifdef RXN_PLATFORM_WINDOWS
     #include <windows.h>
@@ -137,16 +144,51 @@ namespace RXNEngine {
     typedef void (CORECLR_DELEGATE_CALLTYPE* load_game_scripts_fn)(const char* corePath, const char* appPath);
     typedef void (CORECLR_DELEGATE_CALLTYPE* unload_game_scripts_fn)();
     typedef void (CORECLR_DELEGATE_CALLTYPE* register_internal_calls_fn)(void*);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* instantiate_script_fn)(uint64_t entityID, const char* className);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_create_fn)(uint64_t entityID);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_destroy_fn)(uint64_t entityID);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_update_fn)(uint64_t entityID, float deltaTime);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_fixed_update_fn)(uint64_t entityID, float deltaTime);
+    typedef uint32_t(CORECLR_DELEGATE_CALLTYPE* instantiate_script_fn)(uint64_t entityID, const char* className, int32_t* outSlot);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_create_fn)(int32_t slot);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_after_reload_fn)(int32_t slot);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_destroy_fn)(int32_t slot);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_update_fn)(int32_t slot, float deltaTime);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_on_fixed_update_fn)(int32_t slot, float deltaTime);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* invoke_update_batch_fn)(const int32_t* slots, int32_t count, float deltaTime);
     typedef int32_t(CORECLR_DELEGATE_CALLTYPE* entity_class_exists_fn)(const char* className);
     typedef void (CORECLR_DELEGATE_CALLTYPE* reflect_class_fn)(const char* className);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* get_field_value_fn)(uint64_t entityID, const char* fieldName, void* outBuffer);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* set_field_value_fn)(uint64_t entityID, const char* fieldName, const void* inBuffer);
-    typedef void (CORECLR_DELEGATE_CALLTYPE* on_collision_fn)(uint64_t entityID, uint64_t otherEntityID);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* get_field_value_fn)(int32_t slot, uint32_t fieldHandle, void* outBuffer);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* set_field_value_fn)(int32_t slot, uint32_t fieldHandle, const void* inBuffer);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* get_field_values_fn)(int32_t slot, void* outBuffer);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* set_field_values_fn)(int32_t slot, const void* inBuffer);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* update_coroutines_fn)();
+    typedef void (CORECLR_DELEGATE_CALLTYPE* get_coroutine_stats_fn)(int32_t* outActive, int32_t* outSleeping);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* on_runtime_stop_fn)();
+
+    // Layout mirrored by ScriptProfileRecord in RXNScriptHost/ScriptProfiler.cs
+    struct ScriptProfileRecord
+    {
+        char ClassName[128];
+        uint32_t Callback;
+        uint32_t Padding;
+        uint64_t Calls;
+        double TotalMs;
+        double MaxMs;
+        uint64_t AllocatedBytes;
+    };
+
+    typedef void (CORECLR_DELEGATE_CALLTYPE* set_profiling_enabled_fn)(int32_t enabled);
+    typedef void (CORECLR_DELEGATE_CALLTYPE* reset_profile_fn)();
+    typedef int32_t(CORECLR_DELEGATE_CALLTYPE* get_profile_fn)(ScriptProfileRecord* records, int32_t capacity);
+
+    // Layout mirrored by ContactEvent in RXNScriptHost/Host.cs
+    struct ScriptContactEvent
+    {
+        int32_t Slot;
+        uint32_t Callback;
+        uint64_t OtherID;
+        glm::vec3 Point;
+        glm::vec3 Normal;
+        glm::vec3 Impulse;
+    };
+
+    typedef void (CORECLR_DELEGATE_CALLTYPE* dispatch_contact_events_fn)(const ScriptContactEvent* events, int32_t count);
 
 
     struct ScriptEngineData
@@ -160,32 +202,86 @@ namespace RXNEngine {
 
         instantiate_script_fn InstantiateScript = nullptr;
         invoke_on_create_fn InvokeOnCreate = nullptr;
+        invoke_on_after_reload_fn InvokeOnAfterReload = nullptr;
         invoke_on_destroy_fn InvokeOnDestroy = nullptr;
         invoke_on_update_fn InvokeOnUpdate = nullptr;
 		invoke_on_fixed_update_fn InvokeOnFixedUpdate = nullptr;
+        invoke_update_batch_fn InvokeOnUpdateBatch = nullptr;
+        invoke_update_batch_fn InvokeOnFixedUpdateBatch = nullptr;
 
         entity_class_exists_fn CheckEntityClassExists = nullptr;
         reflect_class_fn ReflectClass = nullptr;
         get_field_value_fn GetFieldValue = nullptr;
         set_field_value_fn SetFieldValue = nullptr;
+        get_field_values_fn GetFieldValues = nullptr;
+        set_field_values_fn SetFieldValues = nullptr;
+
+        dispatch_contact_events_fn DispatchContactEvents = nullptr;
 
-        on_collision_fn OnCollisionEnter = nullptr;
-        on_collision_fn OnCollisionExit = nullptr;
+        update_coroutines_fn UpdateCoroutines = nullptr;
+        update_coroutines_fn FixedUpdateCoroutines = nullptr;
+        get_coroutine_stats_fn GetCoroutineStats = nullptr;
+        on_runtime_stop_fn OnRuntimeStop = nullptr;
 
-        on_collision_fn OnTriggerEnter = nullptr;
-        on_collision_fn OnTriggerExit = nullptr;
+        set_profiling_enabled_fn SetProfilingEnabled = nullptr;
+        reset_profile_fn ResetProfile = nullptr;
+        get_profile_fn GetProfile = nullptr;
+        bool ProfilingEnabled = false;
+        std::vector<ScriptProfileRecord> ProfileRecords;
 
         Scene* SceneContext = nullptr;
-        std::unordered_map<UUID, Ref<ScriptInstance>> EntityInstances;
+        // Indexed by the host's slot, so native and managed share one index and ScriptComponent keeps it. Freed slots
+        // hold an empty instance until the host hands them out again
+        std::vector<ScriptInstance> Instances;
+        std::vector<int32_t> BatchSlots;
+        std::vector<int32_t> ViewSlots;
+        std::vector<entt::entity> ViewEntities;
+        std::vector<ScriptContactEvent> ContactEvents;
         std::unordered_map<std::string, std::vector<ScriptField>> ScriptClassFields;
 
         std::filesystem::path CoreAssemblyPath;
         std::filesystem::file_time_type CoreAssemblyLastWriteTime;
         bool ReloadPending = false;
         float ReloadTimer = 0.0f;
+
+        // Set by the watcher thread, the main thread picks it up in ReloadIfModified()
+        std::atomic<bool> AssemblyChanged = false;
+        Scope<FileWatcher> AssemblyWatcher;
     };
 
     static ScriptEngineData* s_Data = nullptr;
+
+    static ScriptInstance* GetInstance(int32_t slot)
+    {
+        if (slot < 0 || slot >= (int32_t)s_Data->Instances.size() || s_Data->Instances[slot].GetSlot() < 0)
+            return nullptr;
+
+        return &s_Data->Instances[slot];
+    }
+
+    // The slot kept on the entity's ScriptComponent, as long as it still holds that entity's instance. Duplicated
+    // components and instances dropped by a reload can leave a slot that now belongs to someone else
+    static ScriptInstance* GetEntityInstance(Entity entity)
+    {
+        ScriptInstance* instance = GetInstance(entity.GetComponent<ScriptComponent>().InstanceSlot);
+        return instance && instance->GetEntity() == entity ? instance : nullptr;
+    }
+
+    // Stores the instance at the slot the host gave it and records the slot on the entity's ScriptComponent
+    static ScriptInstance* CreateInstance(Entity entity, const std::string& className)
+    {
+        ScriptInstance instance(entity, className);
+        int32_t slot = instance.GetSlot();
+        if (slot < 0)
+            return nullptr;
+
+        if (slot >= (int32_t)s_Data->Instances.size())
+            s_Data->Instances.resize(slot + 1);
+
+        s_Data->Instances[slot] = std::move(instance);
+        entity.GetComponent<ScriptComponent>().InstanceSlot = slot;
+        return &s_Data->Instances[slot];
+    }
 #pragma endregion
 
 #pragma region Initialization & Shutdown
@@ -226,17 +322,26 @@ namespace RXNEngine {
         LOAD_MANAGED_METHOD("RXNScriptHost.Interop, RXNScriptHost", RegisterInternalCalls, s_Data->RegisterInternalCalls);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InstantiateScript, s_Data->InstantiateScript);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnCreate, s_Data->InvokeOnCreate);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnAfterReload, s_Data->InvokeOnAfterReload);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnDestroy, s_Data->InvokeOnDestroy);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnUpdate, s_Data->InvokeOnUpdate);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnFixedUpdate, s_Data->InvokeOnFixedUpdate);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnUpdateBatch, s_Data->InvokeOnUpdateBatch);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", InvokeOnFixedUpdateBatch, s_Data->InvokeOnFixedUpdateBatch);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", EntityClassExists, s_Data->CheckEntityClassExists);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", ReflectClass, s_Data->ReflectClass);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", GetFieldValue, s_Data->GetFieldValue);
         LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", SetFieldValue, s_Data->SetFieldValue);
-        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", OnCollisionEnter, s_Data->OnCollisionEnter);
-        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", OnCollisionExit, s_Data->OnCollisionExit);
-        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", OnTriggerEnter, s_Data->OnTriggerEnter);
-        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", OnTriggerExit, s_Data->OnTriggerExit);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", GetFieldValues, s_Data->GetFieldValues);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", SetFieldValues, s_Data->SetFieldValues);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", DispatchContactEvents, s_Data->DispatchContactEvents);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", UpdateCoroutines, s_Data->UpdateCoroutines);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", FixedUpdateCoroutines, s_Data->FixedUpdateCoroutines);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", GetCoroutineStats, s_Data->GetCoroutineStats);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", OnRuntimeStop, s_Data->OnRuntimeStop);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", SetProfilingEnabled, s_Data->SetProfilingEnabled);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", ResetProfile, s_Data->ResetProfile);
+        LOAD_MANAGED_METHOD("RXNScriptHost.Host, RXNScriptHost", GetProfile, s_Data->GetProfile);
 
         InternalCalls nativeFunctions;
         ScriptInterop::RegisterFunctions(&nativeFunctions);
@@ -252,9 +357,14 @@ namespace RXNEngine {
 
     void ScriptEngine::Shutdown()
     {
+        if (s_Data)
+            s_Data->AssemblyWatcher.reset();
+
         if (s_Data && s_Data->UnloadGameScripts)
             s_Data->UnloadGameScripts();
 
+        ScriptComponentViews::Reset();
+
         delete s_Data;
     }
 #pragma endregion
@@ -273,6 +383,8 @@ namespace RXNEngine {
             s_Data->CoreAssemblyLastWriteTime = std::filesystem::last_write_time(appAbsolutePath);
             s_Data->ReloadPending = false;
 
+            WatchAssemblies(appAbsolutePath, coreAbsolutePath);
+
             s_Data->LoadGameScripts(coreAbsolutePath.string().c_str(), appAbsolutePath.string().c_str());
         }
         else
@@ -281,16 +393,125 @@ namespace RXNEngine {
         }
     }
 
+    void ScriptEngine::WatchAssemblies(const std::filesystem::path& appPath, const std::filesystem::path& corePath)
+    {
+        std::filesystem::path directory = appPath.parent_path();
+        if (s_Data->AssemblyWatcher && s_Data->AssemblyWatcher->GetDirectory() == directory)
+            return;
+
+        s_Data->AssemblyWatcher = CreateScope<FileWatcher>(directory,
+            [directory, appName = appPath.filename(), coreName = corePath.filename()](const std::filesystem::path& changed)
+            {
+                if (changed == directory || changed.filename() == appName || changed.filename() == coreName)
+                    s_Data->AssemblyChanged = true;
+            });
+
+        if (!s_Data->AssemblyWatcher->IsWatching())
+            RXN_CORE_WARN("ScriptEngine: No file watcher for {0}, polling the assembly instead", directory.string());
+    }
+
+    // Instances are matched to their old state by field name, a field whose type changed or that was added keeps the
+    // value the new constructor gave it. OnCreate doesn't run again, it would repeat its side effects and could
+    // overwrite the restored fields. Private state and coroutines died with the old context, OnAfterReload rebuilds them
     void ScriptEngine::ReloadAssembly()
     {
+        OPTICK_EVENT();
+        auto start = std::chrono::steady_clock::now();
+
+        struct InstanceSnapshot
+        {
+            Entity Owner;
+            std::string ClassName;
+            std::vector<uint8_t> Fields;
+        };
+
+        std::vector<InstanceSnapshot> snapshots;
+        snapshots.reserve(s_Data->Instances.size());
+        for (ScriptInstance& instance : s_Data->Instances)
+        {
+            if (instance.GetSlot() < 0)
+                continue;
+
+            InstanceSnapshot& snapshot = snapshots.emplace_back();
+            snapshot.Owner = instance.GetEntity();
+            snapshot.ClassName = instance.GetScriptClassName();
+            snapshot.Fields.resize(GetClassFieldBufferSize(snapshot.ClassName));
+            instance.GetFieldValues(snapshot.Fields.data());
+        }
+
+        // Writes scripts made outside an update still have to reach the scene before the slots are reassigned
+        if (s_Data->SceneContext)
+            ScriptComponentViews::Writeback(s_Data->SceneContext);
+        ScriptComponentViews::Reset();
+
+        // The reload hands every slot out again. An entity whose class is gone must not keep a slot another entity gets
+        for (InstanceSnapshot& snapshot : snapshots)
+            snapshot.Owner.GetComponent<ScriptComponent>().InstanceSlot = -1;
+
+        s_Data->Instances.clear();
+        std::unordered_map<std::string, std::vector<ScriptField>> oldClassFields = std::move(s_Data->ScriptClassFields);
         s_Data->ScriptClassFields.clear();
 
         LoadAssembly("res/scripts/RXNScriptApp.dll");
-        RXN_CORE_INFO("ScriptEngine: Assembly Hot-Reloaded successfully!");
+
+        std::vector<uint8_t> fields;
+        std::vector<int32_t> migrated;
+        migrated.reserve(snapshots.size());
+        for (const InstanceSnapshot& snapshot : snapshots)
+        {
+            if (!EntityClassExists(snapshot.ClassName))
+            {
+                RXN_CORE_WARN("ScriptEngine: Class '{0}' no longer exists, its instance was dropped", snapshot.ClassName);
+                continue;
+            }
+
+            ScriptInstance* instance = CreateInstance(snapshot.Owner, snapshot.ClassName);
+            if (!instance)
+                continue;
+
+            fields.assign(GetClassFieldBufferSize(snapshot.ClassName), 0);
+            instance->GetFieldValues(fields.data());
+
+            for (const ScriptField& field : GetClassFields(snapshot.ClassName))
+            {
+                for (const ScriptField& oldField : oldClassFields[snapshot.ClassName])
+                {
+                    if (oldField.Name == field.Name && oldField.Type == field.Type && oldField.Size == field.Size)
+                    {
+                        memcpy(fields.data() + field.Offset, snapshot.Fields.data() + oldField.Offset, field.Size);
+                        break;
+                    }
+                }
+            }
+
+            instance->SetFieldValues(fields.data());
+            migrated.push_back(instance->GetSlot());
+        }
+
+        // Every instance exists before any OnAfterReload runs, scripts look each other up from it
+        for (int32_t slot : migrated)
+        {
+            if (ScriptInstance* instance = GetInstance(slot))
+                instance->InvokeOnAfterReload();
+        }
+
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        RXN_CORE_INFO("ScriptEngine: Assembly Hot-Reloaded successfully, migrated {0} of {1} instances in {2:.2f} ms",
+            migrated.size(), snapshots.size(), elapsed.count());
     }
 
     void ScriptEngine::ReloadIfModified(float deltaTime)
     {
+        // Every change restarts the wait, the compiler writes the assembly more than once
+        if (s_Data->AssemblyChanged.exchange(false))
+        {
+            if (!s_Data->ReloadPending)
+                RXN_CORE_TRACE("ScriptEngine: Assembly modification detected. Waiting for compiler...");
+
+            s_Data->ReloadPending = true;
+            s_Data->ReloadTimer = 0.5f;
+        }
+
         if (s_Data->ReloadPending)
         {
             s_Data->ReloadTimer -= deltaTime;
@@ -302,6 +523,9 @@ namespace RXNEngine {
             return;
         }
 
+        if (s_Data->AssemblyWatcher && s_Data->AssemblyWatcher->IsWatching())
+            return;
+
         std::error_code ec;
         auto currentWriteTime = std::filesystem::last_write_time(s_Data->CoreAssemblyPath, ec);
 
@@ -323,8 +547,12 @@ namespace RXNEngine {
 
     void ScriptEngine::OnRuntimeStop()
     {
+        if (s_Data->OnRuntimeStop)
+            s_Data->OnRuntimeStop();
+
         s_Data->SceneContext = nullptr;
-        s_Data->EntityInstances.clear();
+        s_Data->Instances.clear();
+        ScriptComponentViews::Reset();
         RXN_CORE_INFO("ScriptEngine: Runtime stopped, Scene context cleared.");
     }
 
@@ -343,77 +571,281 @@ namespace RXNEngine {
 #pragma region Entity Lifecycle
     void ScriptEngine::OnCreateEntity(Entity entity)
     {
-        const auto& sc = entity.GetComponent<ScriptComponent>();
+        if (GetEntityInstance(entity))
+            OnDestroyEntity(entity);
+
+        auto& sc = entity.GetComponent<ScriptComponent>();
+        sc.InstanceSlot = -1;
         if (sc.ClassName.empty()) return;
 
-        if (EntityClassExists(sc.ClassName))
+        std::string className = sc.ClassName;
+        if (EntityClassExists(className))
         {
-            UUID entityID = entity.GetUUID();
-
-            Ref<ScriptInstance> instance = CreateRef<ScriptInstance>(entity, sc.ClassName);
-
-            s_Data->EntityInstances[entityID] = instance;
-
-            instance->InvokeOnCreate();
+            if (ScriptInstance* instance = CreateInstance(entity, className))
+                instance->InvokeOnCreate();
         }
         else
         {
-            RXN_CORE_ERROR("ScriptEngine: EntityClass '{0}' does not exist!", sc.ClassName);
+            RXN_CORE_ERROR("ScriptEngine: EntityClass '{0}' does not exist!", className);
         }
     }
 
     void ScriptEngine::OnDestroyEntity(Entity entity)
     {
-        if (s_Data && s_Data->InvokeOnDestroy)
-            s_Data->InvokeOnDestroy(entity.GetUUID());
+        if (!s_Data)
+            return;
+
+        ScriptInstance* instance = GetEntityInstance(entity);
+        if (!instance)
+            return;
+
+        int32_t slot = instance->GetSlot();
+
+        // Cleared before OnDestroy runs, it may spawn or destroy entities. The host only recycles the slot once
+        // OnDestroy returns, so an entity spawned meanwhile is given a different one
+        s_Data->Instances[slot] = ScriptInstance();
+        entity.GetComponent<ScriptComponent>().InstanceSlot = -1;
+
+        if (s_Data->InvokeOnDestroy)
+            s_Data->InvokeOnDestroy(slot);
     }
 
     void ScriptEngine::OnUpdateEntity(Entity entity, float deltaTime)
     {
-        UUID entityID = entity.GetUUID();
-
-        if (s_Data->EntityInstances.find(entityID) != s_Data->EntityInstances.end())
-            s_Data->EntityInstances[entityID]->InvokeOnUpdate(deltaTime);
+        if (ScriptInstance* instance = GetEntityInstance(entity))
+            instance->InvokeOnUpdate(deltaTime);
     }
 
     void ScriptEngine::OnFixedUpdateEntity(Entity entity, float deltaTime)
     {
-        UUID entityID = entity.GetUUID();
+        if (ScriptInstance* instance = GetEntityInstance(entity))
+            instance->InvokeOnFixedUpdate(deltaTime);
+    }
+
+    // Below this many instances splitting across workers costs more than the transitions it saves
+    static constexpr uint32_t s_MinBatchSize = 256;
+
+    static void DispatchBatch(ScriptCallbackFlags callback, invoke_update_batch_fn invokeBatch, float deltaTime)
+    {
+        if (!s_Data || !invokeBatch)
+            return;
+
+        std::vector<int32_t>& slots = s_Data->BatchSlots;
+        slots.clear();
+        s_Data->ViewSlots.clear();
+        s_Data->ViewEntities.clear();
+        for (const ScriptInstance& instance : s_Data->Instances)
+        {
+            if (instance.GetSlot() < 0)
+                continue;
+
+            s_Data->ViewSlots.push_back(instance.GetSlot());
+            s_Data->ViewEntities.push_back(instance.GetEntity());
+
+            if (instance.HasCallback(callback))
+                slots.push_back(instance.GetSlot());
+        }
+
+        if (slots.empty())
+            return;
+
+        // Every script may read any other's view, so all of them are refreshed, not only the ones being updated
+        ScriptComponentViews::Gather(s_Data->SceneContext, s_Data->ViewSlots, s_Data->ViewEntities);
+
+        uint32_t count = (uint32_t)slots.size();
+        uint32_t batchCount = std::min(JobSystem::GetThreadCount(), (count + s_MinBatchSize - 1) / s_MinBatchSize);
+        if (batchCount <= 1)
+        {
+            invokeBatch(slots.data(), (int32_t)count, deltaTime);
+            ScriptComponentViews::Writeback(s_Data->SceneContext);
+            return;
+        }
+
+        uint32_t batchSize = (count + batchCount - 1) / batchCount;
+        JobSystem::Dispatch(batchCount, 1, [&slots, invokeBatch, count, batchSize, deltaTime](JobDispatchArgs args)
+            {
+                OPTICK_EVENT("Run C# Batch");
+                uint32_t begin = args.JobIndex * batchSize;
+                uint32_t end = std::min(begin + batchSize, count);
+                if (begin < end)
+                    invokeBatch(slots.data() + begin, (int32_t)(end - begin), deltaTime);
+            });
+
+        JobSystem::Wait();
+        ScriptComponentViews::Writeback(s_Data->SceneContext);
+    }
+
+    void ScriptEngine::OnUpdateEntities(float deltaTime)
+    {
+        OPTICK_EVENT("Run C# Update");
+        DispatchBatch(ScriptCallback_OnUpdate, s_Data->InvokeOnUpdateBatch, deltaTime);
+
+        // Coroutines step on this thread after the batches, a coroutine can touch anything a script can
+        if (s_Data && s_Data->UpdateCoroutines)
+        {
+            OPTICK_EVENT("Run C# Coroutines");
+            s_Data->UpdateCoroutines();
+        }
+    }
+
+    void ScriptEngine::OnFixedUpdateEntities(float deltaTime)
+    {
+        OPTICK_EVENT("Run C# Fixed Update");
+        DispatchBatch(ScriptCallback_OnFixedUpdate, s_Data->InvokeOnFixedUpdateBatch, deltaTime);
 
-        if (s_Data->EntityInstances.find(entityID) != s_Data->EntityInstances.end())
-            s_Data->EntityInstances[entityID]->InvokeOnFixedUpdate(deltaTime);
+        if (s_Data && s_Data->FixedUpdateCoroutines)
+            s_Data->FixedUpdateCoroutines();
+    }
+
+    ScriptCoroutineStatistics ScriptEngine::GetCoroutineStats()
+    {
+        ScriptCoroutineStatistics stats;
+        if (!s_Data || !s_Data->GetCoroutineStats)
+            return stats;
+
+        int32_t active = 0, sleeping = 0;
+        s_Data->GetCoroutineStats(&active, &sleeping);
+        stats.Active = (uint32_t)active;
+        stats.Sleeping = (uint32_t)sleeping;
+        return stats;
     }
 #pragma endregion
 
 #pragma region Physics Events
-    void ScriptEngine::OnCollisionEnter(uint64_t entityID, uint64_t otherID)
+    void ScriptEngine::OnContactEvents(const std::vector<PhysicsContactEvent>& events)
+    {
+        OPTICK_EVENT();
+
+        if (!s_Data || !s_Data->DispatchContactEvents || events.empty())
+            return;
+
+        static constexpr ScriptCallbackFlags s_ContactCallbacks[] = {
+            ScriptCallback_OnCollisionEnter, ScriptCallback_OnCollisionExit,
+            ScriptCallback_OnTriggerEnter, ScriptCallback_OnTriggerExit
+        };
+
+        std::vector<ScriptContactEvent>& scriptEvents = s_Data->ContactEvents;
+        scriptEvents.clear();
+
+        for (const PhysicsContactEvent& event : events)
+        {
+            // Actors only know their entity's UUID
+            Entity entity = s_Data->SceneContext ? s_Data->SceneContext->GetEntityByUUID(event.EntityID) : Entity();
+            if (!entity || !entity.HasComponent<ScriptComponent>())
+                continue;
+
+            ScriptInstance* instance = GetEntityInstance(entity);
+            ScriptCallbackFlags callback = s_ContactCallbacks[(uint32_t)event.Type];
+            if (!instance || !instance->HasCallback(callback))
+                continue;
+
+            scriptEvents.push_back({ instance->GetSlot(), (uint32_t)callback, event.OtherID, event.Point, event.Normal, event.Impulse });
+        }
+
+        if (!scriptEvents.empty())
+            s_Data->DispatchContactEvents(scriptEvents.data(), (int32_t)scriptEvents.size());
+    }
+#pragma endregion
+
+#pragma region Profiling
+    void ScriptEngine::SetProfilingEnabled(bool enabled)
+    {
+        if (!s_Data || !s_Data->SetProfilingEnabled)
+            return;
+
+        s_Data->ProfilingEnabled = enabled;
+        s_Data->SetProfilingEnabled(enabled ? 1 : 0);
+    }
+
+    bool ScriptEngine::IsProfilingEnabled()
     {
-        if (s_Data && s_Data->OnCollisionEnter)
-            s_Data->OnCollisionEnter(entityID, otherID);
+        return s_Data && s_Data->ProfilingEnabled;
     }
 
-    void ScriptEngine::OnCollisionExit(uint64_t entityID, uint64_t otherID)
+    void ScriptEngine::ResetProfile()
     {
-        if (s_Data && s_Data->OnCollisionExit)
-            s_Data->OnCollisionExit(entityID, otherID);
+        if (s_Data && s_Data->ResetProfile)
+            s_Data->ResetProfile();
     }
 
-    void ScriptEngine::OnTriggerEnter(uint64_t entityID, uint64_t otherID)
+    std::vector<ScriptProfileEntry> ScriptEngine::GetProfile()
     {
-        if (s_Data && s_Data->OnTriggerEnter)
-            s_Data->OnTriggerEnter(entityID, otherID);
+        std::vector<ScriptProfileEntry> entries;
+        if (!s_Data || !s_Data->GetProfile)
+            return entries;
+
+        // Classes can be instantiated between the two calls, retry until the buffer holds everything
+        std::vector<ScriptProfileRecord>& records = s_Data->ProfileRecords;
+        int32_t count = s_Data->GetProfile(records.data(), (int32_t)records.size());
+        while (count > (int32_t)records.size())
+        {
+            records.resize(count);
+            count = s_Data->GetProfile(records.data(), (int32_t)records.size());
+        }
+
+        entries.reserve(count);
+        for (int32_t i = 0; i < count; i++)
+        {
+            const ScriptProfileRecord& record = records[i];
+
+            ScriptProfileEntry& entry = entries.emplace_back();
+            entry.ClassName = std::string(record.ClassName, strnlen(record.ClassName, sizeof(record.ClassName)));
+            entry.Callback = (ScriptCallbackFlags)record.Callback;
+            entry.Calls = record.Calls;
+            entry.TotalMs = record.TotalMs;
+            entry.MaxMs = record.MaxMs;
+            entry.AllocatedBytes = record.AllocatedBytes;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const ScriptProfileEntry& a, const ScriptProfileEntry& b) { return a.TotalMs > b.TotalMs; });
+        return entries;
     }
-    void ScriptEngine::OnTriggerExit(uint64_t entityID, uint64_t otherID)
+
+    bool ScriptEngine::ExportProfile(const std::string& filepath)
     {
-        if (s_Data && s_Data->OnTriggerExit)
-            s_Data->OnTriggerExit(entityID, otherID);
+        std::ofstream out(filepath);
+        if (!out.is_open())
+        {
+            RXN_CORE_ERROR("Failed to export script profile: {0}", filepath);
+            return false;
+        }
+
+        out << "Class,Callback,Calls,Total (ms),Avg (ms),Max (ms),Allocated (bytes),Allocated per call (bytes)\n";
+        for (const auto& entry : GetProfile())
+        {
+            out << entry.ClassName << ',' << GetCallbackName(entry.Callback) << ',' << entry.Calls << ','
+                << entry.TotalMs << ',' << entry.TotalMs / entry.Calls << ',' << entry.MaxMs << ','
+                << entry.AllocatedBytes << ',' << entry.AllocatedBytes / entry.Calls << '\n';
+        }
+
+        RXN_CORE_INFO("Exported script profile to {0}", filepath);
+        return true;
+    }
+
+    const char* ScriptEngine::GetCallbackName(ScriptCallbackFlags callback)
+    {
+        switch (callback)
+        {
+            case ScriptCallback_OnCreate:         return "OnCreate";
+            case ScriptCallback_OnDestroy:        return "OnDestroy";
+            case ScriptCallback_OnUpdate:         return "OnUpdate";
+            case ScriptCallback_OnFixedUpdate:    return "OnFixedUpdate";
+            case ScriptCallback_OnCollisionEnter: return "OnCollisionEnter";
+            case ScriptCallback_OnCollisionExit:  return "OnCollisionExit";
+            case ScriptCallback_OnTriggerEnter:   return "OnTriggerEnter";
+            case ScriptCallback_OnTriggerExit:    return "OnTriggerExit";
+            case ScriptCallback_OnAfterReload:    return "OnAfterReload";
+        }
+
+        return "Unknown";
     }
 #pragma endregion
 
 #pragma region Reflection
-    void ScriptEngine::RegisterField(const std::string& className, const std::string& fieldName, ScriptFieldType type)
+    void ScriptEngine::RegisterField(const std::string& className, const std::string& fieldName, ScriptFieldType type, uint32_t offset, uint32_t size)
     {
-        s_Data->ScriptClassFields[className].push_back({ type, fieldName });
+        auto& fields = s_Data->ScriptClassFields[className];
+        fields.push_back({ type, fieldName, (uint32_t)fields.size(), offset, size });
     }
 
     const std::vector<ScriptField>& ScriptEngine::GetClassFields(const std::string& className)
@@ -421,6 +853,15 @@ namespace RXNEngine {
         return s_Data->ScriptClassFields[className];
     }
 
+    uint32_t ScriptEngine::GetClassFieldBufferSize(const std::string& className)
+    {
+        uint32_t size = 0;
+        for (const auto& field : GetClassFields(className))
+            size = std::max(size, field.Offset + field.Size);
+
+        return (size + 7) & ~7u;
+    }
+
     bool ScriptEngine::EntityClassExists(const std::string& fullClassName)
     {
         if (!s_Data || !s_Data->CheckEntityClassExists || fullClassName.empty())
@@ -433,12 +874,12 @@ namespace RXNEngine {
         return exists != 0;
     }
 
-    Ref<ScriptInstance> ScriptEngine::GetEntityScriptInstance(UUID uuid)
+    ScriptInstance* ScriptEngine::GetEntityScriptInstance(Entity entity)
     {
-        if (s_Data->EntityInstances.find(uuid) != s_Data->EntityInstances.end())
-            return s_Data->EntityInstances[uuid];
+        if (!s_Data || !entity.HasComponent<ScriptComponent>())
+            return nullptr;
 
-        return nullptr;
+        return GetEntityInstance(entity);
     }
 #pragma endregion
 
@@ -447,41 +888,66 @@ namespace RXNEngine {
         : m_Entity(entity), m_ClassName(className)
     {
         if (s_Data->InstantiateScript)
-            s_Data->InstantiateScript(m_Entity.GetUUID(), className.c_str());
+            m_Callbacks = s_Data->InstantiateScript(m_Entity.GetUUID(), className.c_str(), &m_Slot);
     }
 
     void ScriptInstance::InvokeOnCreate()
     {
-        if (s_Data->InvokeOnCreate)
-            s_Data->InvokeOnCreate(m_Entity.GetUUID());
+        if (s_Data->InvokeOnCreate && HasCallback(ScriptCallback_OnCreate))
+            s_Data->InvokeOnCreate(m_Slot);
+    }
+
+    void ScriptInstance::InvokeOnAfterReload()
+    {
+        if (s_Data->InvokeOnAfterReload && HasCallback(ScriptCallback_OnAfterReload))
+            s_Data->InvokeOnAfterReload(m_Slot);
     }
 
     void ScriptInstance::InvokeOnUpdate(float deltaTime)
     {
-        if (s_Data->InvokeOnUpdate)
-            s_Data->InvokeOnUpdate(m_Entity.GetUUID(), deltaTime);
+        if (s_Data->InvokeOnUpdate && HasCallback(ScriptCallback_OnUpdate))
+            s_Data->InvokeOnUpdate(m_Slot, deltaTime);
     }
 
     void ScriptInstance::InvokeOnFixedUpdate(float deltaTime)
     {
-        if (s_Data->InvokeOnFixedUpdate)
-            s_Data->InvokeOnFixedUpdate(m_Entity.GetUUID(), deltaTime);
+        if (s_Data->InvokeOnFixedUpdate && HasCallback(ScriptCallback_OnFixedUpdate))
+            s_Data->InvokeOnFixedUpdate(m_Slot, deltaTime);
     }
 
-    bool ScriptInstance::GetFieldValueInternal(const std::string& name, void* outBuffer)
+    const ScriptField* ScriptInstance::FindField(const std::string& name) const
     {
-        if (s_Data->GetFieldValue)
+        for (const auto& field : ScriptEngine::GetClassFields(m_ClassName))
         {
-            s_Data->GetFieldValue(m_Entity.GetUUID(), name.c_str(), outBuffer);
-            return true;
+            if (field.Name == name)
+                return &field;
         }
-        return false;
+
+        return nullptr;
     }
 
-    void ScriptInstance::SetFieldValueInternal(const std::string& name, const void* inBuffer)
+    void ScriptInstance::GetFieldValueInternal(const ScriptField& field, void* outBuffer)
+    {
+        if (s_Data->GetFieldValue)
+            s_Data->GetFieldValue(m_Slot, field.Handle, outBuffer);
+    }
+
+    void ScriptInstance::SetFieldValueInternal(const ScriptField& field, const void* inBuffer)
     {
         if (s_Data->SetFieldValue)
-            s_Data->SetFieldValue(m_Entity.GetUUID(), name.c_str(), inBuffer);
+            s_Data->SetFieldValue(m_Slot, field.Handle, inBuffer);
+    }
+
+    void ScriptInstance::GetFieldValues(void* outBuffer)
+    {
+        if (s_Data->GetFieldValues)
+            s_Data->GetFieldValues(m_Slot, outBuffer);
+    }
+
+    void ScriptInstance::SetFieldValues(const void* inBuffer)
+    {
+        if (s_Data->SetFieldValues)
+            s_Data->SetFieldValues(m_Slot, inBuffer);
     }
 #pragma endregion
 
@@ -5,9 +5,12 @@
 #include "RXNEngine/Core/Base.h"
 
 #include <string>
+#include <filesystem>
 
 namespace RXNEngine {
 
+	struct PhysicsContactEvent;
+
 	enum class ScriptFieldType
 	{
 		None = 0,
@@ -18,40 +21,113 @@ namespace RXNEngine {
 		Entity
 	};
 
+	// Mirrors ScriptCallbacks in RXNScriptHost/ScriptType.cs. Callbacks a class doesn't override are never invoked
+	enum ScriptCallbackFlags : uint32_t
+	{
+		ScriptCallback_None = 0,
+		ScriptCallback_OnCreate = 1 << 0,
+		ScriptCallback_OnDestroy = 1 << 1,
+		ScriptCallback_OnUpdate = 1 << 2,
+		ScriptCallback_OnFixedUpdate = 1 << 3,
+		ScriptCallback_OnCollisionEnter = 1 << 4,
+		ScriptCallback_OnCollisionExit = 1 << 5,
+		ScriptCallback_OnTriggerEnter = 1 << 6,
+		ScriptCallback_OnTriggerExit = 1 << 7,
+		ScriptCallback_OnAfterReload = 1 << 8
+	};
+
+	// Handle is the field's index in its class's field list, Offset is where it sits in the buffer
+	// GetFieldValues/SetFieldValues work on
 	struct ScriptField
 	{
 		ScriptFieldType Type;
 		std::string Name;
+		uint32_t Handle = 0;
+		uint32_t Offset = 0;
+		uint32_t Size = 0;
 	};
 
+	struct ScriptCoroutineStatistics
+	{
+		uint32_t Active = 0;
+		// Waiting on time, frames, a condition or physics, these cost nothing until they wake
+		uint32_t Sleeping = 0;
+	};
+
+	// Totals since profiling was last reset, AllocatedBytes is what the callback allocated on the managed heap
+	struct ScriptProfileEntry
+	{
+		std::string ClassName;
+		ScriptCallbackFlags Callback = ScriptCallback_None;
+		uint64_t Calls = 0;
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+		uint64_t AllocatedBytes = 0;
+	};
+
+	// Stored by value in the script engine's slot array, an empty instance has no slot
 	class ScriptInstance
 	{
 	public:
+		ScriptInstance() = default;
 		ScriptInstance(Entity entity, const std::string& className);
 
 		void InvokeOnCreate();
+		void InvokeOnAfterReload();
 		void InvokeOnUpdate(float deltaTime);
 		void InvokeOnFixedUpdate(float deltaTime);
 
+		bool HasCallback(ScriptCallbackFlags callback) const { return (m_Callbacks & callback) != 0; }
+
+		// Index of the managed instance in the host's dense instance array, what the batched updates pass
+		int32_t GetSlot() const { return m_Slot; }
+		Entity GetEntity() const { return m_Entity; }
+
 		template<typename T>
-		T GetFieldValue(const std::string& name)
+		T GetFieldValue(const ScriptField& field)
 		{
-			T value;
-			bool success = GetFieldValueInternal(name, &value);
+			RXN_CORE_ASSERT(sizeof(T) == field.Size, "Script field read as the wrong type!");
+
+			T value{};
+			GetFieldValueInternal(field, &value);
 			return value;
 		}
 
+		template<typename T>
+		void SetFieldValue(const ScriptField& field, T value)
+		{
+			RXN_CORE_ASSERT(sizeof(T) == field.Size, "Script field written as the wrong type!");
+			SetFieldValueInternal(field, &value);
+		}
+
+		template<typename T>
+		T GetFieldValue(const std::string& name)
+		{
+			const ScriptField* field = FindField(name);
+			return field ? GetFieldValue<T>(*field) : T{};
+		}
+
 		template<typename T>
 		void SetFieldValue(const std::string& name, T value)
 		{
-			SetFieldValueInternal(name, &value);
+			if (const ScriptField* field = FindField(name))
+				SetFieldValue<T>(*field, value);
 		}
+
+		// All fields at once, the buffer is ScriptEngine::GetClassFieldBufferSize() bytes
+		void GetFieldValues(void* outBuffer);
+		void SetFieldValues(const void* inBuffer);
+
+		const std::string& GetScriptClassName() const { return m_ClassName; }
 	private:
-		bool GetFieldValueInternal(const std::string& name, void* outBuffer);
-		void SetFieldValueInternal(const std::string& name, const void* inBuffer);
+		const ScriptField* FindField(const std::string& name) const;
+		void GetFieldValueInternal(const ScriptField& field, void* outBuffer);
+		void SetFieldValueInternal(const ScriptField& field, const void* inBuffer);
 	private:
 		Entity m_Entity;
 		std::string m_ClassName;
+		uint32_t m_Callbacks = ScriptCallback_None;
+		int32_t m_Slot = -1;
 	};
 
 	class ScriptEngine
@@ -73,23 +149,40 @@ namespace RXNEngine {
 		static void OnUpdateEntity(Entity entity, float deltaTime);
 		static void OnFixedUpdateEntity(Entity entity, float deltaTime);
 
-		static void OnCollisionEnter(uint64_t entityID, uint64_t otherID);
-		static void OnCollisionExit(uint64_t entityID, uint64_t otherID);
+		// Updates every live instance that handles the callback, one managed call per job instead of one per entity
+		static void OnUpdateEntities(float deltaTime);
+		static void OnFixedUpdateEntities(float deltaTime);
+
+		static ScriptCoroutineStatistics GetCoroutineStats();
 
-		static void OnTriggerEnter(uint64_t entityID, uint64_t otherID);
-		static void OnTriggerExit(uint64_t entityID, uint64_t otherID);
+		// Per class and per callback counters, kept by the host while enabled
+		static void SetProfilingEnabled(bool enabled);
+		static bool IsProfilingEnabled();
+		static void ResetProfile();
+		static std::vector<ScriptProfileEntry> GetProfile();
+		static bool ExportProfile(const std::string& filepath);
+		static const char* GetCallbackName(ScriptCallbackFlags callback);
+
+		// Delivers a physics step's contacts in one call, events for entities whose class lacks the handler are dropped here
+		static void OnContactEvents(const std::vector<PhysicsContactEvent>& events);
 
 		static bool EntityClassExists(const std::string& fullClassName);
 
 		static Scene* GetSceneContext();
 
-		static void RegisterField(const std::string& className, const std::string& fieldName, ScriptFieldType type);
+		static void RegisterField(const std::string& className, const std::string& fieldName, ScriptFieldType type, uint32_t offset, uint32_t size);
 		static const std::vector<ScriptField>& GetClassFields(const std::string& className);
+		static uint32_t GetClassFieldBufferSize(const std::string& className);
 
-		static Ref<ScriptInstance> GetEntityScriptInstance(UUID uuid);
+		// Valid until the next instance is created, don't hold on to it
+		static ScriptInstance* GetEntityScriptInstance(Entity entity);
 
+		// Keeps the running instances, their public fields are carried over to the reloaded classes and OnAfterReload
+		// runs in place of OnCreate
 		static void ReloadAssembly();
+		// Reloads once the assemblies have been left alone for a moment, changes come from a file watcher thread
 		static void ReloadIfModified(float deltaTime);
-
+	private:
+		static void WatchAssemblies(const std::filesystem::path& appPath, const std::filesystem::path& corePath);
 	};
 }
\ No newline at end of file
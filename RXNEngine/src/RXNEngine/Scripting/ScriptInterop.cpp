@@ -1,6 +1,7 @@
 #include "rxnpch.h"
 #include "ScriptInterop.h"
 #include "ScriptEngine.h"
+#include "ScriptComponentViews.h"
 #include "RXNEngine/Scene/Entity.h"
 #include "RXNEngine/Core/Input.h"
 #include "RXNEngine/Core/KeyCodes.h"
@@ -14,26 +15,6 @@
 namespace RXNEngine {
 
     namespace {
-        class IgnoreEntityFilter : public physx::PxQueryFilterCallback
-        {
-        public:
-            uint64_t IgnoreID;
-            IgnoreEntityFilter(uint64_t id) : IgnoreID(id) {}
-
-            virtual physx::PxQueryHitType::Enum preFilter(const physx::PxFilterData& filterData, const physx::PxShape* shape, const physx::PxRigidActor* actor, physx::PxHitFlags& queryFlags) override
-            {
-                if (actor && actor->userData && (uint64_t)actor->userData == IgnoreID)
-                    return physx::PxQueryHitType::eNONE;
-
-                return physx::PxQueryHitType::eBLOCK;
-            }
-
-            virtual physx::PxQueryHitType::Enum postFilter(const physx::PxFilterData& filterData, const physx::PxQueryHit& hit, const physx::PxShape* shape, const physx::PxRigidActor* actor) override
-            {
-                return physx::PxQueryHitType::eBLOCK;
-            }
-        };
-
         struct TransformDataInterop {
             glm::vec3 Translation;
             glm::vec3 Rotation;
@@ -47,9 +28,9 @@ namespace RXNEngine {
         RXN_CORE_WARN("C# SAYS: {0}", message);
     }
 
-    extern "C" void CORECLR_DELEGATE_CALLTYPE NativeScriptField_Register(const char* className, const char* fieldName, uint32_t type)
+    extern "C" void CORECLR_DELEGATE_CALLTYPE NativeScriptField_Register(const char* className, const char* fieldName, uint32_t type, uint32_t offset, uint32_t size)
     {
-        ScriptEngine::RegisterField(className, fieldName, (ScriptFieldType)type);
+        ScriptEngine::RegisterField(className, fieldName, (ScriptFieldType)type, offset, size);
     }
 
     extern "C" void CORECLR_DELEGATE_CALLTYPE NativeAssetManager_LoadMeshAsync(const char* filepath, uint64_t entityID)
@@ -219,44 +200,38 @@ namespace RXNEngine {
         }
     }
 
-    extern "C" uint8_t CORECLR_DELEGATE_CALLTYPE NativePhysics_Raycast(glm::vec3* origin, glm::vec3* direction, float maxDistance, RaycastHit* outHit, uint64_t ignoreEntityID)
+    extern "C" uint8_t CORECLR_DELEGATE_CALLTYPE NativePhysics_Raycast(glm::vec3* origin, glm::vec3* direction, float maxDistance, PhysicsQueryHit* outHit, uint64_t ignoreEntityID, uint32_t layerMask)
     {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        if (!scene) return 0;
-
-        physx::PxScene* pxScene = PhysicsSystem::GetScene();
-        if (!pxScene) return 0;
-
-        physx::PxVec3 pxOrigin(origin->x, origin->y, origin->z);
-        physx::PxVec3 pxDir(direction->x, direction->y, direction->z);
-        pxDir.normalize();
-
-        physx::PxRaycastBuffer hitInfo;
-
-        IgnoreEntityFilter filter(ignoreEntityID);
-        physx::PxQueryFilterData filterData;
-        filterData.flags |= physx::PxQueryFlag::ePREFILTER;
+        if (!ScriptEngine::GetSceneContext()) return 0;
 
-        PhysicsSystem::LockRead();
-        bool hit = pxScene->raycast(pxOrigin, pxDir, maxDistance, hitInfo, physx::PxHitFlags(physx::PxHitFlag::eDEFAULT), filterData, &filter);
-        PhysicsSystem::UnlockRead();
+        PhysicsQuery query{};
+        query.Origin = *origin;
+        query.Direction = *direction;
+        query.MaxDistance = maxDistance;
+        query.LayerMask = layerMask;
+        query.IgnoreEntityID = ignoreEntityID;
+        query.MaxHits = 1;
 
-        if (hit && hitInfo.hasBlock)
-        {
-            physx::PxRaycastHit block = hitInfo.block;
+        uint32_t hitCount = 0;
+        return PhysicsSystem::RaycastBatch(&query, 1, outHit, 1, &hitCount) != 0 ? 1 : 0;
+    }
 
-            if (block.actor && block.actor->userData)
-            {
-                outHit->EntityID = (uint64_t)block.actor->userData;
-                outHit->Position = glm::vec3(block.position.x, block.position.y, block.position.z);
-                outHit->Normal = glm::vec3(block.normal.x, block.normal.y, block.normal.z);
-                outHit->Distance = block.distance;
+    extern "C" uint32_t CORECLR_DELEGATE_CALLTYPE NativePhysics_RaycastBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, uint8_t parallel)
+    {
+        if (!ScriptEngine::GetSceneContext()) return 0;
+        return PhysicsSystem::RaycastBatch(queries, count, hits, hitCapacity, hitCounts, parallel != 0);
+    }
 
-                return 1;
-            }
-        }
+    extern "C" uint32_t CORECLR_DELEGATE_CALLTYPE NativePhysics_SweepBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, uint8_t parallel)
+    {
+        if (!ScriptEngine::GetSceneContext()) return 0;
+        return PhysicsSystem::SweepBatch(queries, count, hits, hitCapacity, hitCounts, parallel != 0);
+    }
 
-        return 0;
+    extern "C" uint32_t CORECLR_DELEGATE_CALLTYPE NativePhysics_OverlapBatch(const PhysicsQuery* queries, uint32_t count, PhysicsQueryHit* hits, uint32_t hitCapacity, uint32_t* hitCounts, uint8_t parallel)
+    {
+        if (!ScriptEngine::GetSceneContext()) return 0;
+        return PhysicsSystem::OverlapBatch(queries, count, hits, hitCapacity, hitCounts, parallel != 0);
     }
 
 #pragma endregion
@@ -498,6 +473,13 @@ namespace RXNEngine {
     }
 #pragma endregion
 
+#pragma region Component Views
+    extern "C" ScriptComponentViewBuffers* CORECLR_DELEGATE_CALLTYPE NativeScriptViews_GetBuffers()
+    {
+        return ScriptComponentViews::GetBuffers();
+    }
+#pragma endregion
+
     void ScriptInterop::RegisterFunctions(InternalCalls* outCalls)
     {
         RXN_CORE_ASSERT(outCalls, "InternalCalls struct is null!");
@@ -534,6 +516,9 @@ namespace RXNEngine {
         //Physics Interop
 		outCalls->NativeRigidbody_ApplyLinearImpulse = (void*)NativeRigidbody_ApplyLinearImpulse;
         outCalls->Physics_Raycast = (void*)NativePhysics_Raycast;
+        outCalls->Physics_RaycastBatch = (void*)NativePhysics_RaycastBatch;
+        outCalls->Physics_SweepBatch = (void*)NativePhysics_SweepBatch;
+        outCalls->Physics_OverlapBatch = (void*)NativePhysics_OverlapBatch;
 
         //Component Accessors
         outCalls->NativeEntity_HasComponent = (void*)NativeEntity_HasComponent;
@@ -574,6 +559,9 @@ namespace RXNEngine {
         outCalls->NativeCapsuleCollider_Get = (void*)NativeCapsuleCollider_Get;
         outCalls->NativeCapsuleCollider_Set = (void*)NativeCapsuleCollider_Set;
 
+        //Component Views
+        outCalls->NativeScriptViews_GetBuffers = (void*)NativeScriptViews_GetBuffers;
+
     }
 
 }
\ No newline at end of file
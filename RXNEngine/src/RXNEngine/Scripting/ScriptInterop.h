@@ -4,14 +4,6 @@
 
 namespace RXNEngine {
 
-    struct RaycastHit
-    {
-        uint64_t EntityID;
-        glm::vec3 Position;
-        glm::vec3 Normal;
-        float Distance;
-    };
-
     struct InternalCalls
     {
         //Logging & Core
@@ -46,6 +38,9 @@ namespace RXNEngine {
         //Physics Interop
         void* NativeRigidbody_ApplyLinearImpulse = nullptr;
         void* Physics_Raycast = nullptr;
+        void* Physics_RaycastBatch = nullptr;
+        void* Physics_SweepBatch = nullptr;
+        void* Physics_OverlapBatch = nullptr;
 
         //Component Accessors
         void* NativeEntity_HasComponent = nullptr;
@@ -85,6 +80,9 @@ namespace RXNEngine {
 
         void* NativeCapsuleCollider_Get = nullptr;
         void* NativeCapsuleCollider_Set = nullptr;
+
+        //Component Views
+        void* NativeScriptViews_GetBuffers = nullptr;
     };
 
     class ScriptInterop
@@ -1,17 +1,92 @@
 #include "rxnpch.h"
 #include "ModelSerializer.h"
 #include "RXNEngine/Asset/AssetManager.h"
+#include <cstring>
 #include <fstream>
 
 namespace RXNEngine {
 
-    static void WriteString(std::ofstream& out, const std::string& str)
+    // v3 is laid out for mapping: a fixed header with section offsets, every section starting on its own cache line.
+    // Vertex, position and index sections are uploaded straight from the mapping
+    static constexpr uint32_t s_MeshCacheVersion = 3;
+    static constexpr uint64_t s_SectionAlignment = 64;
+
+    enum class MeshSection : uint32_t
     {
-        uint32_t size = (uint32_t)str.size();
-        out.write((char*)&size, sizeof(uint32_t));
-        if (size > 0)
-            out.write(str.c_str(), size);
-    }
+        Vertices = 0, Positions, Indices, Submeshes, Materials, Strings,
+
+        Count
+    };
+
+    enum MaterialMapSlot : uint32_t
+    {
+        AlbedoMapSlot = 0, NormalMapSlot, MetalnessRoughnessMapSlot, AOMapSlot,
+
+        MaterialMapSlotCount
+    };
+
+    struct MeshSectionEntry
+    {
+        uint64_t Offset;
+        uint64_t Size;
+    };
+
+    struct MeshCacheHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t VertexCount;
+        uint32_t IndexCount;
+        uint32_t SubmeshCount;
+        uint32_t MaterialCount;
+        uint32_t SectionCount;
+        uint32_t Padding;
+        MeshSectionEntry Sections[(uint32_t)MeshSection::Count];
+    };
+
+    struct MeshStringRef
+    {
+        uint32_t Offset;
+        uint32_t Length;
+    };
+
+    struct SubmeshRecord
+    {
+        uint32_t BaseVertex;
+        uint32_t BaseIndex;
+        uint32_t MaterialIndex;
+        uint32_t IndexCount;
+        uint32_t VertexCount;
+        AABB BoundingBox;
+        glm::mat4 LocalTransform;
+        MeshStringRef NodeName;
+    };
+
+    struct MaterialRecord
+    {
+        Material::Parameters Params;
+        MeshStringRef Maps[MaterialMapSlotCount];
+        uint32_t IsTransparent;
+    };
+
+    static_assert(sizeof(MeshCacheHeader) == 128, "Mesh cache header layout changed!");
+    static_assert(sizeof(Vertex) == 32 && sizeof(SubmeshRecord) == 116 && sizeof(MaterialRecord) == 80, "Mesh cache record layout changed!");
+
+    // What a cache holds for a material, shared by the v2 reader and the writer so upgrades never create GPU resources
+    struct CachedMaterial
+    {
+        Material::Parameters Params;
+        std::string Maps[MaterialMapSlotCount];
+        bool IsTransparent = false;
+    };
+
+    struct CachedMesh
+    {
+        std::vector<Vertex> Vertices;
+        std::vector<uint32_t> Indices;
+        std::vector<Submesh> Submeshes;
+        std::vector<CachedMaterial> Materials;
+    };
 
     static std::string ReadString(std::ifstream& in)
     {
@@ -26,143 +101,334 @@ namespace RXNEngine {
         return "";
     }
 
-    void ModelSerializer::Serialize(const std::string& filepath, const Ref<StaticMesh>& mesh)
+    static uint64_t AlignSection(uint64_t offset)
     {
-        std::ofstream out(filepath, std::ios::binary);
-        if (!out.is_open())
+        return (offset + s_SectionAlignment - 1) & ~(s_SectionAlignment - 1);
+    }
+
+    static bool WriteCache(const std::string& filepath, std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+        const std::vector<Submesh>& submeshes, const std::vector<CachedMaterial>& materials)
+    {
+        std::vector<char> strings;
+        auto addString = [&strings](const std::string& str)
+            {
+                MeshStringRef ref = { (uint32_t)strings.size(), (uint32_t)str.size() };
+                strings.insert(strings.end(), str.begin(), str.end());
+                return ref;
+            };
+
+        std::vector<glm::vec3> positions(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++)
+            positions[i] = vertices[i].Position;
+
+        std::vector<SubmeshRecord> submeshRecords(submeshes.size());
+        for (size_t i = 0; i < submeshes.size(); i++)
         {
-            RXN_CORE_ERROR("Failed to write binary asset: {0}", filepath);
-            return;
+            const Submesh& submesh = submeshes[i];
+            submeshRecords[i] = { submesh.BaseVertex, submesh.BaseIndex, submesh.MaterialIndex, submesh.IndexCount, submesh.VertexCount,
+                submesh.BoundingBox, submesh.LocalTransform, addString(submesh.NodeName) };
         }
 
-        const char* magic = "RXN\0";
-        out.write(magic, 4);
-
-        uint32_t version = 2;
-        out.write((char*)&version, sizeof(uint32_t));
-
-        const auto& vertices = mesh->GetVertices();
-        const auto& indices = mesh->GetIndices();
-
-        uint32_t vCount = (uint32_t)vertices.size();
-        uint32_t iCount = (uint32_t)indices.size();
-        out.write((char*)&vCount, sizeof(uint32_t));
-        out.write((char*)&iCount, sizeof(uint32_t));
-
-        out.write((char*)vertices.data(), vCount * sizeof(Vertex));
-        out.write((char*)indices.data(), iCount * sizeof(uint32_t));
-
-        const auto& submeshes = mesh->GetSubmeshes();
-        uint32_t submeshCount = (uint32_t)submeshes.size();
-        out.write((char*)&submeshCount, sizeof(uint32_t));
+        std::vector<MaterialRecord> materialRecords(materials.size());
+        for (size_t i = 0; i < materials.size(); i++)
+        {
+            materialRecords[i].Params = materials[i].Params;
+            for (uint32_t slot = 0; slot < MaterialMapSlotCount; slot++)
+                materialRecords[i].Maps[slot] = addString(materials[i].Maps[slot]);
+            materialRecords[i].IsTransparent = materials[i].IsTransparent;
+        }
 
-        for (const auto& submesh : submeshes)
+        const std::pair<const void*, uint64_t> sections[] = {
+            { vertices.data(), vertices.size_bytes() },
+            { positions.data(), positions.size() * sizeof(glm::vec3) },
+            { indices.data(), indices.size_bytes() },
+            { submeshRecords.data(), submeshRecords.size() * sizeof(SubmeshRecord) },
+            { materialRecords.data(), materialRecords.size() * sizeof(MaterialRecord) },
+            { strings.data(), strings.size() }
+        };
+        static_assert(std::size(sections) == (size_t)MeshSection::Count);
+
+        MeshCacheHeader header = {};
+        memcpy(header.Magic, "RXN\0", 4);
+        header.Version = s_MeshCacheVersion;
+        header.VertexCount = (uint32_t)vertices.size();
+        header.IndexCount = (uint32_t)indices.size();
+        header.SubmeshCount = (uint32_t)submeshes.size();
+        header.MaterialCount = (uint32_t)materials.size();
+        header.SectionCount = (uint32_t)MeshSection::Count;
+
+        uint64_t offset = AlignSection(sizeof(MeshCacheHeader));
+        for (uint32_t i = 0; i < (uint32_t)MeshSection::Count; i++)
         {
-            out.write((char*)&submesh.BaseVertex, sizeof(uint32_t));
-            out.write((char*)&submesh.BaseIndex, sizeof(uint32_t));
-            out.write((char*)&submesh.MaterialIndex, sizeof(uint32_t));
-            out.write((char*)&submesh.IndexCount, sizeof(uint32_t));
-            out.write((char*)&submesh.VertexCount, sizeof(uint32_t));
-            out.write((char*)&submesh.BoundingBox, sizeof(AABB));
-            out.write((char*)&submesh.LocalTransform, sizeof(glm::mat4));
-            WriteString(out, submesh.NodeName);
+            header.Sections[i] = { offset, sections[i].second };
+            offset = AlignSection(offset + sections[i].second);
         }
 
-        const auto& materials = mesh->GetMaterials();
-        uint32_t matCount = (uint32_t)materials.size();
-        out.write((char*)&matCount, sizeof(uint32_t));
+        std::vector<uint8_t> data(offset, 0);
+        memcpy(data.data(), &header, sizeof(header));
+        for (uint32_t i = 0; i < (uint32_t)MeshSection::Count; i++)
+        {
+            if (sections[i].second > 0)
+                memcpy(data.data() + header.Sections[i].Offset, sections[i].first, sections[i].second);
+        }
 
-        for (const auto& mat : materials)
+        // Written next to the cache and swapped in, an older version of it may still be mapped by a loaded mesh
+        std::string tempPath = filepath + ".tmp";
         {
-            auto params = mat->GetParameters();
-            out.write((char*)&params, sizeof(Material::Parameters));
+            std::ofstream out(tempPath, std::ios::binary);
+            if (!out.is_open())
+                return false;
 
-            WriteString(out, mat->GetAlbedoMap() ? mat->GetAlbedoMap()->GetPath() : "");
-            WriteString(out, mat->GetNormalMap() ? mat->GetNormalMap()->GetPath() : "");
-            WriteString(out, mat->GetMetalnessRoughnessMap() ? mat->GetMetalnessRoughnessMap()->GetPath() : "");
-            WriteString(out, mat->GetAOMap() ? mat->GetAOMap()->GetPath() : "");
+            out.write((const char*)data.data(), data.size());
+            if (!out.good())
+                return false;
+        }
 
-            bool isTransparent = mat->IsTransparent();
-            out.write((char*)&isTransparent, sizeof(bool));
+        std::error_code error;
+        std::filesystem::rename(tempPath, filepath, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
         }
 
-        out.close();
+        return true;
     }
 
-    Ref<StaticMesh> ModelSerializer::Deserialize(const std::string& filepath)
+    static bool ReadLegacyCache(const std::string& filepath, CachedMesh& mesh)
     {
         std::ifstream in(filepath, std::ios::binary);
-        if (!in.is_open()) return nullptr;
+        if (!in.is_open()) return false;
 
         char magic[4];
         in.read(magic, 4);
-        if (std::string(magic) != "RXN\0") return nullptr;
+        if (std::string(magic) != "RXN\0") return false;
 
         uint32_t version;
         in.read((char*)&version, sizeof(uint32_t));
-        if (version != 2)
-        {
-            RXN_CORE_WARN("Old model format detected. It will be re-imported.");
-            return nullptr;
-        }
+        if (version != 2) return false;
 
         uint32_t vCount = 0, iCount = 0;
         in.read((char*)&vCount, sizeof(uint32_t));
         in.read((char*)&iCount, sizeof(uint32_t));
 
-        std::vector<Vertex> vertices(vCount);
-        std::vector<uint32_t> indices(iCount);
-        in.read((char*)vertices.data(), vCount * sizeof(Vertex));
-        in.read((char*)indices.data(), iCount * sizeof(uint32_t));
+        mesh.Vertices.resize(vCount);
+        mesh.Indices.resize(iCount);
+        in.read((char*)mesh.Vertices.data(), vCount * sizeof(Vertex));
+        in.read((char*)mesh.Indices.data(), iCount * sizeof(uint32_t));
 
         uint32_t submeshCount;
         in.read((char*)&submeshCount, sizeof(uint32_t));
-        std::vector<Submesh> submeshes(submeshCount);
+        mesh.Submeshes.resize(submeshCount);
 
         for (uint32_t i = 0; i < submeshCount; i++)
         {
-            in.read((char*)&submeshes[i].BaseVertex, sizeof(uint32_t));
-            in.read((char*)&submeshes[i].BaseIndex, sizeof(uint32_t));
-            in.read((char*)&submeshes[i].MaterialIndex, sizeof(uint32_t));
-            in.read((char*)&submeshes[i].IndexCount, sizeof(uint32_t));
-            in.read((char*)&submeshes[i].VertexCount, sizeof(uint32_t));
-            in.read((char*)&submeshes[i].BoundingBox, sizeof(AABB));
-            in.read((char*)&submeshes[i].LocalTransform, sizeof(glm::mat4));
-            submeshes[i].NodeName = ReadString(in);
+            in.read((char*)&mesh.Submeshes[i].BaseVertex, sizeof(uint32_t));
+            in.read((char*)&mesh.Submeshes[i].BaseIndex, sizeof(uint32_t));
+            in.read((char*)&mesh.Submeshes[i].MaterialIndex, sizeof(uint32_t));
+            in.read((char*)&mesh.Submeshes[i].IndexCount, sizeof(uint32_t));
+            in.read((char*)&mesh.Submeshes[i].VertexCount, sizeof(uint32_t));
+            in.read((char*)&mesh.Submeshes[i].BoundingBox, sizeof(AABB));
+            in.read((char*)&mesh.Submeshes[i].LocalTransform, sizeof(glm::mat4));
+            mesh.Submeshes[i].NodeName = ReadString(in);
         }
 
         uint32_t matCount;
         in.read((char*)&matCount, sizeof(uint32_t));
-        std::vector<Ref<Material>> materials(matCount);
+        mesh.Materials.resize(matCount);
 
+        for (uint32_t i = 0; i < matCount; i++)
+        {
+            CachedMaterial& mat = mesh.Materials[i];
+            in.read((char*)&mat.Params, sizeof(Material::Parameters));
+
+            for (uint32_t slot = 0; slot < MaterialMapSlotCount; slot++)
+                mat.Maps[slot] = ReadString(in);
+
+            in.read((char*)&mat.IsTransparent, sizeof(bool));
+        }
+
+        return (bool)in;
+    }
+
+    static Ref<Material> CreateMaterial(const Material::Parameters& params, const std::string* maps, bool isTransparent)
+    {
         Ref<Shader> defaultPBR = AssetManager::GetShader("res/shaders/pbr.glsl");
+        Ref<Material> mat = Material::CreateDefault(defaultPBR);
 
-        for (uint32_t i = 0; i < matCount; i++)
+        mat->SetAlbedoColor(params.AlbedoColor);
+        mat->SetMetalness(params.Metalness);
+        mat->SetRoughness(params.Roughness);
+        mat->SetEmissiveColor(params.EmissiveColor);
+        mat->SetAO(params.AO);
+
+        if (!maps[AlbedoMapSlot].empty()) mat->SetAlbedoMap(AssetManager::GetTexture(maps[AlbedoMapSlot]));
+        if (!maps[NormalMapSlot].empty()) mat->SetNormalMap(AssetManager::GetTexture(maps[NormalMapSlot], TextureUsage::NormalMap));
+        if (!maps[MetalnessRoughnessMapSlot].empty()) mat->SetMetalnessRoughnessMap(AssetManager::GetTexture(maps[MetalnessRoughnessMapSlot]));
+        if (!maps[AOMapSlot].empty()) mat->SetAOMap(AssetManager::GetTexture(maps[AOMapSlot]));
+
+        mat->SetTransparent(isTransparent);
+        return mat;
+    }
+
+    static Ref<StaticMesh> DeserializeMapped(const std::string& filepath, const Ref<MappedFile>& file)
+    {
+        OPTICK_EVENT();
+
+        const uint8_t* data = file->GetData();
+        const MeshCacheHeader* header = (const MeshCacheHeader*)data;
+
+        if (file->GetSize() < sizeof(MeshCacheHeader) || header->SectionCount != (uint32_t)MeshSection::Count)
+        {
+            RXN_CORE_ERROR("Malformed mesh cache: {0}", filepath);
+            return nullptr;
+        }
+
+        const uint64_t expectedSizes[] = {
+            (uint64_t)header->VertexCount * sizeof(Vertex),
+            (uint64_t)header->VertexCount * sizeof(glm::vec3),
+            (uint64_t)header->IndexCount * sizeof(uint32_t),
+            (uint64_t)header->SubmeshCount * sizeof(SubmeshRecord),
+            (uint64_t)header->MaterialCount * sizeof(MaterialRecord)
+        };
+
+        for (uint32_t i = 0; i < (uint32_t)MeshSection::Count; i++)
+        {
+            const MeshSectionEntry& section = header->Sections[i];
+            bool sizeMatches = i >= std::size(expectedSizes) || section.Size == expectedSizes[i];
+            if (section.Offset % s_SectionAlignment != 0 || section.Offset + section.Size > file->GetSize() || !sizeMatches)
+            {
+                RXN_CORE_ERROR("Malformed mesh cache: {0}", filepath);
+                return nullptr;
+            }
+        }
+
+        auto section = [&](MeshSection type) { return data + header->Sections[(uint32_t)type].Offset; };
+
+        std::span<const Vertex> vertices((const Vertex*)section(MeshSection::Vertices), header->VertexCount);
+        std::span<const glm::vec3> positions((const glm::vec3*)section(MeshSection::Positions), header->VertexCount);
+        std::span<const uint32_t> indices((const uint32_t*)section(MeshSection::Indices), header->IndexCount);
+
+        const char* strings = (const char*)section(MeshSection::Strings);
+        uint64_t stringsSize = header->Sections[(uint32_t)MeshSection::Strings].Size;
+        auto getString = [&](MeshStringRef ref)
+            {
+                if ((uint64_t)ref.Offset + ref.Length > stringsSize)
+                    return std::string();
+                return std::string(strings + ref.Offset, ref.Length);
+            };
+
+        const SubmeshRecord* submeshRecords = (const SubmeshRecord*)section(MeshSection::Submeshes);
+        std::vector<Submesh> submeshes(header->SubmeshCount);
+        for (uint32_t i = 0; i < header->SubmeshCount; i++)
+        {
+            const SubmeshRecord& record = submeshRecords[i];
+            submeshes[i].BaseVertex = record.BaseVertex;
+            submeshes[i].BaseIndex = record.BaseIndex;
+            submeshes[i].MaterialIndex = record.MaterialIndex;
+            submeshes[i].IndexCount = record.IndexCount;
+            submeshes[i].VertexCount = record.VertexCount;
+            submeshes[i].BoundingBox = record.BoundingBox;
+            submeshes[i].LocalTransform = record.LocalTransform;
+            submeshes[i].NodeName = getString(record.NodeName);
+        }
+
+        const MaterialRecord* materialRecords = (const MaterialRecord*)section(MeshSection::Materials);
+        std::vector<Ref<Material>> materials(header->MaterialCount);
+        for (uint32_t i = 0; i < header->MaterialCount; i++)
+        {
+            const MaterialRecord& record = materialRecords[i];
+
+            std::string maps[MaterialMapSlotCount];
+            for (uint32_t slot = 0; slot < MaterialMapSlotCount; slot++)
+                maps[slot] = getString(record.Maps[slot]);
+
+            materials[i] = CreateMaterial(record.Params, maps, record.IsTransparent != 0);
+        }
+
+        return CreateRef<StaticMesh>(file, vertices, positions, indices, submeshes, materials);
+    }
+
+    void ModelSerializer::Serialize(const std::string& filepath, const Ref<StaticMesh>& mesh)
+    {
+        std::vector<CachedMaterial> materials;
+        for (const auto& mat : mesh->GetMaterials())
+        {
+            CachedMaterial& cached = materials.emplace_back();
+            cached.Params = mat->GetParameters();
+            cached.Maps[AlbedoMapSlot] = mat->GetAlbedoMap() ? mat->GetAlbedoMap()->GetPath() : "";
+            cached.Maps[NormalMapSlot] = mat->GetNormalMap() ? mat->GetNormalMap()->GetPath() : "";
+            cached.Maps[MetalnessRoughnessMapSlot] = mat->GetMetalnessRoughnessMap() ? mat->GetMetalnessRoughnessMap()->GetPath() : "";
+            cached.Maps[AOMapSlot] = mat->GetAOMap() ? mat->GetAOMap()->GetPath() : "";
+            cached.IsTransparent = mat->IsTransparent();
+        }
+
+        if (!WriteCache(filepath, mesh->GetVertices(), mesh->GetIndices(), mesh->GetSubmeshes(), materials))
+            RXN_CORE_ERROR("Failed to write binary asset: {0}", filepath);
+    }
+
+    Ref<StaticMesh> ModelSerializer::Deserialize(const std::string& filepath)
+    {
+        Ref<MappedFile> file = CreateRef<MappedFile>(filepath);
+        if (!file->IsValid() || file->GetSize() < 8) return nullptr;
+
+        const char* magic = (const char*)file->GetData();
+        if (memcmp(magic, "RXN\0", 4) != 0) return nullptr;
+
+        uint32_t version;
+        memcpy(&version, file->GetData() + 4, sizeof(uint32_t));
+
+        if (version == s_MeshCacheVersion)
+            return DeserializeMapped(filepath, file);
+
+        if (version == 2)
         {
-            Ref<Material> mat = Material::CreateDefault(defaultPBR);
+            RXN_CORE_WARN("Loading v2 model cache '{0}' through copies, upgrade it to map it directly", filepath);
 
-            Material::Parameters params;
-            in.read((char*)&params, sizeof(Material::Parameters));
+            CachedMesh cached;
+            if (!ReadLegacyCache(filepath, cached))
+                return nullptr;
 
-            mat->SetAlbedoColor(params.AlbedoColor);
-            mat->SetMetalness(params.Metalness);
-            mat->SetRoughness(params.Roughness);
-            mat->SetEmissiveColor(params.EmissiveColor);
-            mat->SetAO(params.AO);
+            std::vector<Ref<Material>> materials;
+            for (const auto& mat : cached.Materials)
+                materials.push_back(CreateMaterial(mat.Params, mat.Maps, mat.IsTransparent));
 
-            std::string path;
-            if (!(path = ReadString(in)).empty()) mat->SetAlbedoMap(AssetManager::GetTexture(path));
-            if (!(path = ReadString(in)).empty()) mat->SetNormalMap(AssetManager::GetTexture(path));
-            if (!(path = ReadString(in)).empty()) mat->SetMetalnessRoughnessMap(AssetManager::GetTexture(path));
-            if (!(path = ReadString(in)).empty()) mat->SetAOMap(AssetManager::GetTexture(path));
+            return CreateRef<StaticMesh>(cached.Vertices, cached.Indices, cached.Submeshes, materials);
+        }
 
-            bool isTransparent = false;
-            in.read((char*)&isTransparent, sizeof(bool));
-            mat->SetTransparent(isTransparent);
+        RXN_CORE_WARN("Old model format detected. It will be re-imported.");
+        return nullptr;
+    }
 
-            materials[i] = mat;
+    bool ModelSerializer::Upgrade(const std::string& filepath)
+    {
+        CachedMesh cached;
+        if (!ReadLegacyCache(filepath, cached))
+            return false;
+
+        if (!WriteCache(filepath, cached.Vertices, cached.Indices, cached.Submeshes, cached.Materials))
+        {
+            RXN_CORE_ERROR("Failed to upgrade model cache: {0}", filepath);
+            return false;
+        }
+
+        return true;
+    }
+
+    uint32_t ModelSerializer::UpgradeDirectory(const std::filesystem::path& directory)
+    {
+        uint32_t upgraded = 0;
+
+        std::error_code error;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".rxn" && Upgrade(entry.path().string()))
+            {
+                RXN_CORE_INFO("Upgraded model cache: {0}", entry.path().string());
+                upgraded++;
+            }
         }
 
-        return CreateRef<StaticMesh>(vertices, indices, submeshes, materials);
+        return upgraded;
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RXNEngine/Asset/StaticMesh.h"
+#include <filesystem>
 #include <string>
 
 namespace RXNEngine {
@@ -10,6 +11,11 @@ namespace RXNEngine {
 	public:
 		static void Serialize(const std::string& filepath, const Ref<StaticMesh>& mesh);
 		static Ref<StaticMesh> Deserialize(const std::string& filepath);
+
+		// Rewrites a v2 cache in the current format without touching the GPU, returns false if it isn't a v2 cache
+		static bool Upgrade(const std::string& filepath);
+		// Upgrades every .rxn cache under directory, returns how many were rewritten
+		static uint32_t UpgradeDirectory(const std::filesystem::path& directory);
 	};
 
 }
\ No newline at end of file
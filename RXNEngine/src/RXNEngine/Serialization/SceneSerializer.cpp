@@ -6,6 +6,7 @@
 #include "RXNEngine/Core/UUID.h"
 #include "RXNEngine/Asset/AssetManager.h"
 
+#include <cstring>
 #include <fstream>
 #include <yaml-cpp/yaml.h>
 
@@ -139,6 +140,261 @@ namespace RXNEngine {
 		return filePath.generic_string();
 	}
 
+	static constexpr char s_BinarySceneMagic[4] = { 'R', 'X', 'S', 'B' };
+	static constexpr uint32_t s_BinarySceneVersion = 1;
+	static constexpr uint32_t s_BinaryBlockVersion = 1;
+
+	// Ids are stored in the file, only ever append
+	enum class SceneBlockType : uint32_t
+	{
+		Strings = 0,
+		Children = 1,
+		Entities = 2,
+		Transform = 3,
+		Relationship = 4,
+		Camera = 5,
+		StaticMesh = 6,
+		DirectionalLight = 7,
+		PointLight = 8,
+		Rigidbody = 9,
+		BoxCollider = 10,
+		SphereCollider = 11,
+		CapsuleCollider = 12,
+		Script = 13,
+		RigidbodyLayer = 14,
+
+		Count
+	};
+
+	struct BinaryStringRef
+	{
+		uint32_t Offset = 0;
+		uint32_t Length = 0;
+	};
+
+	struct BinarySceneHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t EntityCount;
+		uint32_t BlockCount;
+		uint64_t PrimaryCameraID;
+		BinaryStringRef SkyboxPath;
+		float SkyboxIntensity;
+		uint32_t Padding;
+	};
+
+	// Keyed blocks hold Count UUIDs followed by Count records, Strings and Children are plain arrays
+	struct BinarySceneBlock
+	{
+		uint32_t Type;
+		uint32_t Version;
+		uint32_t Count;
+		uint32_t RecordSize;
+		uint64_t Size;
+	};
+
+	struct EntityRecord { BinaryStringRef Tag; };
+	struct TransformRecord { glm::vec3 Translation, Rotation, Scale; };
+	struct RelationshipRecord { uint64_t ParentHandle; uint32_t FirstChild; uint32_t ChildCount; };
+
+	struct CameraRecord
+	{
+		int32_t ProjectionType;
+		float PerspectiveFOV, PerspectiveNear, PerspectiveFar;
+		float OrthographicSize, OrthographicNear, OrthographicFar;
+		uint32_t FixedAspectRatio;
+	};
+
+	struct StaticMeshRecord { BinaryStringRef AssetPath; uint32_t SubmeshIndex; };
+	struct DirectionalLightRecord { glm::vec3 Color; float Intensity; };
+	struct PointLightRecord { glm::vec3 Color; float Intensity, Radius, Falloff; };
+
+	struct RigidbodyRecord
+	{
+		int32_t Type;
+		float Mass, LinearDrag, AngularDrag;
+		uint32_t FixedRotation;
+		uint32_t UseCCD;
+		float CCDVelocityThreshold;
+	};
+
+	struct BoxColliderRecord { glm::vec3 HalfExtents, Offset; float StaticFriction, DynamicFriction, Restitution; uint32_t IsTrigger; };
+	struct SphereColliderRecord { float Radius; glm::vec3 Offset; float StaticFriction, DynamicFriction, Restitution; uint32_t IsTrigger; };
+	struct CapsuleColliderRecord { float Radius, Height; glm::vec3 Offset; float StaticFriction, DynamicFriction, Restitution; uint32_t IsTrigger; };
+	struct ScriptRecord { BinaryStringRef ClassName; };
+	// Its own block so scenes written before layers existed keep their rigidbody records
+	struct RigidbodyLayerRecord { uint32_t Layer; };
+
+	static_assert(sizeof(BinarySceneHeader) == 40 && sizeof(BinarySceneBlock) == 24, "Binary scene layout changed!");
+	static_assert(sizeof(TransformRecord) == 36 && sizeof(RelationshipRecord) == 16 && sizeof(CameraRecord) == 32, "Binary scene layout changed!");
+	static_assert(sizeof(BoxColliderRecord) == 40 && sizeof(SphereColliderRecord) == 32 && sizeof(CapsuleColliderRecord) == 36, "Binary scene layout changed!");
+
+	static uint32_t GetRecordSize(SceneBlockType type)
+	{
+		switch (type)
+		{
+			case SceneBlockType::Strings:          return 1;
+			case SceneBlockType::Children:         return sizeof(uint64_t);
+			case SceneBlockType::Entities:         return sizeof(EntityRecord);
+			case SceneBlockType::Transform:        return sizeof(TransformRecord);
+			case SceneBlockType::Relationship:     return sizeof(RelationshipRecord);
+			case SceneBlockType::Camera:           return sizeof(CameraRecord);
+			case SceneBlockType::StaticMesh:       return sizeof(StaticMeshRecord);
+			case SceneBlockType::DirectionalLight: return sizeof(DirectionalLightRecord);
+			case SceneBlockType::PointLight:       return sizeof(PointLightRecord);
+			case SceneBlockType::Rigidbody:        return sizeof(RigidbodyRecord);
+			case SceneBlockType::BoxCollider:      return sizeof(BoxColliderRecord);
+			case SceneBlockType::SphereCollider:   return sizeof(SphereColliderRecord);
+			case SceneBlockType::CapsuleCollider:  return sizeof(CapsuleColliderRecord);
+			case SceneBlockType::Script:           return sizeof(ScriptRecord);
+			case SceneBlockType::RigidbodyLayer:   return sizeof(RigidbodyLayerRecord);
+		}
+
+		return 0;
+	}
+
+	static bool IsKeyedBlock(SceneBlockType type)
+	{
+		return type != SceneBlockType::Strings && type != SceneBlockType::Children;
+	}
+
+	static uint64_t AlignBlock(uint64_t size)
+	{
+		return (size + 7) & ~7ull;
+	}
+
+	class BinarySceneWriter
+	{
+	public:
+		BinaryStringRef AddString(const std::string& str)
+		{
+			BinaryStringRef ref = { (uint32_t)m_Strings.size(), (uint32_t)str.size() };
+			m_Strings.insert(m_Strings.end(), str.begin(), str.end());
+			return ref;
+		}
+
+		uint32_t AddChildren(const std::vector<UUID>& children)
+		{
+			uint32_t first = (uint32_t)m_Children.size();
+			for (UUID child : children)
+				m_Children.push_back(child);
+			return first;
+		}
+
+		template<typename Record>
+		void AddBlock(SceneBlockType type, const std::vector<uint64_t>& keys, const std::vector<Record>& records)
+		{
+			if (records.empty())
+				return;
+
+			RXN_CORE_ASSERT(keys.size() == records.size());
+			AddBlock(type, (uint32_t)records.size(), keys.data(), records.data(), sizeof(Record));
+		}
+
+		bool Write(const std::string& filepath, BinarySceneHeader header)
+		{
+			AddBlock(SceneBlockType::Strings, (uint32_t)m_Strings.size(), nullptr, m_Strings.data(), 1);
+			AddBlock(SceneBlockType::Children, (uint32_t)m_Children.size(), nullptr, m_Children.data(), sizeof(uint64_t));
+
+			memcpy(header.Magic, s_BinarySceneMagic, sizeof(header.Magic));
+			header.Version = s_BinarySceneVersion;
+			header.BlockCount = m_BlockCount;
+			memcpy(m_Data.data(), &header, sizeof(header));
+
+			std::ofstream out(filepath, std::ios::binary);
+			if (!out.is_open())
+				return false;
+
+			out.write((const char*)m_Data.data(), m_Data.size());
+			return out.good();
+		}
+	private:
+		void AddBlock(SceneBlockType type, uint32_t count, const uint64_t* keys, const void* records, uint32_t recordSize)
+		{
+			if (count == 0)
+				return;
+
+			uint64_t keySize = keys ? AlignBlock((uint64_t)count * sizeof(uint64_t)) : 0;
+			uint64_t recordBytes = (uint64_t)count * recordSize;
+
+			BinarySceneBlock block = { (uint32_t)type, s_BinaryBlockVersion, count, recordSize, AlignBlock(keySize + recordBytes) };
+
+			size_t offset = m_Data.size();
+			m_Data.resize(offset + sizeof(BinarySceneBlock) + block.Size, 0);
+			memcpy(m_Data.data() + offset, &block, sizeof(block));
+			if (keys)
+				memcpy(m_Data.data() + offset + sizeof(block), keys, count * sizeof(uint64_t));
+			memcpy(m_Data.data() + offset + sizeof(block) + keySize, records, recordBytes);
+
+			m_BlockCount++;
+		}
+	private:
+		// Room for the header, filled in by Write()
+		std::vector<uint8_t> m_Data = std::vector<uint8_t>(sizeof(BinarySceneHeader), 0);
+		std::vector<char> m_Strings;
+		std::vector<uint64_t> m_Children;
+		uint32_t m_BlockCount = 0;
+	};
+
+	template<typename Component, typename Record, typename Func>
+	static uint32_t AddComponentBlock(entt::registry& registry, BinarySceneWriter& writer, SceneBlockType type, Func convert)
+	{
+		std::vector<uint64_t> keys;
+		std::vector<Record> records;
+		registry.view<IDComponent, Component>().each([&](auto entity, const IDComponent& id, const Component& component)
+			{
+				keys.push_back(id.ID);
+				records.push_back(convert(component));
+			});
+
+		writer.AddBlock(type, keys, records);
+		return (uint32_t)keys.size();
+	}
+
+	struct BinarySceneBlockView
+	{
+		const uint64_t* Keys = nullptr;
+		const uint8_t* Records = nullptr;
+		uint32_t Count = 0;
+
+		template<typename Record>
+		const Record* As() const { return (const Record*)Records; }
+	};
+
+	template<typename Record, typename Func>
+	static void ForEachRecord(const BinarySceneBlockView& block, const std::unordered_map<uint64_t, uint32_t>& indices, Func func)
+	{
+		const Record* records = block.As<Record>();
+		for (uint32_t i = 0; i < block.Count; i++)
+		{
+			auto it = indices.find(block.Keys[i]);
+			if (it != indices.end())
+				func(it->second, records[i]);
+		}
+	}
+
+	template<typename Component, typename Record, typename Func>
+	static void InsertComponents(entt::registry& registry, const BinarySceneBlockView& block, const std::vector<entt::entity>& handles,
+		const std::unordered_map<uint64_t, uint32_t>& indices, Func convert)
+	{
+		if (block.Count == 0)
+			return;
+
+		std::vector<entt::entity> owners;
+		std::vector<Component> components;
+		owners.reserve(block.Count);
+		components.reserve(block.Count);
+
+		ForEachRecord<Record>(block, indices, [&](uint32_t index, const Record& record)
+			{
+				owners.push_back(handles[index]);
+				convert(components.emplace_back(), record);
+			});
+
+		registry.insert<Component>(owners.begin(), owners.end(), components.begin());
+	}
+
 	SceneSerializer::SceneSerializer(const Ref<Scene>& scene)
 		: m_Scene(scene)
 	{
@@ -272,6 +528,8 @@ namespace RXNEngine {
 			out << YAML::Key << "UseCCD" << YAML::Value << rb.UseCCD;
 			out << YAML::Key << "CCDVelocityThreshold" << YAML::Value << rb.CCDVelocityThreshold;
 
+			out << YAML::Key << "Layer" << YAML::Value << rb.Layer;
+
 			out << YAML::EndMap; // RigidbodyComponent
 		}
 
@@ -386,6 +644,9 @@ namespace RXNEngine {
 
 	bool SceneSerializer::Deserialize(const std::string& filepath)
 	{
+		if (IsBinary(filepath))
+			return DeserializeBinary(filepath);
+
 		YAML::Node data;
 		try
 		{
@@ -552,6 +813,8 @@ namespace RXNEngine {
 						rb.UseCCD = rigidbodyComponent["UseCCD"].as<bool>();
 					if (rigidbodyComponent["CCDVelocityThreshold"])
 						rb.CCDVelocityThreshold = rigidbodyComponent["CCDVelocityThreshold"].as<float>();
+					if (rigidbodyComponent["Layer"])
+						rb.Layer = rigidbodyComponent["Layer"].as<uint32_t>();
 				}
 
 				auto boxColliderComponent = entity["BoxColliderComponent"];
@@ -636,4 +899,349 @@ namespace RXNEngine {
 		return false;
 	}
 
+	void SceneSerializer::SerializeBinary(const std::string& filepath)
+	{
+		OPTICK_EVENT();
+
+		entt::registry& registry = m_Scene->m_Registry;
+		BinarySceneWriter writer;
+
+		BinarySceneHeader header = {};
+		Entity primaryCam = m_Scene->GetPrimaryCameraEntity();
+		header.PrimaryCameraID = primaryCam ? (uint64_t)primaryCam.GetUUID() : (uint64_t)UUID::Null;
+		header.SkyboxIntensity = m_Scene->m_SkyboxIntensity;
+		if (m_Scene->m_Skybox)
+			header.SkyboxPath = writer.AddString(GetRelativePath(m_Scene->m_Skybox->GetPath()));
+
+		header.EntityCount = AddComponentBlock<TagComponent, EntityRecord>(registry, writer, SceneBlockType::Entities, [&](const TagComponent& tc)
+			{
+				return EntityRecord{ writer.AddString(tc.Tag) };
+			});
+
+		AddComponentBlock<TransformComponent, TransformRecord>(registry, writer, SceneBlockType::Transform, [](const TransformComponent& tc)
+			{
+				return TransformRecord{ tc.Translation, tc.Rotation, tc.Scale };
+			});
+
+		AddComponentBlock<RelationshipComponent, RelationshipRecord>(registry, writer, SceneBlockType::Relationship, [&](const RelationshipComponent& rc)
+			{
+				return RelationshipRecord{ rc.ParentHandle, writer.AddChildren(rc.Children), (uint32_t)rc.Children.size() };
+			});
+
+		AddComponentBlock<CameraComponent, CameraRecord>(registry, writer, SceneBlockType::Camera, [](const CameraComponent& cc)
+			{
+				const SceneCamera& camera = cc.Camera;
+				return CameraRecord{ (int32_t)camera.GetProjectionType(),
+					camera.GetPerspectiveFOV(), camera.GetPerspectiveNearClip(), camera.GetPerspectiveFarClip(),
+					camera.GetOrthographicSize(), camera.GetOrthographicNearClip(), camera.GetOrthographicFarClip(),
+					cc.FixedAspectRatio };
+			});
+
+		AddComponentBlock<StaticMeshComponent, StaticMeshRecord>(registry, writer, SceneBlockType::StaticMesh, [&](const StaticMeshComponent& mc)
+			{
+				return StaticMeshRecord{ writer.AddString(GetRelativePath(mc.AssetPath)), mc.SubmeshIndex };
+			});
+
+		AddComponentBlock<DirectionalLightComponent, DirectionalLightRecord>(registry, writer, SceneBlockType::DirectionalLight, [](const DirectionalLightComponent& dl)
+			{
+				return DirectionalLightRecord{ dl.Color, dl.Intensity };
+			});
+
+		AddComponentBlock<PointLightComponent, PointLightRecord>(registry, writer, SceneBlockType::PointLight, [](const PointLightComponent& pl)
+			{
+				return PointLightRecord{ pl.Color, pl.Intensity, pl.Radius, pl.Falloff };
+			});
+
+		AddComponentBlock<RigidbodyComponent, RigidbodyRecord>(registry, writer, SceneBlockType::Rigidbody, [](const RigidbodyComponent& rb)
+			{
+				return RigidbodyRecord{ (int32_t)rb.Type, rb.Mass, rb.LinearDrag, rb.AngularDrag, rb.FixedRotation, rb.UseCCD, rb.CCDVelocityThreshold };
+			});
+
+		AddComponentBlock<RigidbodyComponent, RigidbodyLayerRecord>(registry, writer, SceneBlockType::RigidbodyLayer, [](const RigidbodyComponent& rb)
+			{
+				return RigidbodyLayerRecord{ rb.Layer };
+			});
+
+		AddComponentBlock<BoxColliderComponent, BoxColliderRecord>(registry, writer, SceneBlockType::BoxCollider, [](const BoxColliderComponent& bc)
+			{
+				return BoxColliderRecord{ bc.HalfExtents, bc.Offset, bc.StaticFriction, bc.DynamicFriction, bc.Restitution, bc.IsTrigger };
+			});
+
+		AddComponentBlock<SphereColliderComponent, SphereColliderRecord>(registry, writer, SceneBlockType::SphereCollider, [](const SphereColliderComponent& sc)
+			{
+				return SphereColliderRecord{ sc.Radius, sc.Offset, sc.StaticFriction, sc.DynamicFriction, sc.Restitution, sc.IsTrigger };
+			});
+
+		AddComponentBlock<CapsuleColliderComponent, CapsuleColliderRecord>(registry, writer, SceneBlockType::CapsuleCollider, [](const CapsuleColliderComponent& cc)
+			{
+				return CapsuleColliderRecord{ cc.Radius, cc.Height, cc.Offset, cc.StaticFriction, cc.DynamicFriction, cc.Restitution, cc.IsTrigger };
+			});
+
+		AddComponentBlock<ScriptComponent, ScriptRecord>(registry, writer, SceneBlockType::Script, [&](const ScriptComponent& sc)
+			{
+				return ScriptRecord{ writer.AddString(sc.ClassName) };
+			});
+
+		if (!writer.Write(filepath, header))
+			RXN_CORE_ERROR("Failed to write binary scene: {0}", filepath);
+	}
+
+	bool SceneSerializer::IsBinary(const std::string& filepath)
+	{
+		std::ifstream in(filepath, std::ios::binary);
+		char magic[4] = {};
+		if (!in.read(magic, sizeof(magic)))
+			return false;
+
+		return memcmp(magic, s_BinarySceneMagic, sizeof(magic)) == 0;
+	}
+
+	bool SceneSerializer::DeserializeBinary(const std::string& filepath)
+	{
+		OPTICK_EVENT();
+
+		std::ifstream in(filepath, std::ios::binary | std::ios::ate);
+		if (!in.is_open())
+		{
+			RXN_CORE_ERROR("Failed to open binary scene '{0}'", filepath);
+			return false;
+		}
+
+		// Read as 64 bit words so every block, which the writer pads to 8 bytes, can be used in place
+		uint64_t fileSize = (uint64_t)in.tellg();
+		std::vector<uint64_t> storage((fileSize + 7) / 8);
+		in.seekg(0);
+		in.read((char*)storage.data(), fileSize);
+
+		const uint8_t* data = (const uint8_t*)storage.data();
+		const BinarySceneHeader* header = (const BinarySceneHeader*)data;
+		if (!in || fileSize < sizeof(BinarySceneHeader) || memcmp(header->Magic, s_BinarySceneMagic, sizeof(header->Magic)) != 0)
+		{
+			RXN_CORE_ERROR("'{0}' is not a binary scene", filepath);
+			return false;
+		}
+
+		if (header->Version > s_BinarySceneVersion)
+		{
+			RXN_CORE_ERROR("Binary scene '{0}' is version {1}, newer than this build supports ({2})", filepath, header->Version, s_BinarySceneVersion);
+			return false;
+		}
+
+		BinarySceneBlockView blocks[(uint32_t)SceneBlockType::Count];
+		uint64_t offset = sizeof(BinarySceneHeader);
+		for (uint32_t i = 0; i < header->BlockCount; i++)
+		{
+			if (offset + sizeof(BinarySceneBlock) > fileSize)
+				break;
+
+			const BinarySceneBlock* block = (const BinarySceneBlock*)(data + offset);
+			offset += sizeof(BinarySceneBlock);
+
+			if (offset + block->Size > fileSize)
+			{
+				RXN_CORE_ERROR("Binary scene '{0}' is truncated", filepath);
+				return false;
+			}
+
+			const uint8_t* payload = data + offset;
+			offset += block->Size;
+
+			// Unknown or newer blocks are skipped, the rest of the scene still loads
+			SceneBlockType type = (SceneBlockType)block->Type;
+			if (block->Type >= (uint32_t)SceneBlockType::Count || block->Version > s_BinaryBlockVersion || block->RecordSize != GetRecordSize(type))
+			{
+				RXN_CORE_WARN("Skipping unsupported block {0} (version {1}) in binary scene '{2}'", block->Type, block->Version, filepath);
+				continue;
+			}
+
+			uint64_t keySize = IsKeyedBlock(type) ? AlignBlock((uint64_t)block->Count * sizeof(uint64_t)) : 0;
+			if (keySize + (uint64_t)block->Count * block->RecordSize > block->Size)
+			{
+				RXN_CORE_ERROR("Binary scene '{0}' has a malformed block {1}", filepath, block->Type);
+				return false;
+			}
+
+			BinarySceneBlockView& view = blocks[block->Type];
+			view.Keys = keySize ? (const uint64_t*)payload : nullptr;
+			view.Records = payload + keySize;
+			view.Count = block->Count;
+		}
+
+		const BinarySceneBlockView& strings = blocks[(uint32_t)SceneBlockType::Strings];
+		auto getString = [&](BinaryStringRef ref)
+			{
+				if ((uint64_t)ref.Offset + ref.Length > strings.Count)
+					return std::string();
+				return std::string((const char*)strings.Records + ref.Offset, ref.Length);
+			};
+
+		const BinarySceneBlockView& children = blocks[(uint32_t)SceneBlockType::Children];
+
+		if (header->SkyboxPath.Length > 0)
+			m_Scene->m_Skybox = Cubemap::Create(getString(header->SkyboxPath));
+		m_Scene->m_SkyboxIntensity = header->SkyboxIntensity;
+
+		entt::registry& registry = m_Scene->m_Registry;
+
+		const BinarySceneBlockView& entityBlock = blocks[(uint32_t)SceneBlockType::Entities];
+		uint32_t entityCount = entityBlock.Count;
+
+		std::vector<entt::entity> handles(entityCount);
+		registry.create(handles.begin(), handles.end());
+
+		std::unordered_map<uint64_t, uint32_t> indices;
+		indices.reserve(entityCount);
+		m_Scene->m_EntityMap.reserve(m_Scene->m_EntityMap.size() + entityCount);
+
+		// Every entity gets the components CreateEntityWithUUID() would add, filled from their blocks and inserted in bulk
+		std::vector<IDComponent> ids;
+		std::vector<TagComponent> tags;
+		ids.reserve(entityCount);
+		tags.reserve(entityCount);
+
+		const EntityRecord* entityRecords = entityBlock.As<EntityRecord>();
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			UUID uuid = entityBlock.Keys[i];
+			std::string tag = getString(entityRecords[i].Tag);
+
+			ids.emplace_back(uuid);
+			tags.emplace_back(tag.empty() ? "Entity" : tag);
+
+			indices[uuid] = i;
+			m_Scene->m_EntityMap[uuid] = handles[i];
+		}
+
+		std::vector<TransformComponent> transforms(entityCount);
+		ForEachRecord<TransformRecord>(blocks[(uint32_t)SceneBlockType::Transform], indices, [&](uint32_t index, const TransformRecord& record)
+			{
+				transforms[index].Translation = record.Translation;
+				transforms[index].Rotation = record.Rotation;
+				transforms[index].Scale = record.Scale;
+			});
+
+		std::vector<RelationshipComponent> relationships(entityCount);
+		ForEachRecord<RelationshipRecord>(blocks[(uint32_t)SceneBlockType::Relationship], indices, [&](uint32_t index, const RelationshipRecord& record)
+			{
+				RelationshipComponent& rc = relationships[index];
+				rc.ParentHandle = record.ParentHandle;
+
+				if ((uint64_t)record.FirstChild + record.ChildCount > children.Count)
+					return;
+
+				const uint64_t* childIDs = children.As<uint64_t>() + record.FirstChild;
+				rc.Children.assign(childIDs, childIDs + record.ChildCount);
+			});
+
+		registry.insert<IDComponent>(handles.begin(), handles.end(), ids.begin());
+		registry.insert<TransformComponent>(handles.begin(), handles.end(), transforms.begin());
+		registry.insert<RelationshipComponent>(handles.begin(), handles.end(), relationships.begin());
+		registry.insert<TagComponent>(handles.begin(), handles.end(), tags.begin());
+
+		InsertComponents<CameraComponent, CameraRecord>(registry, blocks[(uint32_t)SceneBlockType::Camera], handles, indices, [](CameraComponent& cc, const CameraRecord& record)
+			{
+				cc.Camera.SetProjectionType((SceneCamera::ProjectionMode)record.ProjectionType);
+				cc.Camera.SetPerspectiveFOV(record.PerspectiveFOV);
+				cc.Camera.SetPerspectiveNearClip(record.PerspectiveNear);
+				cc.Camera.SetPerspectiveFarClip(record.PerspectiveFar);
+				cc.Camera.SetOrthographicSize(record.OrthographicSize);
+				cc.Camera.SetOrthographicNearClip(record.OrthographicNear);
+				cc.Camera.SetOrthographicFarClip(record.OrthographicFar);
+				cc.FixedAspectRatio = record.FixedAspectRatio != 0;
+			});
+
+		// Levels reuse a handful of meshes across thousands of entities, resolve each path once
+		std::unordered_map<std::string, Ref<StaticMesh>> meshes;
+		InsertComponents<StaticMeshComponent, StaticMeshRecord>(registry, blocks[(uint32_t)SceneBlockType::StaticMesh], handles, indices, [&](StaticMeshComponent& mc, const StaticMeshRecord& record)
+			{
+				mc.AssetPath = getString(record.AssetPath);
+				mc.SubmeshIndex = record.SubmeshIndex;
+
+				if (mc.AssetPath.empty())
+					return;
+
+				auto [it, inserted] = meshes.try_emplace(mc.AssetPath);
+				if (inserted)
+					it->second = AssetManager::GetMesh(mc.AssetPath);
+				mc.Mesh = it->second;
+			});
+
+		InsertComponents<DirectionalLightComponent, DirectionalLightRecord>(registry, blocks[(uint32_t)SceneBlockType::DirectionalLight], handles, indices, [](DirectionalLightComponent& dl, const DirectionalLightRecord& record)
+			{
+				dl.Color = record.Color;
+				dl.Intensity = record.Intensity;
+			});
+
+		InsertComponents<PointLightComponent, PointLightRecord>(registry, blocks[(uint32_t)SceneBlockType::PointLight], handles, indices, [](PointLightComponent& pl, const PointLightRecord& record)
+			{
+				pl.Color = record.Color;
+				pl.Intensity = record.Intensity;
+				pl.Radius = record.Radius;
+				pl.Falloff = record.Falloff;
+			});
+
+		InsertComponents<RigidbodyComponent, RigidbodyRecord>(registry, blocks[(uint32_t)SceneBlockType::Rigidbody], handles, indices, [](RigidbodyComponent& rb, const RigidbodyRecord& record)
+			{
+				rb.Type = (RigidbodyComponent::BodyType)record.Type;
+				rb.Mass = record.Mass;
+				rb.LinearDrag = record.LinearDrag;
+				rb.AngularDrag = record.AngularDrag;
+				rb.FixedRotation = record.FixedRotation != 0;
+				rb.UseCCD = record.UseCCD != 0;
+				rb.CCDVelocityThreshold = record.CCDVelocityThreshold;
+			});
+
+		ForEachRecord<RigidbodyLayerRecord>(blocks[(uint32_t)SceneBlockType::RigidbodyLayer], indices, [&](uint32_t index, const RigidbodyLayerRecord& record)
+			{
+				if (auto* rb = registry.try_get<RigidbodyComponent>(handles[index]))
+					rb->Layer = record.Layer;
+			});
+
+		InsertComponents<BoxColliderComponent, BoxColliderRecord>(registry, blocks[(uint32_t)SceneBlockType::BoxCollider], handles, indices, [](BoxColliderComponent& bc, const BoxColliderRecord& record)
+			{
+				bc.HalfExtents = record.HalfExtents;
+				bc.Offset = record.Offset;
+				bc.StaticFriction = record.StaticFriction;
+				bc.DynamicFriction = record.DynamicFriction;
+				bc.Restitution = record.Restitution;
+				bc.IsTrigger = record.IsTrigger != 0;
+			});
+
+		InsertComponents<SphereColliderComponent, SphereColliderRecord>(registry, blocks[(uint32_t)SceneBlockType::SphereCollider], handles, indices, [](SphereColliderComponent& sc, const SphereColliderRecord& record)
+			{
+				sc.Radius = record.Radius;
+				sc.Offset = record.Offset;
+				sc.StaticFriction = record.StaticFriction;
+				sc.DynamicFriction = record.DynamicFriction;
+				sc.Restitution = record.Restitution;
+				sc.IsTrigger = record.IsTrigger != 0;
+			});
+
+		InsertComponents<CapsuleColliderComponent, CapsuleColliderRecord>(registry, blocks[(uint32_t)SceneBlockType::CapsuleCollider], handles, indices, [](CapsuleColliderComponent& cc, const CapsuleColliderRecord& record)
+			{
+				cc.Radius = record.Radius;
+				cc.Height = record.Height;
+				cc.Offset = record.Offset;
+				cc.StaticFriction = record.StaticFriction;
+				cc.DynamicFriction = record.DynamicFriction;
+				cc.Restitution = record.Restitution;
+				cc.IsTrigger = record.IsTrigger != 0;
+			});
+
+		InsertComponents<ScriptComponent, ScriptRecord>(registry, blocks[(uint32_t)SceneBlockType::Script], handles, indices, [&](ScriptComponent& sc, const ScriptRecord& record)
+			{
+				sc.ClassName = getString(record.ClassName);
+			});
+
+		if (header->PrimaryCameraID != (uint64_t)UUID::Null)
+		{
+			auto it = indices.find(header->PrimaryCameraID);
+			if (it != indices.end())
+				m_Scene->SetPrimaryCameraEntity({ handles[it->second], m_Scene.get() });
+		}
+
+		RXN_CORE_TRACE("Deserialized binary scene '{0}' with {1} entities", filepath, entityCount);
+		return true;
+	}
+
 }
\ No newline at end of file
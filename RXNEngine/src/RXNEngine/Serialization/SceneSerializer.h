@@ -12,8 +12,15 @@ namespace RXNEngine {
 		void Serialize(const std::string& filepath);
 		void SerializeRuntime(const std::string& filepath);
 
+		// Binary scenes (.rxsb) hold each component type as one contiguous block keyed by UUID, a load is a single
+		// read followed by one bulk insert per component type. Deserialize() accepts either format
+		void SerializeBinary(const std::string& filepath);
+
 		bool Deserialize(const std::string& filepath);
 		bool DeserializeRuntime(const std::string& filepath);
+		bool DeserializeBinary(const std::string& filepath);
+
+		static bool IsBinary(const std::string& filepath);
 	private:
 		Ref<Scene> m_Scene;
 	};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RXNEngine/Core/Base.h"
+
 #include <string>
 
 namespace RXNEngine {
@@ -10,4 +12,25 @@ namespace RXNEngine {
 		static std::string OpenFile(const char* filter);
 		static std::string SaveFile(const char* filter);
 	};
+
+	// Read-only mapping of a whole file, pages are faulted in by the OS on first access and shared with the file cache
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::string& filepath);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool IsValid() const { return m_Data != nullptr; }
+
+		const uint8_t* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+	private:
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+		const uint8_t* m_Data = nullptr;
+		uint64_t m_Size = 0;
+	};
 }
\ No newline at end of file
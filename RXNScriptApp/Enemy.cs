@@ -12,7 +12,7 @@ namespace RXNScriptApp
     {
         public float m_Pitch = 0.0f;
 
-        private IEnumerator AttackPattern()
+        private IEnumerator<Wait> AttackPattern()
         {
             while (true)
             {
@@ -34,6 +34,12 @@ namespace RXNScriptApp
             StartCoroutine(AttackPattern());
         }
 
+        // m_Pitch was carried over, only the coroutine has to be restarted
+        public override void OnAfterReload()
+        {
+            StartCoroutine(AttackPattern());
+        }
+
         public override void OnUpdate(float deltaTime)
         {
             m_Pitch = Math.Clamp(m_Pitch, -1.5f, 1.5f);
@@ -193,7 +193,7 @@ public class Player : Entity
         }
     }
 
-    private System.Collections.IEnumerator FireWeaponRoutine(Vector3 startPos)
+    private System.Collections.Generic.IEnumerator<Wait> FireWeaponRoutine(Vector3 startPos)
     {
         Entity firedBullet = Entity.Instantiate(BulletPrefab!);
         firedBullet.Translation = startPos + (HeadCamera!.Forward * 1.5f) + SpawnOffset;
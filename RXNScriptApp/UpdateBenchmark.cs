@@ -0,0 +1,12 @@
+﻿using RXNEngine;
+
+// Near-empty update used by the editor's script update benchmark to measure dispatch cost
+public class UpdateBenchmark : Entity
+{
+    private float m_Elapsed;
+
+    public override void OnUpdate(float deltaTime)
+    {
+        m_Elapsed += deltaTime;
+    }
+}
@@ -38,6 +38,7 @@ namespace RXNEngine
         public bool FixedRotation;
         public bool UseCCD;
         public float CCDVelocityThreshold;
+        public uint Layer;
 
         internal IntPtr RuntimeActor;
     }
@@ -0,0 +1,91 @@
+﻿using RXNScriptHost;
+using System.Runtime.InteropServices;
+
+namespace RXNEngine
+{
+    [Flags]
+    public enum ViewFields : byte
+    {
+        None = 0,
+        Translation = 1 << 0,
+        Rotation = 1 << 1,
+        Scale = 1 << 2,
+        LinearVelocity = 1 << 3
+    }
+
+    // Packed copies of the transform and velocity of every scripted entity, indexed by Entity.ViewIndex. They are
+    // refreshed from the scene right before each OnUpdate/OnFixedUpdate pass and the fields marked dirty are written
+    // back right after it, so a span is only valid inside those callbacks and writes show up in the scene next pass
+    public static unsafe class ComponentViews
+    {
+        // Mirrors ScriptComponentViewBuffers in ScriptComponentViews.h
+        [StructLayout(LayoutKind.Sequential)]
+        private struct Buffers
+        {
+            public Vector3* Translation;
+            public Vector3* Rotation;
+            public Vector3* Scale;
+            public System.Numerics.Matrix4x4* WorldTransform;
+            public Vector3* LinearVelocity;
+            public byte* Dirty;
+            public int Capacity;
+        }
+
+        private static Buffers* s_Buffers = null;
+
+        // The struct lives in native code for the whole session, only the arrays it points to can move between passes
+        private static Buffers* Views
+        {
+            get
+            {
+                if (s_Buffers == null)
+                    s_Buffers = ((delegate* unmanaged<Buffers*>)Interop.NativeFunctions.ScriptViews_GetBuffers)();
+                return s_Buffers;
+            }
+        }
+
+        public static int Capacity => Views->Capacity;
+
+        public static Span<Vector3> Translations => new Span<Vector3>(Views->Translation, Views->Capacity);
+        public static Span<Vector3> Rotations => new Span<Vector3>(Views->Rotation, Views->Capacity);
+        public static Span<Vector3> Scales => new Span<Vector3>(Views->Scale, Views->Capacity);
+        public static Span<Vector3> LinearVelocities => new Span<Vector3>(Views->LinearVelocity, Views->Capacity);
+
+        // As of the last transform update, writes to the other views aren't reflected until the scene rebuilds them.
+        // Same memory layout as glm, the translation is in M41-M43
+        public static ReadOnlySpan<System.Numerics.Matrix4x4> WorldTransforms => new ReadOnlySpan<System.Numerics.Matrix4x4>(Views->WorldTransform, Views->Capacity);
+
+        // Writes through the spans are only applied to the scene for fields marked here
+        public static void MarkDirty(int index, ViewFields fields)
+        {
+            if ((uint)index >= (uint)Views->Capacity)
+                throw new ArgumentOutOfRangeException(nameof(index));
+
+            Views->Dirty[index] |= (byte)fields;
+        }
+
+        public static void SetTranslation(int index, Vector3 translation)
+        {
+            Translations[index] = translation;
+            MarkDirty(index, ViewFields.Translation);
+        }
+
+        public static void SetRotation(int index, Vector3 rotation)
+        {
+            Rotations[index] = rotation;
+            MarkDirty(index, ViewFields.Rotation);
+        }
+
+        public static void SetScale(int index, Vector3 scale)
+        {
+            Scales[index] = scale;
+            MarkDirty(index, ViewFields.Scale);
+        }
+
+        public static void SetLinearVelocity(int index, Vector3 velocity)
+        {
+            LinearVelocities[index] = velocity;
+            MarkDirty(index, ViewFields.LinearVelocity);
+        }
+    }
+}
@@ -3,44 +3,392 @@ using System.Collections.Generic;
 
 namespace RXNEngine
 {
-    public abstract class YieldInstruction { }
+    internal enum WaitKind : byte
+    {
+        NextFrame,
+        Seconds,
+        Frames,
+        Until,
+        Physics
+    }
+
+    // What an IEnumerator<Wait> coroutine yields. It's a struct so typed coroutines wait without allocating, the
+    // WaitFor* structs convert to it implicitly
+    public readonly struct Wait
+    {
+        internal readonly WaitKind Kind;
+        internal readonly float Seconds;
+        internal readonly int Frames;
+        internal readonly Func<bool>? Condition;
+
+        private Wait(WaitKind kind, float seconds = 0.0f, int frames = 0, Func<bool>? condition = null)
+        {
+            Kind = kind;
+            Seconds = seconds;
+            Frames = frames;
+            Condition = condition;
+        }
+
+        public static Wait NextFrame => default;
+        public static Wait ForPhysics => new Wait(WaitKind.Physics);
+
+        public static Wait ForSeconds(float seconds) => new Wait(WaitKind.Seconds, seconds: seconds);
+        public static Wait ForFrames(int frames) => new Wait(WaitKind.Frames, frames: frames);
+        public static Wait Until(Func<bool> condition) => new Wait(WaitKind.Until, condition: condition);
+    }
+
+    public readonly struct WaitForSeconds
+    {
+        public readonly float Seconds;
+        public WaitForSeconds(float seconds) { Seconds = seconds; }
+
+        public static implicit operator Wait(WaitForSeconds wait) => Wait.ForSeconds(wait.Seconds);
+    }
+
+    public readonly struct WaitForFrames
+    {
+        public readonly int Frames;
+        public WaitForFrames(int frames) { Frames = frames; }
+
+        public static implicit operator Wait(WaitForFrames wait) => Wait.ForFrames(wait.Frames);
+    }
+
+    // The condition is polled once per frame
+    public readonly struct WaitUntil
+    {
+        public readonly Func<bool> Condition;
+        public WaitUntil(Func<bool> condition) { Condition = condition; }
+
+        public static implicit operator Wait(WaitUntil wait) => Wait.Until(wait.Condition);
+    }
 
-    public class WaitForSeconds : YieldInstruction
+    // Resumes after the next fixed update
+    public readonly struct WaitForPhysics
     {
-        public float TimeLeft;
-        public WaitForSeconds(float time) { TimeLeft = time; }
+        public static implicit operator Wait(WaitForPhysics wait) => Wait.ForPhysics;
     }
 
-    public class CoroutineRunner
+    // Handle to a running coroutine, stale once it finishes or is stopped
+    public readonly struct Coroutine
     {
-        private List<IEnumerator> _activeCoroutines = new List<IEnumerator>();
+        internal readonly int Index;
+        internal readonly int Generation;
+
+        internal Coroutine(int index, int generation)
+        {
+            Index = index;
+            Generation = generation;
+        }
+    }
+
+    // One scheduler for every script. Coroutines live in a pooled array, sleeping ones sit in min-heaps keyed on their
+    // wake time or frame and cost nothing until they're due. Stopped coroutines are left in the queues and skipped by
+    // generation when they come up. Steps run on the main thread once per frame, after the script updates
+    public static class CoroutineScheduler
+    {
+        private enum State : byte
+        {
+            Free,
+            Ready,
+            Sleeping,
+            Polling,
+            Physics
+        }
 
-        public void StartCoroutine(IEnumerator routine)
+        private struct Routine
         {
-            _activeCoroutines.Add(routine);
+            public IEnumerator? Enumerator;
+            // Same object as Enumerator for typed coroutines, reading Current through it doesn't box
+            public IEnumerator<Wait>? Typed;
+            public Func<bool>? Condition;
+            public ulong Owner;
+            public int Generation;
+            public State State;
+
+            // Intrusive list of the owner's coroutines, so destroying an entity doesn't scan every routine
+            public int PrevOfOwner;
+            public int NextOfOwner;
+        }
+
+        private static readonly object s_Lock = new();
+
+        private static Routine[] s_Routines = new Routine[256];
+        private static int s_RoutineCount = 0;
+        private static readonly Stack<int> s_FreeRoutines = new();
+        private static readonly Dictionary<ulong, int> s_OwnerHeads = new();
+
+        private static List<Coroutine> s_Ready = new();
+        private static List<Coroutine> s_Running = new();
+        private static readonly List<Coroutine> s_Polling = new();
+        private static List<Coroutine> s_Physics = new();
+        private static readonly PriorityQueue<Coroutine, double> s_Timers = new();
+        private static readonly PriorityQueue<Coroutine, long> s_FrameTimers = new();
+
+        private static double s_Time = 0.0;
+        private static long s_Frame = 0;
+
+        public static int ActiveCount { get; private set; }
+        // Waiting on time, frames, a condition or physics rather than just the next frame
+        public static int SleepingCount { get; private set; }
+
+        internal static Coroutine Start(ulong owner, IEnumerator routine)
+        {
+            lock (s_Lock)
+            {
+                if (!s_FreeRoutines.TryPop(out int index))
+                {
+                    if (s_RoutineCount == s_Routines.Length)
+                        Array.Resize(ref s_Routines, s_Routines.Length * 2);
+                    index = s_RoutineCount++;
+                }
+
+                ref Routine r = ref s_Routines[index];
+                r.Enumerator = routine;
+                r.Typed = routine as IEnumerator<Wait>;
+                r.Condition = null;
+                r.Owner = owner;
+                r.State = State.Ready;
+                // Generation 0 is never live, a default Coroutine handle doesn't stop anything
+                if (r.Generation == 0)
+                    r.Generation = 1;
+
+                r.PrevOfOwner = -1;
+                r.NextOfOwner = s_OwnerHeads.TryGetValue(owner, out int head) ? head : -1;
+                if (r.NextOfOwner >= 0)
+                    s_Routines[r.NextOfOwner].PrevOfOwner = index;
+                s_OwnerHeads[owner] = index;
+
+                ActiveCount++;
+
+                var handle = new Coroutine(index, r.Generation);
+                s_Ready.Add(handle);
+                return handle;
+            }
         }
 
-        public void Update()
+        internal static void Stop(Coroutine coroutine)
         {
-            for (int i = _activeCoroutines.Count - 1; i >= 0; i--)
+            lock (s_Lock)
             {
-                IEnumerator routine = _activeCoroutines[i];
+                if (IsValid(coroutine))
+                    Free(coroutine.Index);
+            }
+        }
 
-                if (routine.Current is WaitForSeconds waitTimer)
+        internal static void StopAll(ulong owner)
+        {
+            lock (s_Lock)
+            {
+                while (s_OwnerHeads.TryGetValue(owner, out int head))
+                    Free(head);
+            }
+        }
+
+        internal static void Clear()
+        {
+            lock (s_Lock)
+            {
+                Array.Clear(s_Routines);
+                s_RoutineCount = 0;
+                s_FreeRoutines.Clear();
+                s_OwnerHeads.Clear();
+
+                s_Ready.Clear();
+                s_Running.Clear();
+                s_Polling.Clear();
+                s_Physics.Clear();
+                s_Timers.Clear();
+                s_FrameTimers.Clear();
+
+                ActiveCount = 0;
+                SleepingCount = 0;
+            }
+        }
+
+        internal static void Update()
+        {
+            lock (s_Lock)
+            {
+                s_Time += Time.DeltaTime;
+                s_Frame++;
+
+                // Everything due is collected before any of it runs, a zero wait resumes next frame rather than looping
+                (s_Ready, s_Running) = (s_Running, s_Ready);
+
+                while (s_Timers.TryPeek(out _, out double wakeTime) && wakeTime <= s_Time)
+                    Wake(s_Timers.Dequeue());
+
+                while (s_FrameTimers.TryPeek(out _, out long wakeFrame) && wakeFrame <= s_Frame)
+                    Wake(s_FrameTimers.Dequeue());
+
+                int polling = 0;
+                for (int i = 0; i < s_Polling.Count; i++)
                 {
-                    waitTimer.TimeLeft -= Time.DeltaTime;
+                    Coroutine coroutine = s_Polling[i];
+                    if (!IsValid(coroutine))
+                        continue;
+
+                    if (s_Routines[coroutine.Index].Condition!())
+                        Wake(coroutine);
+                    else
+                        s_Polling[polling++] = coroutine;
+                }
+                s_Polling.RemoveRange(polling, s_Polling.Count - polling);
+
+                RunAll();
+            }
+        }
+
+        internal static void FixedUpdate()
+        {
+            lock (s_Lock)
+            {
+                if (s_Physics.Count == 0)
+                    return;
 
-                    if (waitTimer.TimeLeft > 0.0f)
+                (s_Physics, s_Running) = (s_Running, s_Physics);
+                foreach (Coroutine coroutine in s_Running)
+                {
+                    if (!IsValid(coroutine))
                         continue;
+
+                    SleepingCount--;
+                    s_Routines[coroutine.Index].State = State.Ready;
                 }
 
-                bool isFinished = !routine.MoveNext();
+                RunAll();
+            }
+        }
+
+        private static bool IsValid(Coroutine coroutine)
+        {
+            return (uint)coroutine.Index < (uint)s_RoutineCount
+                && s_Routines[coroutine.Index].State != State.Free
+                && s_Routines[coroutine.Index].Generation == coroutine.Generation;
+        }
 
-                if (isFinished)
+        private static void Wake(Coroutine coroutine)
+        {
+            if (!IsValid(coroutine))
+                return;
+
+            SleepingCount--;
+            s_Routines[coroutine.Index].State = State.Ready;
+            s_Running.Add(coroutine);
+        }
+
+        private static void RunAll()
+        {
+            // A step can stop coroutines further down the list, so each is checked as it comes up
+            for (int i = 0; i < s_Running.Count; i++)
+            {
+                if (IsValid(s_Running[i]))
+                    Step(s_Running[i]);
+            }
+            s_Running.Clear();
+        }
+
+        private static void Step(Coroutine coroutine)
+        {
+            int index = coroutine.Index;
+
+            Wait wait;
+            try
+            {
+                if (!s_Routines[index].Enumerator!.MoveNext())
                 {
-                    _activeCoroutines.RemoveAt(i);
+                    Free(index);
+                    return;
                 }
+
+                // The step may have stopped its own coroutine
+                if (!IsValid(coroutine))
+                    return;
+
+                wait = s_Routines[index].Typed != null ? s_Routines[index].Typed!.Current : ToWait(s_Routines[index].Enumerator!.Current);
             }
+            catch (Exception e)
+            {
+                Console.WriteLine($"[.NET Host] Coroutine on entity {s_Routines[index].Owner} threw: {e}");
+                if (IsValid(coroutine))
+                    Free(index);
+                return;
+            }
+
+            Schedule(coroutine, wait);
+        }
+
+        // Untyped coroutines box what they yield, the legacy WaitForSeconds included
+        private static Wait ToWait(object? current)
+        {
+            return current switch
+            {
+                Wait wait => wait,
+                WaitForSeconds wait => wait,
+                WaitForFrames wait => wait,
+                WaitUntil wait => wait,
+                WaitForPhysics wait => wait,
+                _ => Wait.NextFrame
+            };
+        }
+
+        private static void Schedule(Coroutine coroutine, Wait wait)
+        {
+            ref Routine r = ref s_Routines[coroutine.Index];
+
+            switch (wait.Kind)
+            {
+                case WaitKind.Seconds when wait.Seconds > 0.0f:
+                    r.State = State.Sleeping;
+                    s_Timers.Enqueue(coroutine, s_Time + wait.Seconds);
+                    break;
+                case WaitKind.Frames when wait.Frames > 1:
+                    r.State = State.Sleeping;
+                    s_FrameTimers.Enqueue(coroutine, s_Frame + wait.Frames);
+                    break;
+                case WaitKind.Until when wait.Condition != null:
+                    r.State = State.Polling;
+                    r.Condition = wait.Condition;
+                    s_Polling.Add(coroutine);
+                    break;
+                case WaitKind.Physics:
+                    r.State = State.Physics;
+                    s_Physics.Add(coroutine);
+                    break;
+                default:
+                    r.State = State.Ready;
+                    s_Ready.Add(coroutine);
+                    return;
+            }
+
+            SleepingCount++;
+        }
+
+        private static void Free(int index)
+        {
+            ref Routine r = ref s_Routines[index];
+
+            if (r.State != State.Ready)
+                SleepingCount--;
+            ActiveCount--;
+
+            if (r.PrevOfOwner >= 0)
+                s_Routines[r.PrevOfOwner].NextOfOwner = r.NextOfOwner;
+            else if (r.NextOfOwner >= 0)
+                s_OwnerHeads[r.Owner] = r.NextOfOwner;
+            else
+                s_OwnerHeads.Remove(r.Owner);
+
+            if (r.NextOfOwner >= 0)
+                s_Routines[r.NextOfOwner].PrevOfOwner = r.PrevOfOwner;
+
+            r.Enumerator = null;
+            r.Typed = null;
+            r.Condition = null;
+            r.State = State.Free;
+            r.Generation++;
+
+            s_FreeRoutines.Push(index);
         }
     }
-}
\ No newline at end of file
+}
@@ -9,11 +9,12 @@ namespace RXNEngine
     {
         public ulong ID { get; internal set; }
 
+        // Index into ComponentViews, -1 for entities that aren't running a script
+        public int ViewIndex { get; internal set; } = -1;
+
         protected Entity() { ID = 0; }
         internal Entity(ulong id) { ID = id; }
 
-        private CoroutineRunner _coroutineRunner = new CoroutineRunner();
-
         #region Lifecycle & Instantiation
         public static Entity Instantiate()
         {
@@ -41,16 +42,11 @@ namespace RXNEngine
             }
         }
 
-        protected void StartCoroutine(IEnumerator routine)
-        {
-            _coroutineRunner.StartCoroutine(routine);
-        }
+        // Declare the routine as IEnumerator<Wait> to wait without allocating, a plain IEnumerator boxes what it yields
+        protected Coroutine StartCoroutine(IEnumerator routine) => CoroutineScheduler.Start(ID, routine);
 
-        internal void InternalUpdate()
-        {
-            _coroutineRunner.Update();
-            OnUpdate(Time.DeltaTime);
-        }
+        protected void StopCoroutine(Coroutine coroutine) => CoroutineScheduler.Stop(coroutine);
+        protected void StopAllCoroutines() => CoroutineScheduler.StopAll(ID);
         #endregion
 
         #region Virtual Callbacks
@@ -60,8 +56,14 @@ namespace RXNEngine
         public virtual void OnFixedUpdate(float deltaTime) { }
         public virtual void OnCollisionEnter(Entity other) { }
         public virtual void OnCollisionExit(Entity other) { }
+        // Override these instead to get the contact point and impulse
+        public virtual void OnCollisionEnter(Collision collision) => OnCollisionEnter(collision.Other);
+        public virtual void OnCollisionExit(Collision collision) => OnCollisionExit(collision.Other);
         public virtual void OnTriggerEnter(Entity other) { }
         public virtual void OnTriggerExit(Entity other) { }
+        // Runs instead of OnCreate when a hot reload recreates the script, after its public fields were restored.
+        // Private fields start over and coroutines are gone, rebuild them here
+        public virtual void OnAfterReload() { }
         #endregion
 
         #region Transform Properties
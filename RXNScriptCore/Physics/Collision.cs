@@ -0,0 +1,33 @@
+﻿using RXNScriptHost;
+
+namespace RXNEngine
+{
+    // A contact reported by the last physics step, seen from the entity receiving it
+    public readonly struct Collision
+    {
+        public Entity Other { get; }
+        // Average of the contact points, in world space
+        public Vector3 Point { get; }
+        // Points away from Other
+        public Vector3 Normal { get; }
+        // Impulse this entity received from the contact over the step
+        public Vector3 Impulse { get; }
+
+        internal Collision(Entity other, Vector3 point, Vector3 normal, Vector3 impulse)
+        {
+            Other = other;
+            Point = point;
+            Normal = normal;
+            Impulse = impulse;
+        }
+
+        internal static unsafe Collision FromEvent(IntPtr contactEvent)
+        {
+            ContactEvent* e = (ContactEvent*)contactEvent;
+            return new Collision(new Entity(e->OtherID),
+                new Vector3(e->Point.X, e->Point.Y, e->Point.Z),
+                new Vector3(e->Normal.X, e->Normal.Y, e->Normal.Z),
+                new Vector3(e->Impulse.X, e->Impulse.Y, e->Impulse.Z));
+        }
+    }
+}
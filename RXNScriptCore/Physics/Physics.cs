@@ -13,21 +13,100 @@ namespace RXNEngine
         public float Distance;
     }
 
+    public enum QueryShape : uint { Ray = 0, Sphere, Box, Capsule }
+
+    // Mirrors PhysicsQuery in PhysicsSystem.h. Size is the radius for spheres, the half extents for boxes and radius and
+    // half height for capsules. Rotation is a quaternion (x, y, z, w), all zero means identity
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PhysicsQuery
+    {
+        public Vector3 Origin;
+        public float MaxDistance;
+        public Vector3 Direction;
+        public uint LayerMask;
+        public Vector4 Rotation;
+        public Vector3 Size;
+        public QueryShape Shape;
+        public ulong IgnoreEntityID;
+        // 1 returns the closest blocking hit, more returns every hit up to this many sorted by distance
+        public uint MaxHits;
+        private uint _padding;
+
+        public static PhysicsQuery Ray(Vector3 origin, Vector3 direction, float maxDistance, uint layerMask = Physics.AllLayers, uint maxHits = 1, Entity? ignoreEntity = null)
+        {
+            return new PhysicsQuery { Origin = origin, Direction = direction, MaxDistance = maxDistance, LayerMask = layerMask, MaxHits = maxHits, IgnoreEntityID = ignoreEntity?.ID ?? 0 };
+        }
+
+        public static PhysicsQuery Sphere(Vector3 origin, float radius, Vector3 direction = default, float maxDistance = 0.0f, uint layerMask = Physics.AllLayers, uint maxHits = 1, Entity? ignoreEntity = null)
+        {
+            return new PhysicsQuery { Shape = QueryShape.Sphere, Origin = origin, Size = new Vector3(radius, 0.0f, 0.0f), Direction = direction, MaxDistance = maxDistance, LayerMask = layerMask, MaxHits = maxHits, IgnoreEntityID = ignoreEntity?.ID ?? 0 };
+        }
+
+        public static PhysicsQuery Box(Vector3 origin, Vector3 halfExtents, Vector4 rotation = default, Vector3 direction = default, float maxDistance = 0.0f, uint layerMask = Physics.AllLayers, uint maxHits = 1, Entity? ignoreEntity = null)
+        {
+            return new PhysicsQuery { Shape = QueryShape.Box, Origin = origin, Size = halfExtents, Rotation = rotation, Direction = direction, MaxDistance = maxDistance, LayerMask = layerMask, MaxHits = maxHits, IgnoreEntityID = ignoreEntity?.ID ?? 0 };
+        }
+
+        public static PhysicsQuery Capsule(Vector3 origin, float radius, float halfHeight, Vector4 rotation = default, Vector3 direction = default, float maxDistance = 0.0f, uint layerMask = Physics.AllLayers, uint maxHits = 1, Entity? ignoreEntity = null)
+        {
+            return new PhysicsQuery { Shape = QueryShape.Capsule, Origin = origin, Size = new Vector3(radius, halfHeight, 0.0f), Rotation = rotation, Direction = direction, MaxDistance = maxDistance, LayerMask = layerMask, MaxHits = maxHits, IgnoreEntityID = ignoreEntity?.ID ?? 0 };
+        }
+    }
+
     public static class Physics
     {
-        public static bool Raycast(Vector3 origin, Vector3 direction, float maxDistance, out RaycastHit hitInfo, Entity? ignoreEntity = null)
+        public const uint AllLayers = 0xFFFFFFFF;
+
+        public static uint LayerBit(int layer) => 1u << (layer & 31);
+
+        public static bool Raycast(Vector3 origin, Vector3 direction, float maxDistance, out RaycastHit hitInfo, Entity? ignoreEntity = null, uint layerMask = AllLayers)
         {
             unsafe
             {
                 RaycastHit result = new RaycastHit();
                 ulong ignoreID = ignoreEntity != null ? ignoreEntity.ID : 0;
 
-                var func = (delegate* unmanaged<Vector3*, Vector3*, float, RaycastHit*, ulong, byte>)Interop.NativeFunctions.Physics_Raycast;
+                var func = (delegate* unmanaged<Vector3*, Vector3*, float, RaycastHit*, ulong, uint, byte>)Interop.NativeFunctions.Physics_Raycast;
 
-                byte hit = func(&origin, &direction, maxDistance, &result, ignoreID);
+                byte hit = func(&origin, &direction, maxDistance, &result, ignoreID, layerMask);
                 hitInfo = result;
                 return hit != 0;
             }
         }
+
+        // The batches run every query under one lock and one transition. Query i's hits start after the MaxHits slots of
+        // the queries before it and hitCounts[i] says how many it found, so hits needs the sum of MaxHits. parallel
+        // splits large batches across the job system when issued outside the parallel script updates. Returns the
+        // total number of hits
+        public static int RaycastBatch(ReadOnlySpan<PhysicsQuery> queries, Span<RaycastHit> hits, Span<int> hitCounts, bool parallel = false)
+        {
+            unsafe { return RunBatch((delegate* unmanaged<PhysicsQuery*, uint, RaycastHit*, uint, int*, byte, uint>)Interop.NativeFunctions.Physics_RaycastBatch, queries, hits, hitCounts, parallel); }
+        }
+
+        // Shapes other than Ray are swept along Direction, Ray queries behave like RaycastBatch
+        public static int SweepBatch(ReadOnlySpan<PhysicsQuery> queries, Span<RaycastHit> hits, Span<int> hitCounts, bool parallel = false)
+        {
+            unsafe { return RunBatch((delegate* unmanaged<PhysicsQuery*, uint, RaycastHit*, uint, int*, byte, uint>)Interop.NativeFunctions.Physics_SweepBatch, queries, hits, hitCounts, parallel); }
+        }
+
+        // Only EntityID is filled, overlaps have no point or distance
+        public static int OverlapBatch(ReadOnlySpan<PhysicsQuery> queries, Span<RaycastHit> hits, Span<int> hitCounts, bool parallel = false)
+        {
+            unsafe { return RunBatch((delegate* unmanaged<PhysicsQuery*, uint, RaycastHit*, uint, int*, byte, uint>)Interop.NativeFunctions.Physics_OverlapBatch, queries, hits, hitCounts, parallel); }
+        }
+
+        private static unsafe int RunBatch(delegate* unmanaged<PhysicsQuery*, uint, RaycastHit*, uint, int*, byte, uint> func,
+            ReadOnlySpan<PhysicsQuery> queries, Span<RaycastHit> hits, Span<int> hitCounts, bool parallel)
+        {
+            if (hitCounts.Length < queries.Length)
+                throw new ArgumentException("hitCounts needs an entry per query", nameof(hitCounts));
+
+            fixed (PhysicsQuery* queriesPtr = queries)
+            fixed (RaycastHit* hitsPtr = hits)
+            fixed (int* countsPtr = hitCounts)
+            {
+                return (int)func(queriesPtr, (uint)queries.Length, hitsPtr, (uint)hits.Length, countsPtr, parallel ? (byte)1 : (byte)0);
+            }
+        }
     }
-}
\ No newline at end of file
+}
@@ -22,6 +22,18 @@ namespace RXNScriptHost
         }
     }
 
+    // Mirrors ScriptContactEvent in ScriptEngine.cpp
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ContactEvent
+    {
+        public int Slot;
+        public uint Callback;
+        public ulong OtherID;
+        public System.Numerics.Vector3 Point;
+        public System.Numerics.Vector3 Normal;
+        public System.Numerics.Vector3 Impulse;
+    }
+
     public static class Host
     {
         private static GameScriptALC? s_ALC = null;
@@ -29,31 +41,74 @@ namespace RXNScriptHost
 
         private static Assembly? s_AppAssembly = null;
 
-        private static Dictionary<ulong, object> s_EntityInstances = new();
+        private struct ScriptInstance
+        {
+            public object Instance;
+            public ScriptType Type;
+            public ulong EntityID;
+        }
+
+        // Instances live in a dense slot array, slots are recycled on destroy. The engine keeps each entity's slot in
+        // its ScriptComponent and addresses instances by slot only, nothing here is looked up by entity
+        private static ScriptInstance[] s_Instances = new ScriptInstance[256];
+        private static int s_InstanceCount = 0;
+        private static Stack<int> s_FreeSlots = new();
+        private static Dictionary<Type, ScriptType> s_ScriptTypes = new();
+
+        // RXNEngine.CoroutineScheduler lives in the game script context, the host only reaches it through these
+        private static Action? s_UpdateCoroutines;
+        private static Action? s_FixedUpdateCoroutines;
+        private static Action<ulong>? s_StopCoroutines;
+        private static Action? s_ClearCoroutines;
+        private static Func<int>? s_ActiveCoroutines;
+        private static Func<int>? s_SleepingCoroutines;
+
+        private static void BindCoroutineScheduler()
+        {
+            Type? scheduler = s_CoreAssembly?.GetType("RXNEngine.CoroutineScheduler");
+            if (scheduler == null) return;
+
+            const BindingFlags flags = BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic;
+            s_UpdateCoroutines = scheduler.GetMethod("Update", flags)?.CreateDelegate<Action>();
+            s_FixedUpdateCoroutines = scheduler.GetMethod("FixedUpdate", flags)?.CreateDelegate<Action>();
+            s_StopCoroutines = scheduler.GetMethod("StopAll", flags)?.CreateDelegate<Action<ulong>>();
+            s_ClearCoroutines = scheduler.GetMethod("Clear", flags)?.CreateDelegate<Action>();
+            s_ActiveCoroutines = scheduler.GetProperty("ActiveCount", flags)?.GetMethod?.CreateDelegate<Func<int>>();
+            s_SleepingCoroutines = scheduler.GetProperty("SleepingCount", flags)?.GetMethod?.CreateDelegate<Func<int>>();
+        }
+
+        private static void ClearInstances()
+        {
+            Array.Clear(s_Instances);
+            s_InstanceCount = 0;
+            s_FreeSlots.Clear();
+            s_ClearCoroutines?.Invoke();
+        }
 
-        private static uint GetScriptFieldType(Type type)
+        private static ScriptType? GetScriptType(Type type)
         {
-            if (type == typeof(float)) return 1;
-            if (type == typeof(double)) return 2;
-            if (type == typeof(bool)) return 3;
-            if (type == typeof(char)) return 4;
-            if (type == typeof(sbyte)) return 5;
-            if (type == typeof(short)) return 6;
-            if (type == typeof(int)) return 7;
-            if (type == typeof(long)) return 8;
-            if (type == typeof(byte)) return 9;
-            if (type == typeof(ushort)) return 10;
-            if (type == typeof(uint)) return 11;
-            if (type == typeof(ulong)) return 12;
+            if (s_ScriptTypes.TryGetValue(type, out ScriptType? scriptType))
+                return scriptType;
+
+            Type? entityType = s_CoreAssembly?.GetType("RXNEngine.Entity");
+            if (entityType == null || !entityType.IsAssignableFrom(type))
+                return null;
 
-            if (type.Name == "Vector2") return 13;
-            if (type.Name == "Vector3") return 14;
-            if (type.Name == "Vector4") return 15;
+            scriptType = new ScriptType(type, entityType);
+            s_ScriptTypes[type] = scriptType;
+            return scriptType;
+        }
 
-            Type? entityBaseType = s_CoreAssembly?.GetType("RXNEngine.Entity");
-            if (entityBaseType != null && entityBaseType.IsAssignableFrom(type)) return 16;
+        private static int AllocateSlot()
+        {
+            if (!s_FreeSlots.TryPop(out int slot))
+            {
+                if (s_InstanceCount == s_Instances.Length)
+                    Array.Resize(ref s_Instances, s_Instances.Length * 2);
+                slot = s_InstanceCount++;
+            }
 
-            return 0;
+            return slot;
         }
 
         [UnmanagedCallersOnly]
@@ -95,6 +150,8 @@ namespace RXNScriptHost
                     }
                     else s_AppAssembly = s_ALC.LoadFromStream(appStream);
                 }
+
+                BindCoroutineScheduler();
             }
             catch (Exception e)
             {
@@ -107,87 +164,194 @@ namespace RXNScriptHost
         }
 
 
+        // Returns the ScriptCallbacks the class overrides, the engine skips the rest. The instance's slot is what the
+        // batched updates are given
         [UnmanagedCallersOnly]
-        public static void InstantiateScript(ulong entityID, IntPtr classNamePtr)
+        public static unsafe uint InstantiateScript(ulong entityID, IntPtr classNamePtr, int* outSlot)
         {
-            if (s_AppAssembly == null) return;
+            *outSlot = -1;
 
-            string? className = Marshal.PtrToStringUTF8(classNamePtr);
-            if (className == null) return;
+            if (s_AppAssembly == null) return 0;
 
-            Type? scriptType = s_AppAssembly.GetType(className);
-            if (scriptType != null)
-            {
-                object? instance = Activator.CreateInstance(scriptType);
-                if (instance != null)
-                {
-                    var idProperty = scriptType.BaseType?.GetProperty("ID", BindingFlags.Public | BindingFlags.Instance);
-                    idProperty?.SetValue(instance, entityID);
+            string? className = Marshal.PtrToStringUTF8(classNamePtr);
+            if (className == null) return 0;
 
-                    s_EntityInstances[entityID] = instance;
-                }
-            }
-            else
+            Type? type = s_AppAssembly.GetType(className);
+            ScriptType? scriptType = type != null ? GetScriptType(type) : null;
+            if (scriptType == null)
             {
                 Console.WriteLine($"[.NET Host] Could not find script class: {className}");
+                return 0;
             }
+
+            int slot = AllocateSlot();
+            s_Instances[slot] = new ScriptInstance { Instance = scriptType.Create(entityID, slot), Type = scriptType, EntityID = entityID };
+            *outSlot = slot;
+            return (uint)scriptType.Callbacks;
         }
 
         [UnmanagedCallersOnly]
-        public static void InvokeOnCreate(ulong entityID)
+        public static void InvokeOnCreate(int slot)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
-            {
-                MethodInfo? onCreate = instance.GetType().GetMethod("OnCreate");
-                onCreate?.Invoke(instance, null);
-            }
+            if (!TryGetSlot(slot, out ScriptInstance script) || script.Type.OnCreate == null)
+                return;
+
+            ProfileSample sample = ScriptProfiler.Begin();
+            script.Type.OnCreate(script.Instance);
+            ScriptProfiler.End(script.Type, ScriptCallbacks.OnCreate, sample);
         }
 
         [UnmanagedCallersOnly]
-        public static void InvokeOnDestroy(ulong entityID)
+        public static void InvokeOnAfterReload(int slot)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
-            {
-                var method = instance.GetType().GetMethod("OnDestroy", BindingFlags.Public | BindingFlags.Instance);
+            if (!TryGetSlot(slot, out ScriptInstance script) || script.Type.OnAfterReload == null)
+                return;
 
-                if (method != null && method.DeclaringType != s_CoreAssembly?.GetType("RXNEngine.Entity"))
+            ProfileSample sample = ScriptProfiler.Begin();
+            script.Type.OnAfterReload(script.Instance);
+            ScriptProfiler.End(script.Type, ScriptCallbacks.OnAfterReload, sample);
+        }
+
+        [UnmanagedCallersOnly]
+        public static void InvokeOnDestroy(int slot)
+        {
+            if (!TryGetSlot(slot, out ScriptInstance script))
+                return;
+
+            s_Instances[slot] = default;
+
+            // The slot is only recycled once OnDestroy is done, an entity it spawns must not be handed the same slot
+            try
+            {
+                if (script.Type.OnDestroy != null)
                 {
-                    method.Invoke(instance, null);
+                    ProfileSample sample = ScriptProfiler.Begin();
+                    script.Type.OnDestroy(script.Instance);
+                    ScriptProfiler.End(script.Type, ScriptCallbacks.OnDestroy, sample);
                 }
 
-                s_EntityInstances.Remove(entityID);
+                s_StopCoroutines?.Invoke(script.EntityID);
             }
+            finally
+            {
+                s_FreeSlots.Push(slot);
+            }
+        }
+
+        [UnmanagedCallersOnly]
+        public static void InvokeOnUpdate(int slot, float deltaTime)
+        {
+            if (!TryGetSlot(slot, out ScriptInstance script) || script.Type.OnUpdate == null)
+                return;
+
+            ProfileSample sample = ScriptProfiler.Begin();
+            script.Type.OnUpdate(script.Instance, Time.DeltaTime);
+            ScriptProfiler.End(script.Type, ScriptCallbacks.OnUpdate, sample);
+        }
+
+        [UnmanagedCallersOnly]
+        public static void InvokeOnFixedUpdate(int slot, float fixedTimeStep)
+        {
+            if (!TryGetSlot(slot, out ScriptInstance script) || script.Type.OnFixedUpdate == null)
+                return;
+
+            ProfileSample sample = ScriptProfiler.Begin();
+            script.Type.OnFixedUpdate(script.Instance, fixedTimeStep);
+            ScriptProfiler.End(script.Type, ScriptCallbacks.OnFixedUpdate, sample);
         }
 
+        // One transition for a whole run of instances, the engine only passes slots whose class handles the callback
         [UnmanagedCallersOnly]
-        public static void InvokeOnUpdate(ulong entityID, float deltaTime)
+        public static unsafe void InvokeOnUpdateBatch(int* slots, int count, float deltaTime)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
+            ScriptInstance[] instances = s_Instances;
+            for (int i = 0; i < count; i++)
             {
-                MethodInfo? internalUpdate = instance.GetType().GetMethod("InternalUpdate", BindingFlags.Instance | BindingFlags.NonPublic);
-                internalUpdate?.Invoke(instance, null);
+                ref ScriptInstance script = ref instances[slots[i]];
+
+                ProfileSample sample = ScriptProfiler.Begin();
+                script.Type.OnUpdate!(script.Instance, Time.DeltaTime);
+                ScriptProfiler.End(script.Type, ScriptCallbacks.OnUpdate, sample);
             }
         }
 
         [UnmanagedCallersOnly]
-        public static void InvokeOnFixedUpdate(ulong entityID, float fixedTimeStep)
+        public static unsafe void InvokeOnFixedUpdateBatch(int* slots, int count, float fixedTimeStep)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
+            ScriptInstance[] instances = s_Instances;
+            for (int i = 0; i < count; i++)
             {
-                var method = instance.GetType().GetMethod("OnFixedUpdate", BindingFlags.Public | BindingFlags.Instance);
+                ref ScriptInstance script = ref instances[slots[i]];
 
-                if (method != null && method.DeclaringType != s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                {
-                    method.Invoke(instance, new object[] { fixedTimeStep });
-                }
+                ProfileSample sample = ScriptProfiler.Begin();
+                script.Type.OnFixedUpdate!(script.Instance, fixedTimeStep);
+                ScriptProfiler.End(script.Type, ScriptCallbacks.OnFixedUpdate, sample);
             }
         }
 
+        // Steps every coroutine that's due, once per frame after the updates
+        [UnmanagedCallersOnly]
+        public static void UpdateCoroutines()
+        {
+            s_UpdateCoroutines?.Invoke();
+        }
+
+        // Resumes the coroutines waiting on physics, once per fixed update
+        [UnmanagedCallersOnly]
+        public static void FixedUpdateCoroutines()
+        {
+            s_FixedUpdateCoroutines?.Invoke();
+        }
+
+        [UnmanagedCallersOnly]
+        public static unsafe void GetCoroutineStats(int* outActive, int* outSleeping)
+        {
+            *outActive = s_ActiveCoroutines?.Invoke() ?? 0;
+            *outSleeping = s_SleepingCoroutines?.Invoke() ?? 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static void SetProfilingEnabled(int enabled)
+        {
+            ScriptProfiler.Enabled = enabled != 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static void ResetProfile()
+        {
+            ScriptProfiler.Reset(s_ScriptTypes.Values);
+        }
+
+        // Fills up to capacity records and returns how many there are, the engine grows its buffer and asks again
+        [UnmanagedCallersOnly]
+        public static unsafe int GetProfile(ScriptProfileRecord* records, int capacity)
+        {
+            return ScriptProfiler.Collect(s_ScriptTypes.Values, records, capacity);
+        }
+
+        // The scene's entities are gone without their OnDestroy, drop their instances and coroutines with them
+        [UnmanagedCallersOnly]
+        public static void OnRuntimeStop()
+        {
+            ClearInstances();
+        }
+
         [UnmanagedCallersOnly]
         public static void UnloadGameScripts()
         {
             if (s_ALC == null) return;
 
+            // Compiled dispatch tables and live instances reference the script types and would keep the context alive
+            ClearInstances();
+            s_ScriptTypes.Clear();
+
+            s_UpdateCoroutines = null;
+            s_FixedUpdateCoroutines = null;
+            s_StopCoroutines = null;
+            s_ClearCoroutines = null;
+            s_ActiveCoroutines = null;
+            s_SleepingCoroutines = null;
+
             s_ALC.Unload();
             s_ALC = null;
             s_CoreAssembly = null;
@@ -209,6 +373,7 @@ namespace RXNScriptHost
             return scriptType != null ? 1 : 0;
         }
 
+        // Registers the class's fields in handle order, the engine addresses them by handle from then on
         [UnmanagedCallersOnly]
         public static void ReflectClass(IntPtr classNamePtr)
         {
@@ -216,155 +381,96 @@ namespace RXNScriptHost
             if (className == null || s_AppAssembly == null) return;
 
             Type? type = s_AppAssembly.GetType(className);
-            if (type == null) return;
+            ScriptType? scriptType = type != null ? GetScriptType(type) : null;
+            if (scriptType == null) return;
 
             IntPtr classStr = Marshal.StringToHGlobalAnsi(className);
 
-            foreach (var field in type.GetFields(BindingFlags.Public | BindingFlags.Instance))
+            foreach (ScriptField field in scriptType.Fields)
             {
-                uint fieldType = GetScriptFieldType(field.FieldType);
+                IntPtr fieldStr = Marshal.StringToHGlobalAnsi(field.Info.Name);
 
-                if (fieldType != 0)
+                unsafe
                 {
-                    IntPtr fieldStr = Marshal.StringToHGlobalAnsi(field.Name);
-
-                    unsafe
-                    {
-                        var registerFunc = (delegate* unmanaged<IntPtr, IntPtr, uint, void>)Interop.NativeFunctions.ScriptField_Register;
-                        registerFunc(classStr, fieldStr, fieldType);
-                    }
-
-                    Marshal.FreeHGlobal(fieldStr);
+                    var registerFunc = (delegate* unmanaged<IntPtr, IntPtr, uint, uint, uint, void>)Interop.NativeFunctions.ScriptField_Register;
+                    registerFunc(classStr, fieldStr, (uint)field.FieldType, (uint)field.Offset, (uint)field.Size);
                 }
+
+                Marshal.FreeHGlobal(fieldStr);
             }
             Marshal.FreeHGlobal(classStr);
         }
 
-        [UnmanagedCallersOnly]
-        public static void GetFieldValue(ulong entityID, IntPtr fieldNamePtr, IntPtr outBuffer)
+        private static bool TryGetSlot(int slot, out ScriptInstance script)
         {
-            string? fieldName = Marshal.PtrToStringUTF8(fieldNamePtr);
-            if (fieldName != null && s_EntityInstances.TryGetValue(entityID, out object? instance))
+            if ((uint)slot < (uint)s_InstanceCount && s_Instances[slot].Instance != null)
             {
-                var field = instance.GetType().GetField(fieldName);
-                if (field != null)
-                {
-                    object? value = field.GetValue(instance);
-                    if (value == null) return;
-
-                    if (field.FieldType == s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                    {
-                        var idProp = value.GetType().GetProperty("ID", BindingFlags.Public | BindingFlags.Instance);
-                        ulong targetID = idProp != null ? (ulong)idProp.GetValue(value)! : 0;
-                        Marshal.WriteInt64(outBuffer, (long)targetID);
-                    }
-                    else
-                    {
-                        Marshal.StructureToPtr(value, outBuffer, false);
-                    }
-                }
+                script = s_Instances[slot];
+                return true;
             }
+
+            script = default;
+            return false;
         }
 
         [UnmanagedCallersOnly]
-        public static void SetFieldValue(ulong entityID, IntPtr fieldNamePtr, IntPtr inBuffer)
+        public static void GetFieldValue(int slot, uint fieldHandle, IntPtr outBuffer)
         {
-            string? fieldName = Marshal.PtrToStringUTF8(fieldNamePtr);
-            if (fieldName != null && s_EntityInstances.TryGetValue(entityID, out object? instance))
-            {
-                var field = instance.GetType().GetField(fieldName);
-                if (field != null)
-                {
-                    if (field.FieldType == s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                    {
-                        ulong targetID = (ulong)Marshal.ReadInt64(inBuffer);
-                        if (targetID == 0) field.SetValue(instance, null);
-                        else
-                        {
-                            object? newEntity = Activator.CreateInstance(field.FieldType, true);
-                            var idProp = field.FieldType.GetProperty("ID", BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance);
-                            idProp?.SetValue(newEntity, targetID);
-                            field.SetValue(instance, newEntity);
-                        }
-                    }
-                    else
-                    {
-                        object value = Marshal.PtrToStructure(inBuffer, field.FieldType)!;
-                        field.SetValue(instance, value);
-                    }
-                }
-            }
+            if (TryGetSlot(slot, out ScriptInstance script) && fieldHandle < script.Type.Fields.Count)
+                script.Type.Fields[(int)fieldHandle].Read(script.Instance, outBuffer);
         }
 
         [UnmanagedCallersOnly]
-        public static void OnCollisionEnter(ulong entityID, ulong otherEntityID)
+        public static void SetFieldValue(int slot, uint fieldHandle, IntPtr inBuffer)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
-            {
-                var method = instance.GetType().GetMethod("OnCollisionEnter", BindingFlags.Public | BindingFlags.Instance);
-
-                if (method != null && method.DeclaringType != s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                {
-                    Type? entityType = s_CoreAssembly?.GetType("RXNEngine.Entity");
-                    object? otherEntity = Activator.CreateInstance(entityType!, true);
-                    entityType!.GetProperty("ID")?.SetValue(otherEntity, otherEntityID);
-
-                    method.Invoke(instance, new object[] { otherEntity });
-                }
-            }
+            if (TryGetSlot(slot, out ScriptInstance script) && fieldHandle < script.Type.Fields.Count)
+                script.Type.Fields[(int)fieldHandle].Write(script.Instance, inBuffer);
         }
 
+        // Every field at its offset, buffers are FieldBufferSize bytes
         [UnmanagedCallersOnly]
-        public static void OnCollisionExit(ulong entityID, ulong otherEntityID)
+        public static void GetFieldValues(int slot, IntPtr outBuffer)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
-            {
-                var method = instance.GetType().GetMethod("OnCollisionExit", BindingFlags.Public | BindingFlags.Instance);
-
-                if (method != null && method.DeclaringType != s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                {
-                    Type? entityType = s_CoreAssembly?.GetType("RXNEngine.Entity");
-                    object? otherEntity = Activator.CreateInstance(entityType!, true);
-                    entityType!.GetProperty("ID")?.SetValue(otherEntity, otherEntityID);
+            if (!TryGetSlot(slot, out ScriptInstance script)) return;
 
-                    method.Invoke(instance, new object[] { otherEntity });
-                }
-            }
+            foreach (ScriptField field in script.Type.Fields)
+                field.Read(script.Instance, outBuffer + field.Offset);
         }
 
         [UnmanagedCallersOnly]
-        public static void OnTriggerEnter(ulong entityID, ulong otherEntityID)
+        public static void SetFieldValues(int slot, IntPtr inBuffer)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
-            {
-                var method = instance.GetType().GetMethod("OnTriggerEnter", BindingFlags.Public | BindingFlags.Instance);
+            if (!TryGetSlot(slot, out ScriptInstance script)) return;
 
-                if (method != null && method.DeclaringType != s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                {
-                    Type? entityType = s_CoreAssembly?.GetType("RXNEngine.Entity");
-                    object? otherEntity = Activator.CreateInstance(entityType!, true);
-                    entityType!.GetProperty("ID")?.SetValue(otherEntity, otherEntityID);
-
-                    method.Invoke(instance, new object[] { otherEntity });
-                }
-            }
+            foreach (ScriptField field in script.Type.Fields)
+                field.Write(script.Instance, inBuffer + field.Offset);
         }
 
+        // One call per physics step, the engine has already dropped events for classes without the handler
         [UnmanagedCallersOnly]
-        public static void OnTriggerExit(ulong entityID, ulong otherEntityID)
+        public static unsafe void DispatchContactEvents(ContactEvent* events, int count)
         {
-            if (s_EntityInstances.TryGetValue(entityID, out object? instance))
+            for (int i = 0; i < count; i++)
             {
-                var method = instance.GetType().GetMethod("OnTriggerExit", BindingFlags.Public | BindingFlags.Instance);
+                ContactEvent* e = &events[i];
 
-                if (method != null && method.DeclaringType != s_CoreAssembly?.GetType("RXNEngine.Entity"))
-                {
-                    Type? entityType = s_CoreAssembly?.GetType("RXNEngine.Entity");
-                    object? otherEntity = Activator.CreateInstance(entityType!, true);
-                    entityType!.GetProperty("ID")?.SetValue(otherEntity, otherEntityID);
+                // An earlier handler may have destroyed the entity
+                if (!TryGetSlot(e->Slot, out ScriptInstance script))
+                    continue;
 
-                    method.Invoke(instance, new object[] { otherEntity });
+                ScriptCallbacks callback = (ScriptCallbacks)e->Callback;
+                ProfileSample sample = ScriptProfiler.Begin();
+
+                switch (callback)
+                {
+                    case ScriptCallbacks.OnCollisionEnter: script.Type.OnCollisionEnter?.Invoke(script.Instance, (IntPtr)e); break;
+                    case ScriptCallbacks.OnCollisionExit: script.Type.OnCollisionExit?.Invoke(script.Instance, (IntPtr)e); break;
+                    case ScriptCallbacks.OnTriggerEnter: script.Type.OnTriggerEnter?.Invoke(script.Instance, e->OtherID); break;
+                    case ScriptCallbacks.OnTriggerExit: script.Type.OnTriggerExit?.Invoke(script.Instance, e->OtherID); break;
+                    default: continue;
                 }
+
+                ScriptProfiler.End(script.Type, callback, sample);
             }
         }
     }
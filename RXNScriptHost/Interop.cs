@@ -39,6 +39,9 @@ namespace RXNScriptHost
         //Physics Interop
         public IntPtr Rigidbody_ApplyLinearImpulse;
         public IntPtr Physics_Raycast;
+        public IntPtr Physics_RaycastBatch;
+        public IntPtr Physics_SweepBatch;
+        public IntPtr Physics_OverlapBatch;
 
         //Component Accessors
         public IntPtr Entity_HasComponent;
@@ -77,6 +80,9 @@ namespace RXNScriptHost
 
         public IntPtr Entity_CapsuleCollider_Get;
         public IntPtr Entity_CapsuleCollider_Set;
+
+        //Component Views
+        public IntPtr ScriptViews_GetBuffers;
     }
 
     public static class Interop
@@ -0,0 +1,129 @@
+﻿using System.Diagnostics;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Text.Unicode;
+
+namespace RXNScriptHost
+{
+    // Mirrors ScriptProfileRecord in ScriptEngine.cpp
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct ScriptProfileRecord
+    {
+        public const int MaxClassNameLength = 128;
+
+        public fixed byte ClassName[MaxClassNameLength];
+        public uint Callback;
+        private uint _padding;
+        public ulong Calls;
+        public double TotalMs;
+        public double MaxMs;
+        public ulong AllocatedBytes;
+    }
+
+    internal struct CallbackProfile
+    {
+        public long Calls;
+        public long Ticks;
+        public long MaxTicks;
+        public long AllocatedBytes;
+    }
+
+    internal readonly struct ProfileSample
+    {
+        public readonly long Timestamp;
+        public readonly long AllocatedBytes;
+
+        public ProfileSample(long timestamp, long allocatedBytes)
+        {
+            Timestamp = timestamp;
+            AllocatedBytes = allocatedBytes;
+        }
+    }
+
+    // Counts, times and the managed bytes allocated by every callback of every script class. Off by default, a
+    // disabled Begin() is a single branch. Callbacks run on several workers at once, so the counters are interlocked
+    internal static class ScriptProfiler
+    {
+        public const int CallbackCount = 9;
+
+        public static bool Enabled;
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static ProfileSample Begin()
+        {
+            return Enabled ? new ProfileSample(Stopwatch.GetTimestamp(), GC.GetAllocatedBytesForCurrentThread()) : default;
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static void End(ScriptType type, ScriptCallbacks callback, ProfileSample sample)
+        {
+            // Profiling may have been switched on mid callback
+            if (sample.Timestamp != 0)
+                Record(type, callback, sample);
+        }
+
+        private static void Record(ScriptType type, ScriptCallbacks callback, ProfileSample sample)
+        {
+            long ticks = Stopwatch.GetTimestamp() - sample.Timestamp;
+            long bytes = GC.GetAllocatedBytesForCurrentThread() - sample.AllocatedBytes;
+
+            ref CallbackProfile profile = ref type.Profile[BitOperations.Log2((uint)callback)];
+            Interlocked.Increment(ref profile.Calls);
+            Interlocked.Add(ref profile.Ticks, ticks);
+            Interlocked.Add(ref profile.AllocatedBytes, bytes);
+
+            long max = Volatile.Read(ref profile.MaxTicks);
+            while (ticks > max)
+            {
+                long previous = Interlocked.CompareExchange(ref profile.MaxTicks, ticks, max);
+                if (previous == max)
+                    break;
+                max = previous;
+            }
+        }
+
+        public static void Reset(IEnumerable<ScriptType> types)
+        {
+            foreach (ScriptType type in types)
+                Array.Clear(type.Profile);
+        }
+
+        // Writes up to capacity records for the callbacks that have run, returns how many there are in total
+        public static unsafe int Collect(IEnumerable<ScriptType> types, ScriptProfileRecord* records, int capacity)
+        {
+            double msPerTick = 1000.0 / Stopwatch.Frequency;
+
+            int count = 0;
+            foreach (ScriptType type in types)
+            {
+                for (int i = 0; i < CallbackCount; i++)
+                {
+                    CallbackProfile profile = type.Profile[i];
+                    if (profile.Calls == 0)
+                        continue;
+
+                    if (count < capacity)
+                    {
+                        ScriptProfileRecord* record = &records[count];
+                        *record = default;
+
+                        string name = type.Type.FullName ?? type.Type.Name;
+                        var nameBytes = new Span<byte>(record->ClassName, ScriptProfileRecord.MaxClassNameLength - 1);
+                        Utf8.FromUtf16(name, nameBytes, out _, out _);
+
+                        record->Callback = 1u << i;
+                        record->Calls = (ulong)profile.Calls;
+                        record->TotalMs = profile.Ticks * msPerTick;
+                        record->MaxMs = profile.MaxTicks * msPerTick;
+                        record->AllocatedBytes = (ulong)Math.Max(profile.AllocatedBytes, 0);
+                    }
+
+                    count++;
+                }
+            }
+
+            return count;
+        }
+    }
+}
@@ -0,0 +1,281 @@
+﻿using System;
+using System.Linq.Expressions;
+using System.Reflection;
+
+namespace RXNScriptHost
+{
+    // Mirrors ScriptCallbackFlags in ScriptEngine.h
+    [Flags]
+    public enum ScriptCallbacks : uint
+    {
+        None = 0,
+        OnCreate = 1 << 0,
+        OnDestroy = 1 << 1,
+        OnUpdate = 1 << 2,
+        OnFixedUpdate = 1 << 3,
+        OnCollisionEnter = 1 << 4,
+        OnCollisionExit = 1 << 5,
+        OnTriggerEnter = 1 << 6,
+        OnTriggerExit = 1 << 7,
+        OnAfterReload = 1 << 8
+    }
+
+    // Mirrors ScriptFieldType in ScriptEngine.h
+    public enum ScriptFieldType : uint
+    {
+        None = 0,
+        Float, Double,
+        Bool, Char, Byte, Short, Int, Long,
+        UByte, UShort, UInt, ULong,
+        Vector2, Vector3, Vector4,
+        Entity
+    }
+
+    // A public field the engine can inspect. Its handle is its index in ScriptType.Fields, Offset is where it sits in
+    // the packed buffer the bulk accessors read and write
+    internal sealed class ScriptField
+    {
+        public required FieldInfo Info { get; init; }
+        public required ScriptFieldType FieldType { get; init; }
+        public required int Offset { get; init; }
+        public required int Size { get; init; }
+
+        // Copy between the field and native memory holding its value, entity references travel as their ID
+        public required Action<object, IntPtr> Read { get; init; }
+        public required Action<object, IntPtr> Write { get; init; }
+    }
+
+    internal static class FieldAccess<T> where T : unmanaged
+    {
+        public static unsafe int Size => sizeof(T);
+
+        public static unsafe Action<object, IntPtr> Reader(Func<object, T> get) => (instance, buffer) => *(T*)buffer = get(instance);
+        public static unsafe Action<object, IntPtr> Writer(Action<object, T> set) => (instance, buffer) => set(instance, *(T*)buffer);
+    }
+
+    // Dispatch table built once per script class. Every lifecycle method the class overrides gets a compiled open
+    // delegate, the ones it leaves to Entity stay null and their flag is cleared so the engine never calls them
+    internal sealed class ScriptType
+    {
+        public Type Type { get; }
+        public ScriptCallbacks Callbacks { get; }
+
+        // Takes the entity ID and the instance's slot, which is also its index into the component views
+        public Func<ulong, int, object> Create { get; }
+
+        public Action<object>? OnCreate { get; }
+        public Action<object>? OnDestroy { get; }
+        public Action<object, float>? OnUpdate { get; }
+        public Action<object, float>? OnFixedUpdate { get; }
+
+        // Take a pointer to the ContactEvent, the Collision the script sees is built from it
+        public Action<object, IntPtr>? OnCollisionEnter { get; }
+        public Action<object, IntPtr>? OnCollisionExit { get; }
+        public Action<object, ulong>? OnTriggerEnter { get; }
+        public Action<object, ulong>? OnTriggerExit { get; }
+        public Action<object>? OnAfterReload { get; }
+
+        // Indexed by the callback's bit, filled while ScriptProfiler is enabled
+        public CallbackProfile[] Profile { get; } = new CallbackProfile[ScriptProfiler.CallbackCount];
+
+        public IReadOnlyList<ScriptField> Fields { get; }
+        // Size of the buffer GetFieldValues/SetFieldValues work on
+        public int FieldBufferSize { get; }
+
+        public ScriptType(Type type, Type entityType)
+        {
+            Type = type;
+
+            var id = Expression.Parameter(typeof(ulong), "id");
+            var slot = Expression.Parameter(typeof(int), "slot");
+            var instance = Expression.Variable(type, "instance");
+            Create = Expression.Lambda<Func<ulong, int, object>>(
+                Expression.Block(new[] { instance },
+                    Expression.Assign(instance, Expression.New(type)),
+                    Expression.Assign(Expression.Property(instance, entityType.GetProperty("ID")!), id),
+                    Expression.Assign(Expression.Property(instance, entityType.GetProperty("ViewIndex")!), slot),
+                    Expression.Convert(instance, typeof(object))),
+                id, slot).Compile();
+
+            OnCreate = Bind<Action<object>>(type, entityType, "OnCreate");
+            OnDestroy = Bind<Action<object>>(type, entityType, "OnDestroy");
+            OnUpdate = Bind<Action<object, float>>(type, entityType, "OnUpdate", typeof(float));
+            OnFixedUpdate = Bind<Action<object, float>>(type, entityType, "OnFixedUpdate", typeof(float));
+            OnAfterReload = Bind<Action<object>>(type, entityType, "OnAfterReload");
+
+            ConstructorInfo entityConstructor = entityType.GetConstructor(BindingFlags.Instance | BindingFlags.NonPublic, new[] { typeof(ulong) })!;
+            Type collisionType = entityType.Assembly.GetType("RXNEngine.Collision")!;
+            OnCollisionEnter = BindCollision(type, entityType, collisionType, "OnCollisionEnter");
+            OnCollisionExit = BindCollision(type, entityType, collisionType, "OnCollisionExit");
+            OnTriggerEnter = BindContact(type, entityType, entityConstructor, "OnTriggerEnter");
+            OnTriggerExit = BindContact(type, entityType, entityConstructor, "OnTriggerExit");
+
+            if (OnCreate != null) Callbacks |= ScriptCallbacks.OnCreate;
+            if (OnDestroy != null) Callbacks |= ScriptCallbacks.OnDestroy;
+            if (OnUpdate != null) Callbacks |= ScriptCallbacks.OnUpdate;
+            if (OnFixedUpdate != null) Callbacks |= ScriptCallbacks.OnFixedUpdate;
+            if (OnCollisionEnter != null) Callbacks |= ScriptCallbacks.OnCollisionEnter;
+            if (OnCollisionExit != null) Callbacks |= ScriptCallbacks.OnCollisionExit;
+            if (OnTriggerEnter != null) Callbacks |= ScriptCallbacks.OnTriggerEnter;
+            if (OnTriggerExit != null) Callbacks |= ScriptCallbacks.OnTriggerExit;
+            if (OnAfterReload != null) Callbacks |= ScriptCallbacks.OnAfterReload;
+
+            var fields = new List<ScriptField>();
+            int offset = 0;
+            foreach (FieldInfo field in type.GetFields(BindingFlags.Public | BindingFlags.Instance))
+            {
+                ScriptFieldType fieldType = GetFieldType(field.FieldType, entityType);
+                if (fieldType == ScriptFieldType.None || field.IsInitOnly)
+                    continue;
+
+                ScriptField scriptField = fieldType == ScriptFieldType.Entity
+                    ? BindEntityField(type, field, offset)
+                    : BindValueField(type, field, fieldType, offset);
+
+                fields.Add(scriptField);
+                offset = scriptField.Offset + scriptField.Size;
+            }
+
+            Fields = fields;
+            FieldBufferSize = Align(offset, 8);
+        }
+
+        private static ScriptFieldType GetFieldType(Type type, Type entityType)
+        {
+            if (type == typeof(float)) return ScriptFieldType.Float;
+            if (type == typeof(double)) return ScriptFieldType.Double;
+            if (type == typeof(bool)) return ScriptFieldType.Bool;
+            if (type == typeof(char)) return ScriptFieldType.Char;
+            if (type == typeof(sbyte)) return ScriptFieldType.Byte;
+            if (type == typeof(short)) return ScriptFieldType.Short;
+            if (type == typeof(int)) return ScriptFieldType.Int;
+            if (type == typeof(long)) return ScriptFieldType.Long;
+            if (type == typeof(byte)) return ScriptFieldType.UByte;
+            if (type == typeof(ushort)) return ScriptFieldType.UShort;
+            if (type == typeof(uint)) return ScriptFieldType.UInt;
+            if (type == typeof(ulong)) return ScriptFieldType.ULong;
+
+            if (type.Name == "Vector2") return ScriptFieldType.Vector2;
+            if (type.Name == "Vector3") return ScriptFieldType.Vector3;
+            if (type.Name == "Vector4") return ScriptFieldType.Vector4;
+
+            if (entityType.IsAssignableFrom(type)) return ScriptFieldType.Entity;
+
+            return ScriptFieldType.None;
+        }
+
+        private static int Align(int offset, int alignment) => (offset + alignment - 1) / alignment * alignment;
+
+        private static ScriptField BindValueField(Type type, FieldInfo field, ScriptFieldType fieldType, int offset)
+        {
+            var self = Expression.Parameter(typeof(object), "self");
+            var value = Expression.Parameter(field.FieldType, "value");
+            var member = Expression.Field(Expression.Convert(self, type), field);
+
+            Type getterType = typeof(Func<,>).MakeGenericType(typeof(object), field.FieldType);
+            Type setterType = typeof(Action<,>).MakeGenericType(typeof(object), field.FieldType);
+            Delegate getter = Expression.Lambda(getterType, member, self).Compile();
+            Delegate setter = Expression.Lambda(setterType, Expression.Assign(member, value), self, value).Compile();
+
+            Type access = typeof(FieldAccess<>).MakeGenericType(field.FieldType);
+            int size = (int)access.GetProperty("Size")!.GetValue(null)!;
+
+            return new ScriptField
+            {
+                Info = field,
+                FieldType = fieldType,
+                Offset = Align(offset, Math.Min(size, 8)),
+                Size = size,
+                Read = (Action<object, IntPtr>)access.GetMethod("Reader")!.Invoke(null, new object[] { getter })!,
+                Write = (Action<object, IntPtr>)access.GetMethod("Writer")!.Invoke(null, new object[] { setter })!
+            };
+        }
+
+        private static ScriptField BindEntityField(Type type, FieldInfo field, int offset)
+        {
+            var self = Expression.Parameter(typeof(object), "self");
+            var id = Expression.Parameter(typeof(ulong), "id");
+            var member = Expression.Field(Expression.Convert(self, type), field);
+            PropertyInfo idProperty = field.FieldType.GetProperty("ID")!;
+
+            var target = Expression.Variable(field.FieldType, "target");
+            var getter = Expression.Lambda<Func<object, ulong>>(
+                Expression.Block(new[] { target },
+                    Expression.Assign(target, member),
+                    Expression.Condition(Expression.Equal(target, Expression.Constant(null, field.FieldType)),
+                        Expression.Constant(0UL), Expression.Property(target, idProperty))),
+                self).Compile();
+
+            ConstructorInfo constructor = field.FieldType.GetConstructor(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic, Type.EmptyTypes)!;
+            var created = Expression.Variable(field.FieldType, "created");
+            var setter = Expression.Lambda<Action<object, ulong>>(
+                Expression.Assign(member, Expression.Condition(Expression.Equal(id, Expression.Constant(0UL)),
+                    Expression.Constant(null, field.FieldType),
+                    Expression.Block(new[] { created },
+                        Expression.Assign(created, Expression.New(constructor)),
+                        Expression.Assign(Expression.Property(created, idProperty), id),
+                        created))),
+                self, id).Compile();
+
+            return new ScriptField
+            {
+                Info = field,
+                FieldType = ScriptFieldType.Entity,
+                Offset = Align(offset, 8),
+                Size = sizeof(ulong),
+                Read = FieldAccess<ulong>.Reader(getter),
+                Write = FieldAccess<ulong>.Writer(setter)
+            };
+        }
+
+        private static bool Overrides(Type type, Type entityType, string name, params Type[] parameters)
+        {
+            MethodInfo? method = type.GetMethod(name, BindingFlags.Public | BindingFlags.Instance, parameters);
+            return method != null && method.DeclaringType != entityType;
+        }
+
+        private static TDelegate? Bind<TDelegate>(Type type, Type entityType, string name, params Type[] parameters) where TDelegate : Delegate
+        {
+            if (!Overrides(type, entityType, name, parameters))
+                return null;
+
+            var self = Expression.Parameter(typeof(object), "self");
+            var arguments = Array.ConvertAll(parameters, Expression.Parameter);
+
+            MethodInfo method = type.GetMethod(name, BindingFlags.Public | BindingFlags.Instance, parameters)!;
+            var call = Expression.Call(Expression.Convert(self, type), method, arguments);
+
+            return Expression.Lambda<TDelegate>(call, new[] { self }.Concat(arguments)).Compile();
+        }
+
+        // Scripts may override either overload, the Collision one forwards to the Entity one by default
+        private static Action<object, IntPtr>? BindCollision(Type type, Type entityType, Type collisionType, string name)
+        {
+            if (!Overrides(type, entityType, name, collisionType) && !Overrides(type, entityType, name, entityType))
+                return null;
+
+            var self = Expression.Parameter(typeof(object), "self");
+            var contactEvent = Expression.Parameter(typeof(IntPtr), "contactEvent");
+
+            MethodInfo fromEvent = collisionType.GetMethod("FromEvent", BindingFlags.Static | BindingFlags.NonPublic)!;
+            MethodInfo method = type.GetMethod(name, BindingFlags.Public | BindingFlags.Instance, new[] { collisionType })!;
+            var call = Expression.Call(Expression.Convert(self, type), method, Expression.Call(fromEvent, contactEvent));
+
+            return Expression.Lambda<Action<object, IntPtr>>(call, self, contactEvent).Compile();
+        }
+
+        private static Action<object, ulong>? BindContact(Type type, Type entityType, ConstructorInfo entityConstructor, string name)
+        {
+            if (!Overrides(type, entityType, name, entityType))
+                return null;
+
+            var self = Expression.Parameter(typeof(object), "self");
+            var otherID = Expression.Parameter(typeof(ulong), "otherID");
+
+            MethodInfo method = type.GetMethod(name, BindingFlags.Public | BindingFlags.Instance, new[] { entityType })!;
+            var call = Expression.Call(Expression.Convert(self, type), method, Expression.New(entityConstructor, otherID));
+
+            return Expression.Lambda<Action<object, ulong>>(call, self, otherID).Compile();
+        }
+    }
+}
\ No newline at end of file